@@ -0,0 +1,71 @@
+/*
+ * AllocationCounter.hpp
+ *
+ * Substituições do operador new global que contam as alocações e os bytes pedidos por todo o programa, usadas pelo benchmark e pelo teste da arena. As variantes nothrow e de arranjo da biblioteca padrão chamam estas. As variantes com alinhamento também são substituídas, pois std::pmr::new_delete_resource (o recurso padrão dos containers std::pmr) as usa.
+ *
+ * As substituições não podem ser inline, por isso este arquivo deve ser incluído por uma única unidade de tradução de cada executável.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+/*----------------------------------------------------------------------------*/
+
+inline std::atomic<std::uint64_t> g_allocationCount{0}; // Quantidade de alocações feitas pelo operador new global desde o início do programa.
+inline std::atomic<std::uint64_t> g_allocatedBytes{0}; // Quantidade de bytes pedidos ao operador new global desde o início do programa.
+
+void* operator new(std::size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+// O par é correto (o operator new acima usa malloc), mas o GCC, ao expandir std::allocator, vê o free aplicado a um ponteiro de operator new e emite -Wmismatched-new-delete.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* block = std::malloc(size + align + sizeof(void*))) // Reserva espaço para o alinhamento e para o endereço original, guardado logo antes do bloco entregue.
+    {
+        std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(block) + sizeof(void*) + align - 1) & ~(align - 1);
+        reinterpret_cast<void**>(aligned)[-1] = block;
+        return reinterpret_cast<void*>(aligned);
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+    if (pointer)
+    {
+        std::free(static_cast<void**>(pointer)[-1]);
+    }
+}
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept { operator delete(pointer, alignment); }
+
+#endif
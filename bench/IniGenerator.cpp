@@ -0,0 +1,132 @@
+/*
+ * IniGenerator.cpp
+ *
+ * Implementação do gerador determinístico de arquivos INI sintéticos usado pelo benchmark.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "IniGenerator.hpp"
+#include <fstream>
+/*----------------------------------------------------------------------------*/
+
+static constexpr char ALPHABET[] = "abcdefghijklmnopqrstuvwxyz0123456789_"; // Caracteres usados em chaves e valores.
+static constexpr std::size_t ALPHABET_SIZE = sizeof(ALPHABET) - 1; // Quantidade de caracteres do alfabeto, sem o terminador nulo.
+static constexpr std::size_t FLUSH_THRESHOLD = 1 << 20; // Tamanho do buffer de escrita; arquivos de 1 GB são gerados sem serem mantidos inteiros em memória.
+
+/**
+******************************************************************************
+* @brief   : Retorna o próximo número pseudoaleatório do SplitMix64.
+******************************************************************************.
+* @return: std::uint64_t - O próximo número de 64 bits da sequência.
+******************************************************************************
+*/
+std::uint64_t SplitMix64::next()
+{
+    std::uint64_t value = (m_state += 0x9E3779B97F4A7C15ull); // Avança o estado por uma constante ímpar.
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull; // Mistura os bits do estado.
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/**
+******************************************************************************
+* @brief   : Acrescenta um texto pseudoaleatório ao buffer.
+******************************************************************************.
+* @param: buffer - O buffer de saída.
+* @param: random - O gerador pseudoaleatório.
+* @param: length - O comprimento do texto.
+******************************************************************************
+*/
+static void appendRandomText(std::string& buffer, SplitMix64& random, std::size_t length)
+{
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        buffer.push_back(ALPHABET[random.below(ALPHABET_SIZE)]);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Grava um arquivo INI sintético.
+* @details : O arquivo começa com as seções [TCP] e [UART] válidas, para que as configurações possam ser medidas, seguidas de seções de preenchimento [S0], [S1], ... com keysPerSection chaves cada. Uma fração errorRate das linhas de preenchimento é malformada, alternando entre linhas sem '=', linhas sem chave e comentários, que o tokenizador deve descartar. O conteúdo é acumulado em um buffer de 1 MB e gravado em blocos, até atingir targetBytes (a última seção pode ficar incompleta).
+******************************************************************************.
+* @param: filePath - O caminho do arquivo a ser gravado.
+* @param: targetBytes - O tamanho mínimo do arquivo, em bytes.
+* @param: profile - A forma do arquivo.
+* @param: seed - A semente do gerador pseudoaleatório.
+* @return: std::expected<GeneratedIni, ErrorCode> - As características do arquivo gerado, ou FILE_OPEN_FAILED se ele não puder ser gravado.
+******************************************************************************
+*/
+std::expected<GeneratedIni, ErrorCode> generateIni(const std::string& filePath, std::uint64_t targetBytes, const IniProfile& profile, std::uint64_t seed)
+{
+    std::ofstream output(filePath, std::ios::binary | std::ios::trunc); // Arquivo de saída.
+    if (!output.is_open())
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+
+    SplitMix64 random(seed); // Gerador pseudoaleatório, determinístico para a mesma semente.
+    GeneratedIni generated; // Características do arquivo gerado.
+    std::string buffer = "[TCP]\nip=192.168.0.10\nport=8080\nprotocol=TCP\n\n[UART]\nbaudrate=115200\ndata_bits=8\nparity=None\nstop_bits=1\n"; // Seções válidas, medidas pelo benchmark.
+    buffer.reserve(FLUSH_THRESHOLD + 4096);
+    generated.sections = 2;
+    generated.keys = 7;
+
+    std::uint64_t errorThreshold = static_cast<std::uint64_t>(profile.errorRate * 1000000.0); // Limite, em partes por milhão, abaixo do qual uma linha é malformada.
+    std::uint64_t written = 0; // Bytes já gravados no arquivo.
+    while (written + buffer.size() < targetBytes)
+    {
+        buffer += "\n[S";
+        buffer += std::to_string(generated.sections - 2);
+        buffer += "]\n";
+        ++generated.sections;
+
+        for (std::size_t i = 0; i < profile.keysPerSection && written + buffer.size() < targetBytes; ++i) // Gera as linhas da seção, parando assim que o tamanho desejado for atingido.
+        {
+            if (random.below(1000000) < errorThreshold) // Linha malformada.
+            {
+                switch (random.below(3))
+                {
+                case 0: // Linha sem delimitador.
+                    appendRandomText(buffer, random, profile.keyLength + 8);
+                    break;
+                case 1: // Linha sem chave.
+                    buffer += " =";
+                    appendRandomText(buffer, random, 8);
+                    break;
+                default: // Comentário.
+                    buffer += "; ";
+                    appendRandomText(buffer, random, profile.keyLength);
+                    break;
+                }
+                buffer.push_back('\n');
+                ++generated.malformedLines;
+                continue;
+            }
+            appendRandomText(buffer, random, profile.keyLength); // Chave.
+            buffer += " = ";
+            appendRandomText(buffer, random, 4 + random.below(13)); // Valor com 4 a 16 caracteres.
+            buffer.push_back('\n');
+            ++generated.keys;
+        }
+
+        if (buffer.size() >= FLUSH_THRESHOLD) // Grava o buffer em blocos.
+        {
+            output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            written += buffer.size();
+            buffer.clear();
+        }
+    }
+    output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    written += buffer.size();
+
+    if (!output.flush()) // Falhas de escrita (por exemplo, disco cheio) invalidam o arquivo.
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    generated.bytes = written;
+    return generated;
+}
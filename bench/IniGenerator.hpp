@@ -0,0 +1,52 @@
+/*
+ * IniGenerator.hpp
+ *
+ * Definição do gerador determinístico de arquivos INI sintéticos usado pelo benchmark. Para a mesma semente e o mesmo perfil, o arquivo gerado é idêntico em qualquer plataforma, o que permite comparar resultados entre versões.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef INI_GENERATOR_HPP
+#define INI_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include "error-handler.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Estrutura que descreve a forma de um arquivo sintético.
+struct IniProfile
+{
+    std::string name; // Nome do perfil, usado nos resultados.
+    std::size_t keysPerSection; // Quantidade de chaves em cada seção de preenchimento.
+    std::size_t keyLength; // Comprimento de cada chave, em caracteres.
+    double errorRate; // Fração das linhas de preenchimento que o tokenizador deve descartar (linhas sem '=', linhas sem chave e comentários), entre 0 e 1.
+};
+
+// Estrutura com as características do arquivo efetivamente gerado.
+struct GeneratedIni
+{
+    std::uint64_t bytes = 0; // Tamanho do arquivo, em bytes.
+    std::uint64_t sections = 0; // Quantidade de seções, incluindo [TCP] e [UART].
+    std::uint64_t keys = 0; // Quantidade de linhas chave=valor válidas.
+    std::uint64_t malformedLines = 0; // Quantidade de linhas descartadas pelo tokenizador (malformadas ou comentários).
+};
+
+// Gerador pseudoaleatório SplitMix64. Ao contrário das distribuições da biblioteca padrão, a sua saída é definida bit a bit, o que garante arquivos idênticos em qualquer plataforma.
+class SplitMix64
+{
+private:
+    std::uint64_t m_state; // Estado interno.
+public:
+    explicit SplitMix64(std::uint64_t seed) : m_state(seed) {} // Construtor que recebe a semente.
+    std::uint64_t next(); // Retorna o próximo número pseudoaleatório de 64 bits.
+    std::uint64_t below(std::uint64_t bound) { return next() % bound; } // Retorna um número no intervalo [0, bound).
+};
+
+std::expected<GeneratedIni, ErrorCode> generateIni(const std::string& filePath, std::uint64_t targetBytes, const IniProfile& profile, std::uint64_t seed); // Grava um arquivo INI sintético com pelo menos targetBytes bytes (arredondado para a linha seguinte), começando pelas seções [TCP] e [UART] válidas. Retorna FILE_OPEN_FAILED se o arquivo não puder ser gravado.
+
+#endif
@@ -0,0 +1,1113 @@
+/*
+ * config_manager_bench.cpp
+ *
+ * Benchmark da carga e da consulta das configurações. Gera arquivos INI sintéticos e determinísticos de 1 KB até 1 GB, com perfis de seções, comprimentos de chave e taxas de erro variados, e mede o custo da construção do IniParser (ns/byte e alocações por carga) e do JsonParser sobre um documento com os mesmos dados, a carga sob demanda do LazyIniParser com a leitura de [TCP] e [UART], de parseTcp/parseUart, de createParser, a latência dos getters do ConfigurationManager (percentis), a comparação de snapshots com muitas instâncias (diffSnapshots), a validação paralela das instâncias com 1, 4 e 16 threads (seções/s), a carga de um arquivo base com 1000 fragmentos conf.d pelo LayeredParser e as alterações em tempo de execução gravadas no journal (latência de set, reaplicação de 10000 registros e compactação). Os resultados são gravados em JSON, para comparação entre versões.
+ *
+ * Uso: config_manager_bench [--max-size <bytes>[K|M|G]] [--iterations <n>] [--seed <n>] [--output <arquivo.json>]
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "ConfigJournal.hpp"
+#include "ConfigMetrics.hpp"
+#include "ConfigurationManager.hpp"
+#include "AllocationCounter.hpp"
+#include "IniGenerator.hpp"
+#include "IniParser.hpp"
+#include "IniTokenizer.hpp"
+#include "JsonParser.hpp"
+#include "LayeredParser.hpp"
+#include "LazyIniParser.hpp"
+#include "MappedFile.hpp"
+#include "ParserFactory.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Estrutura com as opções da linha de comando.
+struct BenchOptions
+{
+    std::uint64_t maxBytes = 16ull << 20; // Maior tamanho de arquivo medido. Os tamanhos de 256 MB e 1 GB só são medidos quando pedidos explicitamente.
+    unsigned iterations = 5; // Quantidade de repetições de cada medida (reduzida automaticamente para arquivos grandes).
+    std::uint64_t seed = 42; // Semente do gerador de arquivos.
+    std::string output = "config_manager_bench.json"; // Caminho do arquivo de resultados.
+};
+
+// Estrutura com os percentis de uma distribuição de latências, em nanossegundos.
+struct Percentiles
+{
+    double p50 = 0; // Mediana.
+    double p90 = 0; // Percentil 90.
+    double p99 = 0; // Percentil 99.
+    double max = 0; // Maior amostra.
+};
+
+// Estrutura com os resultados de um cenário (um perfil e um tamanho de arquivo).
+struct BenchResult
+{
+    std::string profile; // Nome do perfil.
+    std::uint64_t targetBytes = 0; // Tamanho pedido ao gerador.
+    GeneratedIni file; // Características do arquivo gerado.
+    unsigned iterations = 0; // Quantidade de repetições efetivamente feitas.
+    double loadNs = 0; // Mediana do tempo de construção do IniParser.
+    double loadNsPerByte = 0; // Mediana do tempo de construção do IniParser, por byte do arquivo.
+    std::uint64_t allocationsPerLoad = 0; // Alocações feitas por uma construção do IniParser.
+    std::uint64_t allocatedBytesPerLoad = 0; // Bytes alocados por uma construção do IniParser.
+    double parseTcpNs = 0; // Tempo médio de uma chamada a parseTcp.
+    double parseUartNs = 0; // Tempo médio de uma chamada a parseUart.
+    double createParserNs = 0; // Mediana do tempo de createParser (abertura, detecção do formato, snapshot ausente e construção do IniParser).
+    double lazyLoadNs = 0; // Mediana do tempo de construção do LazyIniParser (somente a localização das seções).
+    double lazyTwoSectionsNs = 0; // Mediana do tempo de construção do LazyIniParser somado ao primeiro parseTcp e ao primeiro parseUart (inicialização de um processo que lê duas seções).
+    std::uint64_t lazyAllocatedBytes = 0; // Bytes alocados pela construção do LazyIniParser e pela indexação de [TCP] e [UART].
+    std::uint64_t jsonBytes = 0; // Tamanho do documento JSON equivalente (as mesmas seções, chaves e valores, sem as linhas descartadas).
+    double jsonLoadNs = 0; // Mediana do tempo de construção do JsonParser sobre o documento equivalente.
+    double jsonLoadNsPerByte = 0; // Mediana do tempo de construção do JsonParser, por byte do documento.
+    Percentiles getTcpConfig; // Latência de get_tcp_config.
+    Percentiles getUartConfig; // Latência de get_uart_config.
+    Percentiles getByName; // Latência de get<int>("TCP", "port"), que consulta o parser a cada chamada.
+    Percentiles getByHandle; // Latência de get<int> com o identificador de ("TCP", "port") obtido por intern.
+    Percentiles getTcpConfigMetrics; // Latência de get_tcp_config com a instrumentação ligada (contagem de chamadas).
+    double tokenizeReferenceGbps = 0; // Vazão da separação de linhas anterior aos núcleos de varredura (std::string_view::find por linha), em GB/s.
+    double tokenizeGbps[3] = {}; // Vazão do IniTokenizer em cada IniScanLevel (escalar, SSE2 e AVX2), em GB/s. Níveis não suportados usam o melhor nível disponível.
+};
+
+// Estrutura com os resultados da comparação de snapshots (diffSnapshots) sobre um arquivo com muitas instâncias numeradas.
+struct DiffResult
+{
+    std::uint64_t sections = 0; // Seções de configuração comparadas ([TCP], [UART] e as instâncias).
+    double unchangedNs = 0; // Mediana do tempo de comparação de dois snapshots com o mesmo conteúdo.
+    double oneChangeNs = 0; // Mediana do tempo de comparação quando uma única instância muda.
+    std::size_t changes = 0; // Mudanças encontradas na segunda medida. Deve ser 1.
+    double reloadNs = 0; // Mediana do tempo de um reload com uma assinatura ativa (inclui a carga do arquivo e a comparação).
+    unsigned notifications = 0; // Notificações recebidas pela assinatura da instância alterada.
+};
+
+// Estrutura com os resultados da validação paralela das seções numeradas com uma quantidade de threads.
+struct ParallelRun
+{
+    unsigned threads = 0; // Threads do ThreadPool (incluindo a chamadora).
+    double reloadNs = 0; // Mediana do tempo de um reload (carga do arquivo e validação de todas as instâncias).
+    double sectionsPerSecond = 0; // Seções validadas por segundo, a partir da mediana.
+};
+
+// Estrutura com os resultados da validação paralela (ThreadPool::parallelFor) sobre um arquivo com muitas instâncias numeradas.
+struct ParallelResult
+{
+    std::uint64_t sections = 0; // Seções de configuração validadas em cada reload (as instâncias TCP e UART).
+    unsigned hardwareThreads = 0; // Threads de hardware da máquina (std::thread::hardware_concurrency), para interpretar a escala.
+    std::vector<ParallelRun> runs; // Resultados com 1, 4 e 16 threads.
+};
+
+// Estrutura com os resultados da carga das camadas com uma quantidade de threads.
+struct LayeredRun
+{
+    unsigned threads = 0; // Threads usadas pelo LayeredParser na leitura e tokenização das camadas.
+    double loadNs = 0; // Mediana do tempo de construção do LayeredParser.
+    double layersPerSecond = 0; // Camadas carregadas por segundo, a partir da mediana.
+};
+
+// Estrutura com os resultados da carga de um arquivo base com muitos fragmentos em um diretório conf.d (LayeredParser).
+struct LayeredResult
+{
+    std::uint64_t fragments = 0; // Fragmentos *.ini do diretório.
+    std::uint64_t bytes = 0; // Tamanho total das camadas (o arquivo base e os fragmentos).
+    double singleFileNs = 0; // Mediana do tempo de construção do IniParser sobre um único arquivo com o mesmo conteúdo, que isola o custo de abrir e combinar as camadas.
+    std::vector<LayeredRun> runs; // Resultados com 1 e 4 threads.
+    bool consistent = false; // Indica se a configuração combinada tem os valores do último fragmento.
+};
+
+// Estrutura com os resultados das alterações em tempo de execução (ConfigurationManager::set) gravadas no journal.
+struct JournalResult
+{
+    std::uint64_t fileBytes = 0; // Tamanho do arquivo de configuração base.
+    std::uint64_t edits = 0; // Alterações gravadas no journal.
+    std::uint64_t journalBytes = 0; // Tamanho do journal com todas as alterações.
+    Percentiles setJournaled; // Latência de set com o journal aberto (validação, gravação do registro com fdatasync e publicação).
+    Percentiles setInMemory; // Latência de set sem journal (validação e publicação), que isola o custo da gravação.
+    Percentiles setAndRewrite; // Latência de set seguido da reescrita do arquivo inteiro (compactJournal), o custo de gravar cada alteração no arquivo base.
+    double replayNs = 0; // Mediana do tempo de openJournal com todas as alterações (leitura, verificação e reaplicação dos registros e montagem do snapshot).
+    double compactNs = 0; // Tempo da compactação de todas as alterações no arquivo base.
+    bool consistent = false; // Indica se o snapshot reaplicado e o arquivo compactado têm os valores da última alteração.
+};
+
+using BenchClock = std::chrono::steady_clock; // Relógio monotônico usado em todas as medidas.
+
+/**
+******************************************************************************
+* @brief   : Retorna o tempo decorrido desde um instante, em nanossegundos.
+******************************************************************************.
+* @param: start - O instante inicial.
+* @return: double - O tempo decorrido, em nanossegundos.
+******************************************************************************
+*/
+static double elapsedNs(BenchClock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a mediana de um conjunto de amostras.
+******************************************************************************.
+* @param: samples - As amostras (são reordenadas).
+* @return: double - A mediana, ou zero se não houver amostras.
+******************************************************************************
+*/
+static double median(std::vector<double>& samples)
+{
+    if (samples.empty())
+    {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+/**
+******************************************************************************
+* @brief   : Calcula os percentis de um conjunto de amostras.
+******************************************************************************.
+* @param: samples - As amostras (são reordenadas).
+* @return: Percentiles - Os percentis 50, 90 e 99 e a maior amostra.
+******************************************************************************
+*/
+static Percentiles percentiles(std::vector<double>& samples)
+{
+    Percentiles result;
+    if (samples.empty())
+    {
+        return result;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto at = [&samples](double fraction) { return samples[static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1))]; }; // Amostra na posição indicada da distribuição ordenada.
+    result.p50 = at(0.50);
+    result.p90 = at(0.90);
+    result.p99 = at(0.99);
+    result.max = samples.back();
+    return result;
+}
+
+/**
+******************************************************************************
+* @brief   : Mede a latência de um getter do ConfigurationManager.
+* @details : Cada amostra cronometra um lote de chamadas e é dividida pelo tamanho do lote, o que dilui o custo da leitura do relógio sem esconder a variação entre amostras.
+******************************************************************************.
+* @param: getter - A função que chama o getter e retorna um valor derivado do resultado (para que a chamada não seja eliminada pelo compilador).
+* @return: Percentiles - Os percentis da latência por chamada, em nanossegundos.
+******************************************************************************
+*/
+template <typename Getter>
+static Percentiles measureGetter(Getter getter)
+{
+    constexpr int SAMPLES = 20000; // Quantidade de amostras.
+    constexpr int BATCH = 8; // Chamadas por amostra.
+    std::vector<double> samples; // Latência por chamada de cada amostra.
+    samples.reserve(SAMPLES);
+    volatile int sink = 0; // Consome os resultados.
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        auto start = BenchClock::now();
+        for (int j = 0; j < BATCH; ++j)
+        {
+            sink = sink + getter();
+        }
+        samples.push_back(elapsedNs(start) / BATCH);
+    }
+    return percentiles(samples);
+}
+
+/**
+******************************************************************************
+* @brief   : Percorre o texto como o IniTokenizer fazia antes dos núcleos de varredura: cada linha é delimitada por find('\n') e classificada por parseIniLine, que procura o '='.
+******************************************************************************.
+* @param: text - O texto do arquivo.
+* @return: std::size_t - A quantidade de pares chave/valor encontrados.
+******************************************************************************
+*/
+static std::size_t referenceTokenize(std::string_view text)
+{
+    std::size_t count = 0;
+    std::size_t position = 0;
+    while (position < text.size())
+    {
+        std::size_t end = text.find('\n', position);
+        if (end == std::string_view::npos)
+        {
+            end = text.size();
+        }
+        std::string_view first;
+        std::string_view second;
+        count += parseIniLine(text.substr(position, end - position), first, second) == IniLineType::KEY_VALUE;
+        position = end + 1;
+    }
+    return count;
+}
+
+/**
+******************************************************************************
+* @brief   : Mede a vazão de uma função de tokenização sobre o texto de um arquivo.
+******************************************************************************.
+* @param: text - O texto do arquivo.
+* @param: iterations - A quantidade de repetições.
+* @param: tokenize - A função que percorre o texto e retorna a quantidade de pares encontrados.
+* @return: double - A mediana da vazão, em GB/s (bytes por nanossegundo).
+******************************************************************************
+*/
+template <typename Tokenize>
+static double measureTokenize(std::string_view text, unsigned iterations, Tokenize tokenize)
+{
+    std::vector<double> samples; // Tempos de cada repetição.
+    volatile std::size_t sink = 0; // Consome os resultados.
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        auto start = BenchClock::now();
+        sink = sink + tokenize(text);
+        samples.push_back(elapsedNs(start));
+    }
+    return static_cast<double>(text.size()) / median(samples);
+}
+
+/**
+******************************************************************************
+* @brief   : Grava um documento JSON com os mesmos dados de um arquivo INI.
+* @details : Os pares encontrados pelo IniTokenizer são gravados em ordem: os da seção global como membros do objeto principal e os de cada seção em um objeto com o nome dela. As linhas descartadas pelo tokenizador não têm equivalente.
+******************************************************************************.
+* @param: iniPath - O arquivo INI de origem.
+* @param: jsonPath - O documento JSON a ser gravado.
+* @return: std::expected<std::uint64_t, ErrorCode> - O tamanho do documento, ou FILE_OPEN_FAILED.
+******************************************************************************
+*/
+static std::expected<std::uint64_t, ErrorCode> writeJsonEquivalent(const std::string& iniPath, const std::string& jsonPath)
+{
+    MappedFile source(iniPath);
+    std::ofstream output(jsonPath, std::ios::trunc | std::ios::binary);
+    if (!source.isOpen() || !output.is_open())
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    IniTokenizer tokenizer(source.view());
+    IniToken token;
+    std::optional<std::string_view> section; // Seção do objeto aberto, ou std::nullopt se nenhum estiver aberto.
+    bool first = true; // Indica se o próximo membro é o primeiro do objeto corrente.
+    output << "{";
+    while (tokenizer.next(token))
+    {
+        if (!token.section.empty() && token.section != section) // Abre o objeto de uma nova seção.
+        {
+            output << (section ? "\n  }" : "") << (section || !first ? ",\n  " : "\n  ");
+            writeJsonString(output, token.section);
+            output << ": {";
+            section = token.section;
+            first = true;
+        }
+        output << (first ? "\n    " : ",\n    ");
+        writeJsonString(output, token.key);
+        output << ": ";
+        writeJsonString(output, token.value);
+        first = false;
+    }
+    output << (section ? "\n  }\n}\n" : "\n}\n");
+    if (!output.flush())
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    return static_cast<std::uint64_t>(output.tellp());
+}
+
+/**
+******************************************************************************
+* @brief   : Executa um cenário do benchmark.
+******************************************************************************.
+* @param: filePath - O caminho do arquivo a ser gerado e medido.
+* @param: profile - A forma do arquivo.
+* @param: targetBytes - O tamanho do arquivo.
+* @param: options - As opções da linha de comando.
+* @return: std::expected<BenchResult, ErrorCode> - Os resultados do cenário, ou o código de erro se o arquivo não puder ser gerado ou as configurações do arquivo gerado forem inválidas.
+******************************************************************************
+*/
+static std::expected<BenchResult, ErrorCode> runScenario(const std::string& filePath, const IniProfile& profile, std::uint64_t targetBytes, const BenchOptions& options)
+{
+    BenchResult result;
+    result.profile = profile.name;
+    result.targetBytes = targetBytes;
+
+    auto generated = generateIni(filePath, targetBytes, profile, options.seed); // Gera o arquivo do cenário.
+    if (!generated)
+    {
+        return std::unexpected(generated.error());
+    }
+    result.file = *generated;
+
+    std::uint64_t repetitions = std::max<std::uint64_t>(1, (256ull << 20) / std::max<std::uint64_t>(result.file.bytes, 1)); // Arquivos grandes são medidos menos vezes.
+    result.iterations = static_cast<unsigned>(std::min<std::uint64_t>(options.iterations, repetitions));
+
+    { IniParser warmUp(filePath); } // Carrega o arquivo no cache de páginas antes das medidas.
+
+    std::vector<double> loadSamples; // Tempos de construção do IniParser.
+    std::vector<double> createSamples; // Tempos de createParser.
+    for (unsigned i = 0; i < result.iterations; ++i)
+    {
+        std::uint64_t allocationsBefore = g_allocationCount.load(std::memory_order_relaxed);
+        std::uint64_t bytesBefore = g_allocatedBytes.load(std::memory_order_relaxed);
+        auto start = BenchClock::now();
+        IniParser parser(filePath);
+        loadSamples.push_back(elapsedNs(start));
+        result.allocationsPerLoad = g_allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+        result.allocatedBytesPerLoad = g_allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+
+        if (i == 0) // As consultas não dependem do tamanho do arquivo; basta medi-las uma vez.
+        {
+            constexpr int CALLS = 10000; // Chamadas usadas para calcular o tempo médio de cada consulta.
+            start = BenchClock::now();
+            for (int j = 0; j < CALLS; ++j)
+            {
+                if (!parser.parseTcp()) // As seções geradas são sempre válidas.
+                {
+                    return std::unexpected(ErrorCode::PARSE_ERROR);
+                }
+            }
+            result.parseTcpNs = elapsedNs(start) / CALLS;
+            start = BenchClock::now();
+            for (int j = 0; j < CALLS; ++j)
+            {
+                if (!parser.parseUart())
+                {
+                    return std::unexpected(ErrorCode::PARSE_ERROR);
+                }
+            }
+            result.parseUartNs = elapsedNs(start) / CALLS;
+        }
+    }
+    for (unsigned i = 0; i < result.iterations; ++i) // createParser é medido separadamente, para que dois índices grandes não coexistam em memória.
+    {
+        auto start = BenchClock::now();
+        auto parser = createParser(filePath);
+        createSamples.push_back(elapsedNs(start));
+        if (!parser)
+        {
+            return std::unexpected(parser.error());
+        }
+    }
+    result.loadNs = median(loadSamples);
+    result.loadNsPerByte = result.loadNs / static_cast<double>(result.file.bytes);
+    result.createParserNs = median(createSamples);
+
+    std::vector<double> lazyLoadSamples; // Tempos de construção do LazyIniParser.
+    std::vector<double> lazyReadSamples; // Tempos de construção e das duas primeiras consultas.
+    for (unsigned i = 0; i < result.iterations; ++i)
+    {
+        std::uint64_t bytesBefore = g_allocatedBytes.load(std::memory_order_relaxed);
+        auto start = BenchClock::now();
+        LazyIniParser parser(filePath);
+        lazyLoadSamples.push_back(elapsedNs(start));
+        bool valid = parser.parseTcp().has_value() && parser.parseUart().has_value(); // Indexa somente as duas seções.
+        lazyReadSamples.push_back(elapsedNs(start));
+        result.lazyAllocatedBytes = g_allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+        if (!valid)
+        {
+            return std::unexpected(ErrorCode::PARSE_ERROR);
+        }
+    }
+    result.lazyLoadNs = median(lazyLoadSamples);
+    result.lazyTwoSectionsNs = median(lazyReadSamples);
+
+    std::string jsonPath = filePath + ".json"; // Documento JSON com os mesmos dados.
+    auto jsonBytes = writeJsonEquivalent(filePath, jsonPath);
+    if (!jsonBytes)
+    {
+        return std::unexpected(jsonBytes.error());
+    }
+    result.jsonBytes = *jsonBytes;
+    { JsonParser warmUp(jsonPath); }
+    std::vector<double> jsonSamples; // Tempos de construção do JsonParser.
+    for (unsigned i = 0; i < result.iterations; ++i)
+    {
+        auto start = BenchClock::now();
+        JsonParser parser(jsonPath);
+        jsonSamples.push_back(elapsedNs(start));
+        if (i == 0 && (!parser.parseTcp() || !parser.parseUart())) // O documento equivalente deve ser válido.
+        {
+            return std::unexpected(ErrorCode::PARSE_ERROR);
+        }
+    }
+    std::error_code removeError;
+    std::filesystem::remove(jsonPath, removeError);
+    result.jsonLoadNs = median(jsonSamples);
+    result.jsonLoadNsPerByte = result.jsonLoadNs / static_cast<double>(result.jsonBytes);
+
+    MappedFile file(filePath); // Texto usado na medida da tokenização, sem a construção do índice.
+    result.tokenizeReferenceGbps = measureTokenize(file.view(), result.iterations, referenceTokenize);
+    for (int level = 0; level < 3; ++level)
+    {
+        result.tokenizeGbps[level] = measureTokenize(file.view(), result.iterations, [level](std::string_view text)
+        {
+            IniTokenizer tokenizer(text, static_cast<IniScanLevel>(level));
+            IniToken token;
+            std::size_t count = 0;
+            while (tokenizer.next(token))
+            {
+                ++count;
+            }
+            return count;
+        });
+    }
+
+    ConfigurationManager manager(std::make_unique<IniParser>(filePath)); // Gerenciador usado na medida dos getters.
+    result.getTcpConfig = measureGetter([&manager] { return manager.get_tcp_config()->port; });
+    result.getUartConfig = measureGetter([&manager] { return manager.get_uart_config()->baudrate; });
+    result.getByName = measureGetter([&manager] { return *manager.get<int>("TCP", "port"); });
+    auto port = manager.intern<int>("TCP", "port"); // Resolvido uma única vez.
+    if (!port)
+    {
+        return std::unexpected(port.error());
+    }
+    result.getByHandle = measureGetter([&manager, handle = *port] { return *manager.get(handle); });
+    setConfigMetricsEnabled(true); // As demais medidas são feitas com a instrumentação desligada, o padrão.
+    result.getTcpConfigMetrics = measureGetter([&manager] { return manager.get_tcp_config()->port; });
+    setConfigMetricsEnabled(false);
+    return result;
+}
+
+/**
+******************************************************************************
+* @brief   : Mede a comparação de snapshots sobre um arquivo com muitas instâncias numeradas.
+* @details : São gravados dois arquivos com [TCP], [UART] e 10000 instâncias [UART0] ... [UART9999]; no segundo, somente a instância do meio muda de baudrate. A comparação de dois snapshots do primeiro arquivo mede o caso em que nada muda (todas as seções são descartadas pelo hash); a comparação entre os dois arquivos mede o caso de uma única mudança. Por fim, reloads alternados entre os dois arquivos medem o custo completo com uma assinatura ativa.
+******************************************************************************.
+* @param: filePath - O caminho base dos arquivos gerados.
+* @param: options - As opções da linha de comando.
+* @return: std::expected<DiffResult, ErrorCode> - Os resultados, ou o código de erro se os arquivos não puderem ser gravados ou carregados.
+******************************************************************************
+*/
+static std::expected<DiffResult, ErrorCode> runDiffScenario(const std::string& filePath, const BenchOptions& options)
+{
+    constexpr int INSTANCES = 10000; // Instâncias UART de cada arquivo.
+    const std::string paths[2] = {filePath + ".a", filePath + ".b"}; // Arquivo original e arquivo com uma instância alterada.
+    for (int version = 0; version < 2; ++version)
+    {
+        std::ofstream output(paths[version], std::ios::trunc);
+        output << "[TCP]\nip=192.168.0.1\nport=502\nprotocol=TCP\n[UART]\nbaudrate=9600\ndata_bits=8\nparity=None\nstop_bits=1\n";
+        for (int i = 0; i < INSTANCES; ++i)
+        {
+            int baudrate = version == 1 && i == INSTANCES / 2 ? 115200 : 9600 + i;
+            output << "[UART" << i << "]\nbaudrate=" << baudrate << "\ndata_bits=8\nparity=None\nstop_bits=1\n";
+        }
+        if (!output.flush())
+        {
+            return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+        }
+    }
+
+    DiffResult result;
+    ConfigurationManager manager(std::make_unique<IniParser>(paths[0]));
+    std::shared_ptr<const ConfigSnapshot> original = manager.get_snapshot();
+    std::shared_ptr<const ConfigSnapshot> same = ConfigurationManager(std::make_unique<IniParser>(paths[0])).get_snapshot();
+    std::shared_ptr<const ConfigSnapshot> changed = ConfigurationManager(std::make_unique<IniParser>(paths[1])).get_snapshot();
+    if (!original->uart || original->uartInstances.size() != INSTANCES || changed->uartInstances.size() != INSTANCES)
+    {
+        return std::unexpected(ErrorCode::PARSE_ERROR);
+    }
+    result.sections = 2 + original->uartInstances.size();
+
+    unsigned iterations = std::max(1u, std::min(options.iterations, 100u)); // Repetições de cada medida.
+    std::vector<double> unchangedSamples;
+    std::vector<double> changedSamples;
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        auto start = BenchClock::now();
+        ConfigDiff diff = diffSnapshots(original, same);
+        unchangedSamples.push_back(elapsedNs(start));
+        start = BenchClock::now();
+        diff = diffSnapshots(original, changed);
+        changedSamples.push_back(elapsedNs(start));
+        result.changes = diff.tcp.size() + diff.uart.size();
+    }
+    result.unchangedNs = median(unchangedSamples);
+    result.oneChangeNs = median(changedSamples);
+
+    std::string section = "UART" + std::to_string(INSTANCES / 2); // Instância alterada pelo segundo arquivo.
+    auto subscription = manager.subscribeUartSection(section, [&result](const ConfigChange<UartConfig>&) { ++result.notifications; });
+    if (!subscription)
+    {
+        return std::unexpected(subscription.error());
+    }
+    std::vector<double> reloadSamples;
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        auto start = BenchClock::now();
+        auto reloaded = manager.reload(std::make_unique<IniParser>(paths[(i + 1) % 2]));
+        reloadSamples.push_back(elapsedNs(start));
+        if (!reloaded)
+        {
+            return std::unexpected(reloaded.error());
+        }
+    }
+    result.reloadNs = median(reloadSamples);
+
+    std::error_code error;
+    std::filesystem::remove(paths[0], error);
+    std::filesystem::remove(paths[1], error);
+    return result;
+}
+
+/**
+******************************************************************************
+* @brief   : Mede a validação paralela das seções numeradas com 1, 4 e 16 threads.
+* @details : O arquivo tem 20000 instâncias UART e 20000 instâncias TCP. Para cada quantidade de threads, um gerenciador é criado com um ThreadPool desse tamanho e o mesmo arquivo é recarregado várias vezes; cada reload interpreta o arquivo e valida todas as instâncias com parallelFor. Com menos núcleos que threads, a medida mostra apenas o custo do pool.
+******************************************************************************.
+* @param: filePath - O caminho base dos arquivos gerados.
+* @param: options - As opções da linha de comando.
+* @return: std::expected<ParallelResult, ErrorCode> - Os resultados, ou o código de erro de um reload.
+******************************************************************************
+*/
+static std::expected<ParallelResult, ErrorCode> runParallelScenario(const std::string& filePath, const BenchOptions& options)
+{
+    constexpr int INSTANCES = 20000; // Instâncias de cada tipo.
+    const std::string path = filePath + ".parallel";
+    {
+        std::ofstream output(path, std::ios::trunc);
+        for (int i = 0; i < INSTANCES; ++i)
+        {
+            output << "[UART" << i << "]\nbaudrate=" << 9600 + i << "\ndata_bits=8\nparity=None\nstop_bits=1\n";
+            output << "[TCP" << i << "]\nip=10.0." << (i / 250) % 250 << "." << i % 250 << "\nport=" << 1024 + i << "\nprotocol=TCP\n";
+        }
+        if (!output.flush())
+        {
+            return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+        }
+    }
+
+    ParallelResult result;
+    result.sections = 2ull * INSTANCES;
+    result.hardwareThreads = std::thread::hardware_concurrency();
+    unsigned iterations = std::max(1u, std::min(options.iterations, 20u)); // Repetições de cada medida.
+    for (unsigned threads : {1u, 4u, 16u})
+    {
+        ConfigurationManager manager(std::make_unique<IniParser>(path), threads);
+        if (manager.get_all_uart_configs()->size() != INSTANCES || manager.get_all_tcp_configs()->size() != INSTANCES)
+        {
+            return std::unexpected(ErrorCode::PARSE_ERROR);
+        }
+        std::vector<double> samples;
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            auto start = BenchClock::now();
+            auto reloaded = manager.reload(std::make_unique<IniParser>(path));
+            samples.push_back(elapsedNs(start));
+            if (!reloaded)
+            {
+                return std::unexpected(reloaded.error());
+            }
+        }
+        double reloadNs = median(samples);
+        result.runs.push_back(ParallelRun{threads, reloadNs, reloadNs > 0 ? static_cast<double>(result.sections) * 1e9 / reloadNs : 0});
+    }
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    return result;
+}
+
+/**
+******************************************************************************
+* @brief   : Mede a carga de um arquivo base com 1000 fragmentos em um diretório conf.d.
+* @details : Cada fragmento declara uma instância [TCPn] própria e sobrescreve a porta de [TCP], de modo que a combinação precisa respeitar a ordem dos nomes. A construção do LayeredParser (listagem do diretório, leitura e tokenização das camadas em paralelo e combinação no índice) é medida com 1 e 4 threads e comparada com a do IniParser sobre um único arquivo com as mesmas linhas.
+******************************************************************************.
+* @param: filePath - O caminho base dos arquivos gerados.
+* @param: options - As opções da linha de comando.
+* @return: std::expected<LayeredResult, ErrorCode> - Os resultados, ou o código de erro da gravação ou da carga das camadas.
+******************************************************************************
+*/
+static std::expected<LayeredResult, ErrorCode> runLayeredScenario(const std::string& filePath, const BenchOptions& options)
+{
+    constexpr int FRAGMENTS = 1000; // Fragmentos do diretório.
+    const std::string basePath = filePath + ".base";
+    const std::string singlePath = filePath + ".single"; // Arquivo único com o conteúdo de todas as camadas.
+    const std::filesystem::path directory = filePath + ".conf.d";
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    std::filesystem::create_directories(directory, error);
+    {
+        const std::string base = "[TCP]\nip=10.0.0.1\nport=502\nprotocol=TCP\n\n[UART]\nbaudrate=9600\ndata_bits=8\nparity=None\nstop_bits=1\n";
+        std::ofstream baseOutput(basePath, std::ios::trunc);
+        std::ofstream singleOutput(singlePath, std::ios::trunc);
+        baseOutput << base;
+        singleOutput << base;
+        for (int i = 0; i < FRAGMENTS; ++i)
+        {
+            std::string name = std::to_string(i);
+            name = std::string(4 - name.size(), '0') + name + "-fragment.ini"; // Zeros à esquerda: a ordem alfabética é a numérica.
+            std::string fragment = "[TCP]\nport=" + std::to_string(2000 + i) + "\n[TCP" + std::to_string(i) + "]\nip=10.1." + std::to_string(i / 250) + "." + std::to_string(i % 250)
+                                 + "\nport=" + std::to_string(10000 + i) + "\nprotocol=UDP\n";
+            std::ofstream output(directory / name, std::ios::trunc);
+            output << fragment;
+            singleOutput << fragment;
+            if (!output.flush())
+            {
+                return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+            }
+        }
+        if (!baseOutput.flush() || !singleOutput.flush())
+        {
+            return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+        }
+    }
+
+    LayeredResult result;
+    result.fragments = FRAGMENTS;
+    unsigned iterations = std::max(1u, std::min(options.iterations, 20u)); // Repetições de cada medida.
+    std::vector<double> samples;
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        auto start = BenchClock::now();
+        IniParser parser(singlePath);
+        samples.push_back(elapsedNs(start));
+    }
+    result.singleFileNs = median(samples);
+    for (unsigned threads : {1u, 4u})
+    {
+        samples.clear();
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            auto start = BenchClock::now();
+            LayeredParser parser(basePath, directory.string(), threads);
+            samples.push_back(elapsedNs(start));
+            if (std::optional<ErrorCode> loadError = parser.loadError())
+            {
+                return std::unexpected(*loadError);
+            }
+            if (result.runs.empty() && i == 0) // A combinação é verificada uma vez: a última porta declarada e a sua origem.
+            {
+                std::expected<TcpConfig, ErrorCode> tcp = parser.parseTcp();
+                std::optional<std::string_view> origin = parser.originOf("TCP", "port");
+                result.bytes = std::filesystem::file_size(singlePath, error);
+                result.consistent = tcp && tcp->port == 2000 + FRAGMENTS - 1 && origin && origin->ends_with("0999-fragment.ini") && parser.parseTcpSection("TCP0").has_value();
+            }
+        }
+        double loadNs = median(samples);
+        result.runs.push_back(LayeredRun{threads, loadNs, loadNs > 0 ? static_cast<double>(FRAGMENTS + 1) * 1e9 / loadNs : 0});
+    }
+
+    std::filesystem::remove_all(directory, error);
+    std::filesystem::remove(basePath, error);
+    std::filesystem::remove(singlePath, error);
+    return result;
+}
+
+/**
+******************************************************************************
+* @brief   : Mede as alterações em tempo de execução gravadas no journal.
+* @details : O arquivo base tem [TCP], [UART] e 100 instâncias UART. São feitas 10000 alterações com set, distribuídas entre as instâncias, com o journal aberto e sem compactação automática; em seguida, o journal é reaplicado por gerenciadores novos (openJournal) e compactado no arquivo base. Para comparação, as mesmas alterações são medidas sem journal e, em menor número, seguidas da reescrita do arquivo inteiro. A latência com o journal depende do armazenamento: em um tmpfs, o fdatasync não espera nenhum dispositivo.
+******************************************************************************.
+* @param: filePath - O caminho base dos arquivos gerados.
+* @param: options - As opções da linha de comando.
+* @return: std::expected<JournalResult, ErrorCode> - Os resultados, ou o código de erro de uma alteração, da reaplicação ou da compactação.
+******************************************************************************
+*/
+static std::expected<JournalResult, ErrorCode> runJournalScenario(const std::string& filePath, const BenchOptions& options)
+{
+    constexpr int INSTANCES = 100; // Instâncias UART do arquivo base.
+    constexpr int EDITS = 10000; // Alterações gravadas no journal.
+    constexpr int REWRITES = 200; // Alterações seguidas da reescrita do arquivo.
+    const std::string path = filePath + ".journaled"; // Arquivo base; o journal fica em journalPathFor(path).
+    std::error_code error;
+    std::filesystem::remove(journalPathFor(path), error);
+    {
+        std::ofstream output(path, std::ios::trunc);
+        output << "[TCP]\nip=192.168.0.1\nport=502\nprotocol=TCP\n[UART]\nbaudrate=9600\ndata_bits=8\nparity=None\nstop_bits=1\n";
+        for (int i = 0; i < INSTANCES; ++i)
+        {
+            output << "[UART" << i << "]\nbaudrate=" << 9600 + i << "\ndata_bits=8\nparity=None\nstop_bits=1\n";
+        }
+        if (!output.flush())
+        {
+            return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+        }
+    }
+
+    JournalResult result;
+    result.fileBytes = std::filesystem::file_size(path, error);
+    result.edits = EDITS;
+    auto sectionOf = [](int edit) { return "UART" + std::to_string(edit % INSTANCES); }; // Instância alterada pela edição.
+    auto measureSets = [&](ConfigurationManager& manager, int count, bool rewrite) -> std::expected<Percentiles, ErrorCode>
+    {
+        std::vector<double> samples;
+        samples.reserve(static_cast<std::size_t>(count));
+        for (int i = 0; i < count; ++i)
+        {
+            std::string section = sectionOf(i);
+            auto start = BenchClock::now();
+            auto written = manager.set(section, "baudrate", 115200 + i);
+            if (written && rewrite)
+            {
+                written = manager.compactJournal();
+            }
+            samples.push_back(elapsedNs(start));
+            if (!written)
+            {
+                return std::unexpected(written.error());
+            }
+        }
+        return percentiles(samples);
+    };
+
+    {
+        ConfigurationManager inMemory(std::make_unique<IniParser>(path));
+        auto latency = measureSets(inMemory, EDITS, false);
+        if (!latency)
+        {
+            return std::unexpected(latency.error());
+        }
+        result.setInMemory = *latency;
+    }
+
+    ConfigurationManager manager(std::make_unique<IniParser>(path));
+    auto opened = manager.openJournal(path, 0); // Sem compactação automática: todas as alterações ficam no journal.
+    if (!opened)
+    {
+        return std::unexpected(opened.error());
+    }
+    auto latency = measureSets(manager, EDITS, false);
+    if (!latency)
+    {
+        return std::unexpected(latency.error());
+    }
+    result.setJournaled = *latency;
+    result.journalBytes = manager.journalStats()->bytes;
+
+    const int lastBaudrate = 115200 + EDITS - 1; // Valor da última alteração (na instância EDITS - 1).
+    const std::string lastSection = sectionOf(EDITS - 1);
+    auto hasLastEdit = [&](const ConfigurationManager& replayed) { return replayed.get<int>(lastSection, "baudrate").value_or(0) == lastBaudrate; };
+    unsigned iterations = std::max(1u, std::min(options.iterations, 20u)); // Repetições da reaplicação.
+    std::vector<double> replaySamples;
+    result.consistent = true;
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        ConfigurationManager replayed(std::make_unique<IniParser>(path));
+        auto start = BenchClock::now();
+        auto replay = replayed.openJournal(path, 0);
+        replaySamples.push_back(elapsedNs(start));
+        if (!replay)
+        {
+            return std::unexpected(replay.error());
+        }
+        result.consistent = result.consistent && hasLastEdit(replayed);
+    }
+    result.replayNs = median(replaySamples);
+
+    auto start = BenchClock::now();
+    auto compacted = manager.compactJournal();
+    result.compactNs = elapsedNs(start);
+    if (!compacted)
+    {
+        return std::unexpected(compacted.error());
+    }
+    result.consistent = result.consistent && hasLastEdit(ConfigurationManager(std::make_unique<IniParser>(path))); // O arquivo base, sem o journal.
+
+    latency = measureSets(manager, REWRITES, true);
+    if (!latency)
+    {
+        return std::unexpected(latency.error());
+    }
+    result.setAndRewrite = *latency;
+
+    std::filesystem::remove(path, error);
+    std::filesystem::remove(journalPathFor(path), error);
+    return result;
+}
+
+/**
+******************************************************************************
+* @brief   : Grava os percentis de uma latência como um objeto JSON.
+******************************************************************************.
+* @param: output - O fluxo de saída.
+* @param: value - Os percentis.
+******************************************************************************
+*/
+static void writePercentiles(std::ostream& output, const Percentiles& value)
+{
+    output << "{\"p50\": " << value.p50 << ", \"p90\": " << value.p90 << ", \"p99\": " << value.p99 << ", \"max\": " << value.max << "}";
+}
+
+/**
+******************************************************************************
+* @brief   : Grava os resultados em JSON.
+******************************************************************************.
+* @param: filePath - O caminho do arquivo de resultados.
+* @param: options - As opções da linha de comando.
+* @param: diff - Os resultados da comparação de snapshots.
+* @param: parallel - Os resultados da validação paralela.
+* @param: layered - Os resultados da carga das camadas conf.d.
+* @param: journal - Os resultados das alterações gravadas no journal.
+* @param: results - Os resultados de cada cenário.
+* @return: bool - Retorna false se o arquivo não puder ser gravado.
+******************************************************************************
+*/
+static bool writeJson(const std::string& filePath, const BenchOptions& options, const DiffResult& diff, const ParallelResult& parallel, const LayeredResult& layered, const JournalResult& journal, const std::vector<BenchResult>& results)
+{
+    std::ofstream output(filePath, std::ios::trunc);
+    if (!output.is_open())
+    {
+        return false;
+    }
+    output << "{\n  \"benchmark\": \"config_manager_bench\",\n  \"seed\": " << options.seed << ",\n";
+    output << "  \"diff\": {\"sections\": " << diff.sections
+           << ", \"unchanged_ns\": " << diff.unchangedNs
+           << ", \"one_change_ns\": " << diff.oneChangeNs
+           << ", \"changes\": " << diff.changes
+           << ", \"reload_ns\": " << diff.reloadNs
+           << ", \"notifications\": " << diff.notifications << "},\n";
+    output << "  \"parallel\": {\"sections\": " << parallel.sections
+           << ", \"hardware_threads\": " << parallel.hardwareThreads
+           << ", \"runs\": [";
+    for (std::size_t i = 0; i < parallel.runs.size(); ++i)
+    {
+        output << (i > 0 ? ", " : "") << "{\"threads\": " << parallel.runs[i].threads
+               << ", \"reload_ns\": " << parallel.runs[i].reloadNs
+               << ", \"sections_per_s\": " << parallel.runs[i].sectionsPerSecond << "}";
+    }
+    output << "]},\n";
+    output << "  \"layered\": {\"fragments\": " << layered.fragments
+           << ", \"bytes\": " << layered.bytes
+           << ", \"single_file_ns\": " << layered.singleFileNs
+           << ", \"consistent\": " << (layered.consistent ? "true" : "false")
+           << ", \"runs\": [";
+    for (std::size_t i = 0; i < layered.runs.size(); ++i)
+    {
+        output << (i > 0 ? ", " : "") << "{\"threads\": " << layered.runs[i].threads
+               << ", \"load_ns\": " << layered.runs[i].loadNs
+               << ", \"layers_per_s\": " << layered.runs[i].layersPerSecond << "}";
+    }
+    output << "]},\n";
+    output << "  \"journal\": {\"file_bytes\": " << journal.fileBytes
+           << ", \"edits\": " << journal.edits
+           << ", \"journal_bytes\": " << journal.journalBytes
+           << ", \"set_journaled_ns\": ";
+    writePercentiles(output, journal.setJournaled);
+    output << ", \"set_in_memory_ns\": ";
+    writePercentiles(output, journal.setInMemory);
+    output << ", \"set_and_rewrite_ns\": ";
+    writePercentiles(output, journal.setAndRewrite);
+    output << ", \"replay_ns\": " << journal.replayNs
+           << ", \"compact_ns\": " << journal.compactNs
+           << ", \"consistent\": " << (journal.consistent ? "true" : "false") << "},\n";
+    output << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchResult& result = results[i];
+        output << "    {\"profile\": \"" << result.profile << "\""
+               << ", \"target_bytes\": " << result.targetBytes
+               << ", \"bytes\": " << result.file.bytes
+               << ", \"sections\": " << result.file.sections
+               << ", \"keys\": " << result.file.keys
+               << ", \"malformed_lines\": " << result.file.malformedLines
+               << ", \"iterations\": " << result.iterations
+               << ", \"load_ns\": " << result.loadNs
+               << ", \"load_ns_per_byte\": " << result.loadNsPerByte
+               << ", \"allocations_per_load\": " << result.allocationsPerLoad
+               << ", \"allocated_bytes_per_load\": " << result.allocatedBytesPerLoad
+               << ", \"parse_tcp_ns\": " << result.parseTcpNs
+               << ", \"parse_uart_ns\": " << result.parseUartNs
+               << ", \"create_parser_ns\": " << result.createParserNs
+               << ", \"lazy_load_ns\": " << result.lazyLoadNs
+               << ", \"lazy_two_sections_ns\": " << result.lazyTwoSectionsNs
+               << ", \"lazy_allocated_bytes\": " << result.lazyAllocatedBytes
+               << ", \"json_bytes\": " << result.jsonBytes
+               << ", \"json_load_ns\": " << result.jsonLoadNs
+               << ", \"json_load_ns_per_byte\": " << result.jsonLoadNsPerByte
+               << ", \"get_tcp_config_ns\": ";
+        writePercentiles(output, result.getTcpConfig);
+        output << ", \"get_uart_config_ns\": ";
+        writePercentiles(output, result.getUartConfig);
+        output << ", \"get_by_name_ns\": ";
+        writePercentiles(output, result.getByName);
+        output << ", \"get_by_handle_ns\": ";
+        writePercentiles(output, result.getByHandle);
+        output << ", \"get_tcp_config_metrics_ns\": ";
+        writePercentiles(output, result.getTcpConfigMetrics);
+        output << ", \"tokenize_reference_gb_per_s\": " << result.tokenizeReferenceGbps;
+        for (int level = 0; level < 3; ++level)
+        {
+            output << ", \"tokenize_" << iniScanLevelName(static_cast<IniScanLevel>(level)) << "_gb_per_s\": " << result.tokenizeGbps[level];
+        }
+        output << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    output << "  ]\n}\n";
+    return static_cast<bool>(output.flush());
+}
+
+/**
+******************************************************************************
+* @brief   : Interpreta um tamanho em bytes com um sufixo opcional K, M ou G (potências de 1024).
+******************************************************************************.
+* @param: text - O texto a ser interpretado.
+* @return: std::optional<std::uint64_t> - O tamanho em bytes, ou std::nullopt se o texto for inválido.
+******************************************************************************
+*/
+static std::optional<std::uint64_t> parseSize(std::string_view text)
+{
+    std::uint64_t multiplier = 1;
+    if (!text.empty())
+    {
+        switch (text.back())
+        {
+        case 'K': case 'k': multiplier = 1ull << 10; break;
+        case 'M': case 'm': multiplier = 1ull << 20; break;
+        case 'G': case 'g': multiplier = 1ull << 30; break;
+        default: break;
+        }
+    }
+    if (multiplier != 1)
+    {
+        text.remove_suffix(1);
+    }
+    std::uint64_t value = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || error != std::errc() || end != text.data() + text.size())
+    {
+        return std::nullopt;
+    }
+    return value * multiplier;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options; // Opções da linha de comando.
+    for (int i = 1; i < argc; ++i) // Interpreta as opções; todas exigem um valor.
+    {
+        std::string_view option = argv[i];
+        std::optional<std::uint64_t> parsed = i + 1 < argc ? parseSize(argv[i + 1]) : std::nullopt; // Valor numérico da opção, se houver.
+        bool hasValue = parsed.has_value();
+        std::uint64_t value = parsed.value_or(0); // Copiado para fora do std::optional, que o GCC não consegue provar inicializado nos ramos abaixo (-Wmaybe-uninitialized).
+        if (option == "--output" && i + 1 < argc)
+        {
+            options.output = argv[++i];
+        }
+        else if (option == "--max-size" && hasValue)
+        {
+            options.maxBytes = value;
+            ++i;
+        }
+        else if (option == "--iterations" && hasValue && value > 0)
+        {
+            options.iterations = static_cast<unsigned>(value);
+            ++i;
+        }
+        else if (option == "--seed" && hasValue)
+        {
+            options.seed = value;
+            ++i;
+        }
+        else
+        {
+            std::cerr << "Uso: " << argv[0] << " [--max-size <bytes>[K|M|G]] [--iterations <n>] [--seed <n>] [--output <arquivo.json>]" << std::endl;
+            return 2;
+        }
+    }
+
+    const std::vector<IniProfile> profiles = { // Perfis medidos em cada tamanho.
+        {"wide", 1000, 8, 0.0}, // Poucas seções grandes com chaves curtas.
+        {"narrow", 4, 32, 0.0}, // Muitas seções pequenas com chaves longas.
+        {"noisy", 16, 16, 0.10}, // 10% de linhas descartadas (malformadas ou comentários).
+    };
+    const std::vector<std::uint64_t> sizes = {1ull << 10, 64ull << 10, 1ull << 20, 16ull << 20, 256ull << 20, 1ull << 30}; // Tamanhos de 1 KB a 1 GB.
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "config_manager_bench"; // Diretório dos arquivos gerados.
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    std::string filePath = (directory / "bench.ini").string(); // Arquivo reaproveitado por todos os cenários.
+
+    auto diff = runDiffScenario(filePath, options); // Comparação de snapshots com muitas instâncias, medida uma única vez.
+    if (!diff)
+    {
+        std::cerr << "Erro no cenario da comparacao: " << errorCodeToString(diff.error()) << std::endl;
+        return 1;
+    }
+    std::cout << "diff " << diff->sections << " secoes: " << diff->unchangedNs << " ns sem mudancas, " << diff->oneChangeNs << " ns com "
+              << diff->changes << " mudanca, reload com assinatura " << diff->reloadNs << " ns, " << diff->notifications << " notificacoes" << std::endl;
+
+    auto parallel = runParallelScenario(filePath, options); // Validação paralela das instâncias, medida uma única vez.
+    if (!parallel)
+    {
+        std::cerr << "Erro no cenario da validacao paralela: " << errorCodeToString(parallel.error()) << std::endl;
+        return 1;
+    }
+    std::cout << "validacao paralela " << parallel->sections << " secoes (" << parallel->hardwareThreads << " threads de hardware):";
+    for (const ParallelRun& run : parallel->runs)
+    {
+        std::cout << " " << run.threads << " threads " << run.reloadNs << " ns (" << run.sectionsPerSecond << " secoes/s)";
+    }
+    std::cout << std::endl;
+
+    auto layered = runLayeredScenario(filePath, options); // Carga de um diretório conf.d com muitos fragmentos, medida uma única vez.
+    if (!layered)
+    {
+        std::cerr << "Erro no cenario das camadas: " << errorCodeToString(layered.error()) << std::endl;
+        return 1;
+    }
+    std::cout << "camadas " << layered->fragments << " fragmentos (" << layered->bytes << " B): arquivo unico " << layered->singleFileNs << " ns,";
+    for (const LayeredRun& run : layered->runs)
+    {
+        std::cout << " " << run.threads << " threads " << run.loadNs << " ns (" << run.layersPerSecond << " camadas/s)";
+    }
+    std::cout << (layered->consistent ? "" : ", INCONSISTENTE") << std::endl;
+
+    auto journal = runJournalScenario(filePath, options); // Alterações gravadas no journal, medidas uma única vez.
+    if (!journal)
+    {
+        std::cerr << "Erro no cenario do journal: " << errorCodeToString(journal.error()) << std::endl;
+        return 1;
+    }
+    std::cout << "journal " << journal->edits << " alteracoes (" << journal->journalBytes << " B): set p50/p99 " << journal->setJournaled.p50 << "/" << journal->setJournaled.p99
+              << " ns (sem journal " << journal->setInMemory.p50 << " ns, com reescrita do arquivo " << journal->setAndRewrite.p50 << " ns), reaplicacao "
+              << journal->replayNs << " ns, compactacao " << journal->compactNs << " ns" << (journal->consistent ? "" : ", INCONSISTENTE") << std::endl;
+
+    std::vector<BenchResult> results; // Resultados de todos os cenários.
+    for (std::uint64_t size : sizes)
+    {
+        if (size > options.maxBytes)
+        {
+            break;
+        }
+        for (const IniProfile& profile : profiles)
+        {
+            auto result = runScenario(filePath, profile, size, options);
+            if (!result)
+            {
+                std::cerr << "Erro no cenario " << profile.name << "/" << size << ": " << errorCodeToString(result.error()) << std::endl;
+                std::filesystem::remove(filePath, error);
+                return 1;
+            }
+            std::cout << profile.name << " " << result->file.bytes << " B: " << result->loadNsPerByte << " ns/byte, "
+                      << result->allocationsPerLoad << " alocacoes/carga, carga sob demanda com [TCP] e [UART] "
+                      << result->lazyTwoSectionsNs / result->loadNs << "x o tempo e " << result->lazyAllocatedBytes << "/" << result->allocatedBytesPerLoad
+                      << " bytes alocados, JSON equivalente " << result->jsonLoadNsPerByte << " ns/byte ("
+                      << result->jsonLoadNs / result->loadNs << "x o tempo do INI), get_tcp_config p50/p99 "
+                      << result->getTcpConfig.p50 << "/" << result->getTcpConfig.p99 << " ns, get<int> por nome/identificador p50 "
+                      << result->getByName.p50 << "/" << result->getByHandle.p50 << " ns, tokenizacao "
+                      << result->tokenizeReferenceGbps << " GB/s (referencia) / " << result->tokenizeGbps[static_cast<int>(bestIniScanLevel())] << " GB/s ("
+                      << iniScanLevelName(bestIniScanLevel()) << ")" << std::endl;
+            results.push_back(std::move(*result));
+        }
+    }
+    std::filesystem::remove(filePath, error); // Os arquivos gerados podem ter até 1 GB.
+
+    if (!writeJson(options.output, options, *diff, *parallel, *layered, *journal, results))
+    {
+        std::cerr << "Erro ao gravar " << options.output << std::endl;
+        return 1;
+    }
+    std::cout << "Resultados gravados em " << options.output << std::endl;
+    return 0;
+}
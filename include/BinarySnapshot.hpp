@@ -0,0 +1,103 @@
+/*
+ * BinarySnapshot.hpp
+ *
+ * Definição do formato de snapshot binário das configurações e do parser que o carrega. O snapshot guarda registros de tamanho fixo, já validados, acompanhados de um checksum e do hash do arquivo INI de origem. Ele é carregado com um único mmap e nenhuma interpretação de texto, o que reduz o tempo de inicialização em memórias flash lentas.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef BINARY_SNAPSHOT_HPP
+#define BINARY_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "IConfigParser.hpp"
+#include "MappedFile.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Cabeçalho do snapshot binário, gravado no início do arquivo. Todos os campos são gravados na ordem de bytes nativa; o campo byteOrder permite rejeitar snapshots gerados em uma plataforma de ordem diferente.
+struct BinarySnapshotHeader
+{
+    char magic[4]; // Identificador do formato: "CFGS".
+    std::uint16_t version; // Versão do formato (BINARY_SNAPSHOT_VERSION).
+    std::uint16_t headerSize; // Tamanho deste cabeçalho, em bytes.
+    std::uint32_t byteOrder; // Marca de ordem de bytes (0x01020304).
+    std::uint32_t tcpCount; // Quantidade de registros TCP.
+    std::uint32_t uartCount; // Quantidade de registros UART.
+    std::uint32_t reserved; // Reservado para versões futuras; gravado como zero.
+    std::uint64_t sourceSize; // Tamanho, em bytes, do arquivo INI de origem.
+    std::int64_t sourceWriteTime; // Data de modificação do arquivo INI de origem, na resolução do sistema de arquivos.
+    std::uint64_t sourceHash; // Hash FNV-1a de 64 bits do conteúdo do arquivo INI de origem.
+    std::uint64_t checksum; // Hash FNV-1a de 64 bits dos registros que seguem o cabeçalho.
+};
+
+// Registro de tamanho fixo com uma configuração TCP. Os textos são terminados em nulo dentro dos seus campos.
+struct BinaryTcpRecord
+{
+    char section[32]; // Nome da seção de origem (por exemplo, "TCP" ou "TCP3").
+    std::uint32_t status; // Zero para uma configuração válida, ou o valor do ErrorCode somado de 1.
+    std::int32_t port; // Porta.
+    char ip[64]; // Endereço IP ou nome do host.
+    char protocol[8]; // Protocolo ("TCP" ou "UDP").
+};
+
+// Registro de tamanho fixo com uma configuração UART. Os textos são terminados em nulo dentro dos seus campos.
+struct BinaryUartRecord
+{
+    char section[32]; // Nome da seção de origem (por exemplo, "UART" ou "UART12").
+    std::uint32_t status; // Zero para uma configuração válida, ou o valor do ErrorCode somado de 1.
+    std::int32_t baudrate; // Taxa de transmissão.
+    std::int32_t dataBits; // Número de bits de dados.
+    std::int32_t stopBits; // Número de bits de parada.
+    char parity[16]; // Paridade.
+};
+
+inline constexpr std::uint16_t BINARY_SNAPSHOT_VERSION = 1; // Versão atual do formato. Deve ser incrementada a cada mudança de layout.
+
+std::uint64_t hashBytes(std::string_view bytes); // Calcula o hash FNV-1a de 64 bits de uma sequência de bytes.
+std::expected<void, ErrorCode> writeBinarySnapshot(const std::string& sourcePath, const std::string& snapshotPath); // Interpreta e valida o arquivo INI de origem e grava o snapshot binário correspondente, de forma atômica.
+std::expected<std::unique_ptr<IConfigParser>, ErrorCode> loadBinarySnapshot(const std::string& snapshotPath, const std::string& sourcePath, std::optional<std::string_view> sourceContent = std::nullopt); // Carrega um snapshot binário, verificando o formato, o checksum e se ele ainda corresponde ao arquivo INI de origem. Se o chamador já tiver aberto a origem, o seu conteúdo é recebido em sourceContent e usado na verificação, sem abri-la de novo.
+
+// Classe BinarySnapshotParser, que implementa a interface IConfigParser sobre um snapshot binário mapeado em memória. Os registros são lidos diretamente da região mapeada, sem nenhuma interpretação de texto. Instâncias são criadas pela função loadBinarySnapshot, que faz todas as verificações. As consultas genéricas (findValue) aos campos dos registros também são respondidas pelo snapshot; as demais chaves, e a posição de uma chave (locate), vêm do arquivo INI de origem, aberto somente na primeira consulta que precisar dele.
+class BinarySnapshotParser : public IConfigParser
+{
+private:
+    MappedFile m_file; // Conteúdo do snapshot, mapeado em memória.
+    const BinaryTcpRecord* m_tcpRecords = nullptr; // Registros TCP, dentro da região mapeada.
+    const BinaryUartRecord* m_uartRecords = nullptr; // Registros UART, dentro da região mapeada.
+    std::uint32_t m_tcpCount = 0; // Quantidade de registros TCP.
+    std::uint32_t m_uartCount = 0; // Quantidade de registros UART.
+    std::unordered_map<std::string_view, std::uint32_t> m_tcpIndex; // Posição de cada registro TCP, pelo nome da sua seção.
+    std::unordered_map<std::string_view, std::uint32_t> m_uartIndex; // Posição de cada registro UART, pelo nome da sua seção.
+    std::vector<std::string_view> m_sections; // Nomes das seções dos registros TCP seguidos dos nomes das seções dos registros UART, como visões da região mapeada.
+    std::string m_sourcePath; // Caminho do arquivo INI de origem.
+    std::uint64_t m_sourceHash = 0; // Hash do conteúdo da origem gravado no snapshot.
+    mutable std::once_flag m_numbersOnce; // Garante que os inteiros dos registros sejam formatados uma única vez.
+    mutable std::vector<char> m_numbers; // Texto dos campos inteiros dos registros, em posições de tamanho fixo, formatado na primeira consulta por findValue.
+    mutable std::once_flag m_sourceOnce; // Garante que a origem seja aberta uma única vez.
+    mutable std::unique_ptr<IConfigParser> m_source; // Parser da origem (LazyIniParser), ou nullptr antes da primeira consulta e se a origem não puder ser aberta ou não corresponder mais ao snapshot.
+
+    std::string_view numberText(std::size_t slot) const; // Retorna o texto de um campo inteiro dos registros.
+    const IConfigParser* sourceParser() const; // Retorna o parser da origem, abrindo-a na primeira chamada, ou nullptr.
+public:
+    BinarySnapshotParser(MappedFile file, std::string sourcePath); // Construtor que recebe o snapshot já mapeado e verificado por loadBinarySnapshot e o caminho do arquivo INI de origem.
+    std::expected<TcpConfig, ErrorCode> parseTcp() override; // Retorna a configuração TCP gravada no registro da seção [TCP].
+    std::expected<UartConfig, ErrorCode> parseUart() override; // Retorna a configuração UART gravada no registro da seção [UART].
+    std::span<const std::string_view> sectionNames() const override; // Retorna os nomes das seções que possuem um registro no snapshot.
+    std::expected<TcpConfig, ErrorCode> parseTcpSection(std::string_view section) const override; // Retorna a configuração TCP gravada no registro de uma seção específica.
+    std::expected<UartConfig, ErrorCode> parseUartSection(std::string_view section) const override; // Retorna a configuração UART gravada no registro de uma seção específica.
+    std::optional<std::string_view> findValue(std::string_view section, std::string_view key) const override; // Retorna o valor de um campo gravado em um registro válido ou, para as demais chaves, o valor do arquivo INI de origem.
+    SourceLocation locate(std::string_view section, std::string_view key) const override; // Retorna a posição da chave no arquivo INI de origem.
+};
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * ConfigDiff.hpp
+ *
+ * Definição da comparação entre dois snapshots de configuração, seção a seção e campo a campo. As instâncias numeradas guardam um hash de conteúdo calculado na validação, de modo que a comparação de arquivos com milhares de seções só compara os campos das seções cujo hash mudou.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef CONFIG_DIFF_HPP
+#define CONFIG_DIFF_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "ConfigSchema.hpp"
+#include "ConfigSnapshot.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Tipo de mudança de uma seção entre dois snapshots.
+enum class ChangeKind
+{
+    ADDED, // A seção só existe no snapshot novo.
+    REMOVED, // A seção só existe no snapshot anterior.
+    MODIFIED // A seção existe nos dois, com conteúdo diferente (campos diferentes, ou mudança entre válida e inválida).
+};
+
+// Mudança de uma seção de configuração ([TCP], [UART] ou uma instância numerada). Os ponteiros apontam para os snapshots guardados em ConfigDiff, e são válidos enquanto ele viver.
+template <typename T>
+struct ConfigChange
+{
+    std::string_view section; // Nome da seção (por exemplo, "TCP" ou "UART3").
+    ChangeKind kind = ChangeKind::MODIFIED; // Tipo da mudança.
+    const std::expected<T, ErrorCode>* before = nullptr; // Valor anterior (configuração ou erro), ou nullptr se a seção foi acrescentada.
+    const std::expected<T, ErrorCode>* after = nullptr; // Valor novo, ou nullptr se a seção foi removida.
+    std::uint64_t fields = 0; // Máscara dos campos de ConfigSchema<T>::fields que mudaram (bit i para o i-ésimo campo). Só é preenchida quando os dois valores são configurações válidas.
+
+    std::vector<std::string_view> changedKeys() const // Retorna as chaves dos campos que mudaram, na ordem do esquema.
+    {
+        std::vector<std::string_view> keys;
+        for (std::size_t i = 0; i < 64; ++i)
+        {
+            if (fields & (std::uint64_t{1} << i))
+            {
+                keys.push_back(fieldKey<T>(i));
+            }
+        }
+        return keys;
+    }
+};
+
+// Resultado da comparação de dois snapshots. Guarda os dois snapshots, para que os valores apontados pelas mudanças continuem válidos.
+struct ConfigDiff
+{
+    std::shared_ptr<const ConfigSnapshot> before; // Snapshot anterior.
+    std::shared_ptr<const ConfigSnapshot> after; // Snapshot novo.
+    std::vector<ConfigChange<TcpConfig>> tcp; // Mudanças de [TCP] (sempre a primeira, se houver) e das instâncias [TCP0], [TCP1], ..., em ordem numérica.
+    std::vector<ConfigChange<UartConfig>> uart; // Mudanças de [UART] e das instâncias [UART0], [UART1], ..., análogo a tcp.
+    std::size_t unchanged = 0; // Seções presentes nos dois snapshots cujo conteúdo não mudou.
+
+    bool empty() const { return tcp.empty() && uart.empty(); } // Retorna true se nenhuma seção mudou.
+    const ConfigChange<TcpConfig>* findTcp(std::string_view section) const; // Retorna a mudança de uma seção TCP, ou nullptr se ela não mudou.
+    const ConfigChange<UartConfig>* findUart(std::string_view section) const; // Retorna a mudança de uma seção UART, ou nullptr se ela não mudou.
+};
+
+ConfigDiff diffSnapshots(std::shared_ptr<const ConfigSnapshot> before, std::shared_ptr<const ConfigSnapshot> after); // Compara dois snapshots seção a seção. Somente as seções com hashes diferentes têm os seus campos comparados. Os vetores do resultado só alocam quando há mudanças.
+
+#endif
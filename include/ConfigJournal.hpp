@@ -0,0 +1,167 @@
+/*
+ * ConfigJournal.hpp
+ *
+ * Definição do journal de alterações das configurações e do parser que as aplica sobre o arquivo base. Cada alteração feita em tempo de execução (ConfigurationManager::set) é acrescentada ao final de um arquivo binário compacto, ao lado do arquivo de configuração, em vez de reescrever o arquivo inteiro. Na carga, o journal é reaplicado sobre o arquivo base; de tempos em tempos, uma thread em segundo plano incorpora as alterações ao arquivo base, com uma renomeação atômica, e esvazia o journal.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef CONFIG_JOURNAL_HPP
+#define CONFIG_JOURNAL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "IConfigParser.hpp"
+#include "IniIndex.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Cabeçalho do journal, gravado uma única vez no início do arquivo. Os campos são gravados na ordem de bytes nativa, como no snapshot binário.
+struct ConfigJournalHeader
+{
+    char magic[4]; // Identificador do formato: "CFGJ".
+    std::uint16_t version; // Versão do formato (CONFIG_JOURNAL_VERSION).
+    std::uint16_t headerSize; // Tamanho deste cabeçalho, em bytes.
+    std::uint32_t byteOrder; // Marca de ordem de bytes (0x01020304).
+    std::uint32_t reserved; // Reservado para versões futuras; gravado como zero.
+};
+
+// Cabeçalho de um registro do journal. Os textos da seção, da chave e do valor seguem o cabeçalho, nessa ordem e sem terminadores.
+struct ConfigJournalRecordHeader
+{
+    std::uint64_t checksum; // Hash FNV-1a de 64 bits dos campos seguintes do cabeçalho e dos textos. Um registro gravado pela metade (queda de energia durante a gravação) não confere e encerra a leitura.
+    std::uint16_t sectionSize; // Tamanho do nome da seção.
+    std::uint16_t keySize; // Tamanho do nome da chave.
+    std::uint32_t valueSize; // Tamanho do valor.
+};
+
+inline constexpr std::uint16_t CONFIG_JOURNAL_VERSION = 1; // Versão atual do formato. Deve ser incrementada a cada mudança de layout.
+
+// Alteração de uma chave, lida ou gravada no journal. Os campos são visões de um buffer do chamador (ou, na leitura, do arquivo mapeado).
+struct JournalRecord
+{
+    std::string_view section; // Nome da seção (por exemplo, "UART3").
+    std::string_view key; // Nome da chave.
+    std::string_view value; // Novo valor textual.
+};
+
+// Estado do journal, para monitoramento.
+struct JournalStats
+{
+    std::uint64_t records = 0; // Registros no journal, ainda não incorporados ao arquivo base.
+    std::uint64_t bytes = 0; // Tamanho do journal, em bytes, com o cabeçalho.
+    std::uint64_t compactions = 0; // Compactações concluídas desde a abertura.
+    std::optional<ErrorCode> lastCompactionError; // Erro da última compactação, ou std::nullopt se ela foi concluída.
+};
+
+std::string journalPathFor(const std::string& configPath); // Retorna o caminho do journal de um arquivo de configuração (o mesmo caminho, com ".journal" acrescentado).
+
+// Classe ConfigJournal, que mantém o journal de um arquivo de configuração INI. Cada append grava um único registro no final do arquivo e só retorna depois que ele chega ao armazenamento (fdatasync), de modo que uma alteração confirmada sobrevive a uma queda de energia; um registro incompleto no final do arquivo é descartado na abertura seguinte. A compactação reescreve o arquivo base com as alterações (arquivo temporário, fsync e renomeação atômica) e só então remove do journal os registros incorporados; como reaplicar uma alteração já incorporada não muda nada, uma interrupção entre as duas etapas não perde nem duplica alterações. Os métodos podem ser chamados por várias threads ao mesmo tempo.
+class ConfigJournal
+{
+private:
+    // Alteração já incorporada ao arquivo base por uma compactação, com cópias próprias dos textos. As entradas de m_compactedIndex apontam para estes textos.
+    struct CompactedEdit
+    {
+        std::string section; // Nome da seção.
+        std::string key; // Nome da chave.
+        std::string value; // Valor mais recente incorporado.
+        std::uint64_t generation = 0; // Geração do arquivo base que passou a conter o valor.
+    };
+
+    std::string m_configPath; // Caminho do arquivo de configuração base.
+    std::string m_journalPath; // Caminho do journal.
+    std::size_t m_compactionThreshold; // Quantidade de registros que dispara uma compactação em segundo plano (zero desliga a compactação automática).
+    mutable std::mutex m_mutex; // Protege o descritor e os contadores abaixo. As gravações do journal são feitas sob este mutex.
+    int m_fd = -1; // Descritor do journal, aberto para acréscimos (somente em sistemas POSIX; nas demais plataformas, cada gravação abre o arquivo).
+    std::uint64_t m_size = 0; // Tamanho do journal, em bytes, até o último registro confirmado.
+    std::uint64_t m_records = 0; // Registros no journal.
+    std::uint64_t m_compactAt = 0; // Quantidade de registros a partir da qual a thread de compactação é acordada.
+    std::uint64_t m_compactions = 0; // Compactações concluídas.
+    std::optional<ErrorCode> m_compactionError; // Erro da última compactação.
+    std::uint64_t m_generation = 0; // Geração do arquivo base: quantas vezes uma compactação o reescreveu e removeu do journal os registros incorporados.
+    std::list<CompactedEdit> m_compacted; // Valor mais recente de cada chave incorporada ao arquivo base. Uma std::list não move os elementos existentes ao crescer, por isso as visões guardadas no índice continuam válidas.
+    std::vector<CompactedEdit*> m_compactedByEntry; // Elemento de m_compacted de cada entrada de m_compactedIndex, na mesma posição.
+    IniIndex m_compactedIndex; // Índice (seção, chave) -> valor mais recente incorporado.
+    std::string m_buffer; // Buffer reaproveitado para montar cada registro antes da gravação.
+    std::mutex m_compactMutex; // Serializa as compactações (a automática e as pedidas por compact).
+    std::condition_variable_any m_wake; // Acorda a thread de compactação quando o limite de registros é atingido.
+    std::jthread m_compactor; // Thread de compactação em segundo plano. Declarada por último, para ser encerrada antes da destruição dos demais membros.
+
+    ConfigJournal(const std::string& configPath, std::size_t compactionThreshold); // Construtor usado por open.
+    std::expected<void, ErrorCode> openForAppend(std::uint64_t validSize); // Descarta o final inválido do journal (ou cria o journal com o cabeçalho) e o abre para acréscimos.
+    std::expected<void, ErrorCode> writeRecord(std::string_view bytes); // Grava um registro já montado no final do journal e o sincroniza com o armazenamento. Deve ser chamado sob m_mutex.
+    std::expected<void, ErrorCode> compactRecords(); // Etapas da compactação, chamadas por compact sob m_compactMutex.
+    void recordCompacted(const IniIndex& edits, std::uint64_t generation); // Guarda as alterações incorporadas ao arquivo base na geração indicada. Deve ser chamado sob m_mutex.
+    void run(std::stop_token stopToken); // Laço da thread de compactação.
+public:
+    static std::expected<std::unique_ptr<ConfigJournal>, ErrorCode> open(const std::string& configPath, std::size_t compactionThreshold = 1024); // Abre (ou cria) o journal de um arquivo de configuração, descartando um registro incompleto no final. Retorna INVALID_FORMAT se o arquivo existente não for um journal desta versão, ou FILE_OPEN_FAILED se ele não puder ser aberto para gravação.
+    ~ConfigJournal(); // Destrutor que encerra a thread de compactação (sem esperar o limite) e fecha o journal.
+
+    ConfigJournal(const ConfigJournal&) = delete; // A cópia é proibida, pois o descritor e a thread têm um único dono.
+    ConfigJournal& operator=(const ConfigJournal&) = delete; // A atribuição por cópia é proibida pelo mesmo motivo.
+
+    std::expected<void, ErrorCode> replay(const std::function<void(const JournalRecord& record)>& visit) const; // Lê os registros do journal, na ordem em que foram gravados. As visões do registro só valem durante a chamada de visit.
+    std::expected<void, ErrorCode> replaySince(std::uint64_t generation, const std::function<void(const JournalRecord& record)>& visit) const; // Lê as alterações que um parser do arquivo base na geração indicada não contém: as incorporadas por compactações posteriores, seguidas dos registros do journal.
+    std::uint64_t editsSince(std::uint64_t generation) const; // Retorna a quantidade de alterações que replaySince entregaria.
+    std::uint64_t generation() const; // Retorna a geração do arquivo base, que deve ser lida antes da leitura do arquivo por um parser.
+    std::expected<void, ErrorCode> append(const JournalRecord& record); // Acrescenta uma alteração ao journal e espera a sua gravação no armazenamento. Retorna PARSE_ERROR se algum texto exceder os limites do formato, ou FILE_OPEN_FAILED se a gravação falhar (nesse caso, o journal não muda).
+    std::expected<void, ErrorCode> compact(); // Incorpora ao arquivo base os registros gravados até o momento e os remove do journal. Retorna INVALID_FORMAT se o arquivo base não for INI, ou FILE_OPEN_FAILED se alguma gravação falhar (o journal continua válido).
+    JournalStats stats() const; // Retorna o estado do journal.
+    const std::string& path() const { return m_journalPath; } // Retorna o caminho do journal.
+};
+
+// Classe JournaledParser, que implementa a interface IConfigParser sobrepondo alterações pontuais a um parser base (INI, JSON, snapshot binário, ...). As seções sem alterações são entregues pelo parser base; nas demais, a configuração do parser base recebe os valores alterados, campo a campo, com a conversão e os validadores do esquema (updateField). Se a configuração do parser base for inválida ou não existir, ela é montada por bindConfig, com os valores alterados e as chaves do parser base. O parser é montado por uma única thread e, depois disso, pode ser consultado por várias threads ao mesmo tempo.
+class JournaledParser : public IConfigParser
+{
+private:
+    // Alteração guardada pelo parser, com cópias próprias dos textos. As entradas de m_edits apontam para estes textos.
+    struct Edit
+    {
+        std::pmr::string section; // Nome da seção.
+        std::pmr::string key; // Nome da chave.
+        std::pmr::string value; // Valor mais recente.
+    };
+
+    std::shared_ptr<const IConfigParser> m_base; // Parser com o conteúdo do arquivo base, compartilhado entre os parsers que sobrepõem alterações diferentes a ele.
+    std::pmr::list<Edit> m_storage; // Textos das alterações. Uma std::list não move os elementos existentes ao crescer, por isso as visões guardadas no índice continuam válidas.
+    std::pmr::vector<Edit*> m_storageByEntry; // Elemento de m_storage de cada entrada de m_edits, na mesma posição, usado para sobrescrever o valor de uma chave alterada mais de uma vez.
+    IniIndex m_edits; // Índice (seção, chave) -> valor mais recente de cada alteração.
+    std::pmr::vector<std::string_view> m_sectionNames; // Nomes das seções do parser base seguidos das seções que só existem nas alterações. Vazio enquanto todas as seções alteradas existirem no parser base.
+
+    template <typename T>
+    std::expected<T, ErrorCode> parseSection(std::string_view section) const; // Sobrepõe as alterações da seção à configuração do parser base.
+public:
+    explicit JournaledParser(std::shared_ptr<const IConfigParser> base, std::pmr::memory_resource* resource = std::pmr::get_default_resource()); // Construtor que recebe o parser base, sem nenhuma alteração. O recurso de memória recebe as alterações e deve viver mais que o parser.
+
+    void apply(std::string_view section, std::string_view key, std::string_view value); // Sobrepõe uma alteração, substituindo a anterior da mesma chave. Não valida o valor. Lança std::bad_alloc se o recurso de memória se esgotar; nesse caso, o parser deve ser descartado.
+    void applyEdits(const JournaledParser& other); // Sobrepõe todas as alterações de outro parser, na ordem em que foram feitas.
+    const std::shared_ptr<const IConfigParser>& base() const { return m_base; } // Retorna o parser base.
+    std::size_t editCount() const { return m_edits.size(); } // Retorna a quantidade de chaves alteradas.
+
+    std::expected<TcpConfig, ErrorCode> parseTcp() override; // Retorna a configuração da seção [TCP], com as alterações.
+    std::expected<UartConfig, ErrorCode> parseUart() override; // Retorna a configuração da seção [UART], com as alterações.
+    std::span<const std::string_view> sectionNames() const override; // Retorna os nomes das seções do parser base, seguidos das seções que só existem nas alterações.
+    std::expected<TcpConfig, ErrorCode> parseTcpSection(std::string_view section) const override; // Retorna a configuração TCP de uma seção específica, com as alterações.
+    std::expected<UartConfig, ErrorCode> parseUartSection(std::string_view section) const override; // Retorna a configuração UART de uma seção específica, com as alterações.
+    std::optional<std::string_view> findValue(std::string_view section, std::string_view key) const override; // Retorna o valor alterado de uma chave ou, se ela não foi alterada, o valor do parser base.
+    LoadMetrics loadMetrics() const override { return m_base->loadMetrics(); } // Retorna as medidas da carga do parser base.
+    SourceLocation locate(std::string_view section, std::string_view key) const override { return m_base->locate(section, key); } // Retorna a posição da chave no arquivo base.
+};
+
+#endif
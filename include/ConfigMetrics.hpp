@@ -0,0 +1,174 @@
+/*
+ * ConfigMetrics.hpp
+ *
+ * Definição da instrumentação da carga e das consultas de configuração: tempos de cada fase da carga, bytes e linhas processados, pico de memória, contagem das chamadas aos getters e a localização (arquivo, linha, coluna e chave) do primeiro erro. A coleta é desligada por padrão e custa apenas a leitura relaxada de um flag atômico; compilada com CONFIG_MANAGER_NO_METRICS, ela desaparece por completo.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef CONFIG_METRICS_HPP
+#define CONFIG_METRICS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory_resource>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "error-handler.hpp"
+/*----------------------------------------------------------------------------*/
+
+#ifdef CONFIG_MANAGER_NO_METRICS
+constexpr bool configMetricsEnabled() { return false; } // A instrumentação foi removida na compilação; todos os trechos de coleta são eliminados pelo compilador.
+inline void setConfigMetricsEnabled(bool enabled) { (void)enabled; } // Não tem efeito.
+#else
+extern std::atomic<bool> g_configMetricsEnabled; // Flag global da coleta, desligado por padrão.
+
+inline bool configMetricsEnabled() { return g_configMetricsEnabled.load(std::memory_order_relaxed); } // Retorna true se a coleta estiver ligada. A leitura relaxada não impõe nenhuma ordem de memória.
+inline void setConfigMetricsEnabled(bool enabled) { g_configMetricsEnabled.store(enabled, std::memory_order_relaxed); } // Liga ou desliga a coleta para as cargas e consultas seguintes.
+#endif
+
+using MetricsClock = std::chrono::steady_clock; // Relógio monotônico das fases da carga.
+
+// Posição de um trecho em um arquivo de configuração. Linha e coluna começam em 1; zero indica que a posição não é conhecida (por exemplo, uma chave ausente em uma seção que também não existe).
+struct SourceLocation
+{
+    std::string file; // Caminho do arquivo.
+    std::size_t line = 0; // Linha.
+    std::size_t column = 0; // Coluna, em bytes.
+};
+
+// Descrição de uma configuração rejeitada: o código de erro, a seção e a primeira chave ausente ou inválida, com a sua posição no arquivo.
+struct ErrorReport
+{
+    ErrorCode code = ErrorCode::UNKNOWN_ERROR; // Código retornado pela configuração.
+    std::string section; // Seção da configuração (por exemplo, "UART3").
+    std::string key; // Primeira chave ausente ou inválida, na ordem do esquema, ou vazio se o erro não for de uma chave (por exemplo, OUT_OF_MEMORY).
+    SourceLocation location; // Posição do valor inválido ou, para uma chave ausente, do cabeçalho da seção.
+};
+
+// Medidas de uma carga. Os tempos são em nanossegundos; as fases que não se aplicam a um backend ficam em zero.
+struct LoadMetrics
+{
+    std::uint64_t ioNs = 0; // Abertura e mapeamento (ou leitura) do arquivo.
+    std::uint64_t tokenizeNs = 0; // Tokenização do texto e construção do índice (seção, chave) -> valor.
+    std::uint64_t validationNs = 0; // Preenchimento e validação das configurações pelos esquemas, inclusive das seções numeradas.
+    std::uint64_t bindingNs = 0; // Resolução das chaves registradas com intern e montagem do snapshot.
+    std::uint64_t bytes = 0; // Bytes do arquivo.
+    std::uint64_t lines = 0; // Linhas do arquivo.
+    std::uint64_t peakMemoryBytes = 0; // Pico da memória pedida pelo parser ao seu recurso de memória (índice e caminho), sem contar o arquivo mapeado.
+};
+
+// Contagem das chamadas aos acessores do ConfigurationManager.
+struct AccessMetrics
+{
+    std::uint64_t tcpConfig = 0; // Chamadas a get_tcp_config.
+    std::uint64_t uartConfig = 0; // Chamadas a get_uart_config.
+    std::uint64_t allTcpConfigs = 0; // Chamadas a get_all_tcp_configs.
+    std::uint64_t allUartConfigs = 0; // Chamadas a get_all_uart_configs.
+    std::uint64_t snapshot = 0; // Chamadas a get_snapshot.
+    std::uint64_t byName = 0; // Chamadas a get<T>(section, key), que consultam o parser e convertem o valor a cada leitura.
+    std::uint64_t byHandle = 0; // Chamadas a get(KeyHandle<T>), atendidas pelo valor já convertido no snapshot.
+
+    double handleReadRatio() const { return byName + byHandle == 0 ? 0.0 : static_cast<double>(byHandle) / static_cast<double>(byName + byHandle); } // Fração das leituras de chaves avulsas feitas por identificador (byHandle / (byName + byHandle)). Mede o uso dos identificadores pelo código cliente, não acertos de um cache.
+};
+
+// Contadores atômicos de AccessMetrics, incrementados pelos getters. Cada contador ocupa a sua própria linha de cache, para que threads que chamam getters diferentes não disputem a mesma linha.
+struct AccessCounters
+{
+    // Contador alinhado a uma linha de cache.
+    struct alignas(64) Counter
+    {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    Counter tcpConfig; // Chamadas a get_tcp_config.
+    Counter uartConfig; // Chamadas a get_uart_config.
+    Counter allTcpConfigs; // Chamadas a get_all_tcp_configs.
+    Counter allUartConfigs; // Chamadas a get_all_uart_configs.
+    Counter snapshot; // Chamadas a get_snapshot.
+    Counter byName; // Chamadas a get<T>(section, key).
+    Counter byHandle; // Chamadas a get(KeyHandle<T>).
+
+    static void count(Counter& counter) // Incrementa um contador se a coleta estiver ligada. Com a coleta desligada, o custo é uma leitura relaxada do flag.
+    {
+        if (configMetricsEnabled())
+        {
+            counter.value.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    AccessMetrics read() const; // Retorna os valores correntes dos contadores.
+};
+
+// Resultado completo da instrumentação de um ConfigurationManager.
+struct ConfigMetrics
+{
+    bool enabled = false; // Indica se a coleta estava ligada quando as medidas foram lidas.
+    std::uint64_t loads = 0; // Cargas medidas (construção e reloads).
+    std::uint64_t rejectedLoads = 0; // Reloads medidos que foram rejeitados.
+    LoadMetrics lastLoad; // Medidas da última carga medida, aceita ou rejeitada.
+    std::optional<ErrorReport> lastError; // Primeira configuração inválida da última carga medida, na ordem em que reload as verifica, ou std::nullopt se ela era válida.
+    AccessMetrics access; // Chamadas aos acessores desde a construção.
+};
+
+// Recurso de memória que repassa os pedidos a outro recurso e contabiliza a memória em uso e o seu pico. Não é seguro para uso por várias threads ao mesmo tempo; os parsers o usam somente durante a construção e a destruição.
+class CountingResource : public std::pmr::memory_resource
+{
+private:
+    std::pmr::memory_resource* m_upstream; // Recurso que atende os pedidos.
+    bool m_counting; // Indica se a contabilização está ligada (definido na construção).
+    std::uint64_t m_current = 0; // Bytes em uso.
+    std::uint64_t m_peak = 0; // Maior valor de m_current.
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        void* block = m_upstream->allocate(bytes, alignment);
+        if (m_counting)
+        {
+            m_current += bytes;
+            m_peak = std::max(m_peak, m_current);
+        }
+        return block;
+    }
+    void do_deallocate(void* block, std::size_t bytes, std::size_t alignment) override
+    {
+        m_upstream->deallocate(block, bytes, alignment);
+        if (m_counting)
+        {
+            m_current -= bytes;
+        }
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+public:
+    CountingResource(std::pmr::memory_resource* upstream, bool counting) : m_upstream(upstream), m_counting(counting) {} // Construtor que recebe o recurso de destino e se a contabilização deve ser feita.
+    CountingResource(const CountingResource&) = delete; // Os contêineres guardam o endereço do recurso; ele não pode ser copiado.
+    CountingResource& operator=(const CountingResource&) = delete;
+
+    std::uint64_t peak() const { return m_peak; } // Retorna o pico da memória em uso, em bytes (zero se a contabilização estiver desligada).
+};
+
+/**
+******************************************************************************
+* @brief   : Retorna o tempo decorrido desde um instante, em nanossegundos.
+******************************************************************************.
+* @param: start - O instante inicial.
+* @return: std::uint64_t - O tempo decorrido.
+******************************************************************************
+*/
+inline std::uint64_t metricsElapsedNs(MetricsClock::time_point start)
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(MetricsClock::now() - start).count());
+}
+
+void writeJsonString(std::ostream& output, std::string_view text); // Grava um texto como uma string JSON, entre aspas e com os caracteres de escape necessários. Usada também pelo benchmark.
+std::string formatMetricsJson(const ConfigMetrics& metrics); // Formata as medidas como um objeto JSON.
+std::expected<void, ErrorCode> writeMetricsFile(const ConfigMetrics& metrics, const std::string& filePath); // Grava as medidas em JSON por meio de um arquivo temporário e de uma renomeação, de modo que um leitor nunca veja um arquivo pela metade. Retorna FILE_OPEN_FAILED se o arquivo não puder ser gravado.
+
+#endif
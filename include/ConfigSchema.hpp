@@ -0,0 +1,296 @@
+/*
+ * ConfigSchema.hpp
+ *
+ * Definição do mecanismo de esquemas das estruturas de configuração. Cada estrutura (TcpConfig, UartConfig, ...) declara uma única vez, em tempo de compilação, a sua seção, as suas chaves, os tipos dos campos e os validadores. A função bindConfig gera, a partir dessa declaração, o preenchimento e a validação da estrutura em uma única passagem, sem alocações intermediárias, usando std::from_chars para os campos numéricos.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef CONFIG_SCHEMA_HPP
+#define CONFIG_SCHEMA_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "IConfigParser.hpp"
+#include "error-handler.hpp"
+/*----------------------------------------------------------------------------*/
+
+inline constexpr std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull; // Valor inicial (offset basis) do FNV-1a de 64 bits, usado nos hashes de conteúdo das configurações.
+
+constexpr std::uint64_t hashMix(std::uint64_t seed, std::uint64_t value) // Mistura os 8 bytes de um inteiro em um hash FNV-1a, do byte menos significativo para o mais significativo.
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        seed = (seed ^ ((value >> (8 * i)) & 0xFF)) * 1099511628211ull;
+    }
+    return seed;
+}
+
+// Estrutura que descreve a conversão de um valor textual para o tipo de um campo. A especialização define o tipo intermediário (parsed_type), que é o que os validadores recebem, a função parse e a função hash, que mistura o valor do campo no hash de conteúdo da configuração. Para acrescentar um novo tipo de campo basta especializar esta estrutura.
+template <typename Member>
+struct FieldTraits;
+
+// Conversão de campos inteiros: o valor deve ser composto apenas por dígitos (sem sinal, sem espaços) e caber no tipo do campo.
+template <>
+struct FieldTraits<int>
+{
+    using parsed_type = int; // Os validadores recebem o valor já convertido.
+
+    static constexpr std::optional<int> parse(std::string_view text) // Converte o texto com std::from_chars, sem alocações.
+    {
+        if (text.empty() || text.front() < '0' || text.front() > '9') // Rejeita valores vazios e valores com sinal, como o teste de dígitos original.
+        {
+            return std::nullopt;
+        }
+        int value = 0; // Valor convertido.
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value); // Converte os dígitos, detectando estouro do tipo int.
+        if (error != std::errc{} || end != text.data() + text.size()) // O texto inteiro deve ser consumido e o valor deve caber em um int.
+        {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    static void assign(int& member, int value) { member = value; } // Armazena o valor convertido no campo.
+    static constexpr std::uint64_t hash(std::uint64_t seed, int member) { return hashMix(seed, static_cast<std::uint64_t>(static_cast<std::int64_t>(member))); } // Mistura o valor do campo no hash.
+};
+
+// Conversão de campos de texto: qualquer valor é aceito pela conversão, e as restrições ficam a cargo dos validadores. O texto só é copiado para o campo depois de validado.
+template <>
+struct FieldTraits<std::string>
+{
+    using parsed_type = std::string_view; // Os validadores recebem a visão do texto original, sem cópia.
+
+    static constexpr std::optional<std::string_view> parse(std::string_view text) { return text; } // Não há conversão: o texto é repassado como está.
+    static void assign(std::string& member, std::string_view value) { member.assign(value); } // Copia o texto para o campo (strings curtas não alocam, graças à otimização de strings pequenas).
+    static constexpr std::uint64_t hash(std::uint64_t seed, const std::string& member) // Mistura o comprimento e os bytes do texto no hash; o comprimento evita que ("ab", "c") e ("a", "bc") se confundam.
+    {
+        seed = hashMix(seed, member.size());
+        for (char c : member)
+        {
+            seed = (seed ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+        return seed;
+    }
+};
+
+// Estrutura que descreve um campo de uma estrutura de configuração: a chave no arquivo, o ponteiro para o membro e um validador opcional, aplicado ao valor já convertido.
+template <typename Struct, typename Member>
+struct FieldDescriptor
+{
+    using parsed_type = typename FieldTraits<Member>::parsed_type; // Tipo recebido pelo validador.
+
+    std::string_view key; // Nome da chave no arquivo de configuração (por exemplo, "port").
+    Member Struct::* member; // Ponteiro para o membro da estrutura que recebe o valor.
+    bool (*validate)(parsed_type); // Validador do valor convertido, ou nullptr quando qualquer valor convertido é aceito.
+};
+
+// Função auxiliar para declarar um campo, deduzindo a estrutura e o tipo do membro a partir do ponteiro para membro.
+template <typename Struct, typename Member>
+constexpr FieldDescriptor<Struct, Member> field(std::string_view key, Member Struct::* member, bool (*validate)(typename FieldTraits<Member>::parsed_type) = nullptr)
+{
+    return FieldDescriptor<Struct, Member>{key, member, validate};
+}
+
+// Validadores reutilizáveis pelos esquemas.
+constexpr bool isNotEmpty(std::string_view value) { return !value.empty(); } // Aceita qualquer texto não vazio.
+
+constexpr bool isTransportProtocol(std::string_view value) { return value == "TCP" || value == "UDP"; } // Aceita somente os protocolos "TCP" e "UDP".
+
+template <int Min, int Max>
+constexpr bool isInRange(int value) { return value >= Min && value <= Max; } // Aceita inteiros no intervalo fechado [Min, Max].
+
+// Esquema de uma estrutura de configuração. Cada estrutura deve especializar este template com a sua seção (section) e a tupla dos seus campos (fields).
+template <typename T>
+struct ConfigSchema;
+
+// Esquema da configuração TCP, lida da seção [TCP].
+template <>
+struct ConfigSchema<TcpConfig>
+{
+    static constexpr std::string_view section = "TCP"; // Seção do arquivo que contém os campos.
+    static constexpr auto fields = std::make_tuple(
+        field("ip", &TcpConfig::ip, isNotEmpty), // O endereço IP não pode ser vazio.
+        field("port", &TcpConfig::port, isInRange<0, 65535>), // A porta deve caber em 16 bits.
+        field("protocol", &TcpConfig::protocol, isTransportProtocol) // O protocolo deve ser "TCP" ou "UDP".
+    );
+};
+
+// Esquema da configuração UART, lida da seção [UART].
+template <>
+struct ConfigSchema<UartConfig>
+{
+    static constexpr std::string_view section = "UART"; // Seção do arquivo que contém os campos.
+    static constexpr auto fields = std::make_tuple(
+        field("baudrate", &UartConfig::baudrate), // Qualquer inteiro não negativo.
+        field("data_bits", &UartConfig::data_bits), // Qualquer inteiro não negativo.
+        field("parity", &UartConfig::parity, isNotEmpty), // A paridade não pode ser vazia.
+        field("stop_bits", &UartConfig::stop_bits) // Qualquer inteiro não negativo.
+    );
+};
+
+/**
+******************************************************************************
+* @brief   : Converte, valida e armazena um único campo de uma estrutura de configuração.
+******************************************************************************.
+* @param: config - A estrutura que recebe o valor.
+* @param: descriptor - O descritor do campo.
+* @param: lookup - Função que recebe o nome da chave e retorna o seu valor textual, ou std::nullopt se a chave não existir.
+* @return: bool - Retorna true se a chave existir, a conversão for bem-sucedida e o validador aceitar o valor.
+******************************************************************************
+*/
+template <typename Struct, typename Member, typename Lookup>
+constexpr bool bindField(Struct& config, const FieldDescriptor<Struct, Member>& descriptor, Lookup& lookup)
+{
+    std::optional<std::string_view> text = lookup(descriptor.key); // Consulta o valor textual da chave.
+    if (!text) // A chave é obrigatória.
+    {
+        return false;
+    }
+    auto value = FieldTraits<Member>::parse(*text); // Converte o texto para o tipo intermediário do campo.
+    if (!value || (descriptor.validate != nullptr && !descriptor.validate(*value))) // A conversão deve ser bem-sucedida e o validador, se existir, deve aceitar o valor.
+    {
+        return false;
+    }
+    FieldTraits<Member>::assign(config.*descriptor.member, *value); // Armazena o valor no campo da estrutura.
+    return true;
+}
+
+/**
+******************************************************************************
+* @brief   : Converte o valor textual de uma chave avulsa, fora de um esquema, para o tipo intermediário de um campo.
+* @details : Usa as mesmas regras de conversão de FieldTraits que bindConfig, mas sem validadores: a chave não pertence necessariamente a um esquema. É a base dos acessores genéricos do ConfigurationManager.
+******************************************************************************.
+* @param: text - O valor textual da chave, ou std::nullopt se a chave não existir.
+* @return: std::expected<typename FieldTraits<T>::parsed_type, ErrorCode> - O valor convertido, ou PARSE_ERROR se a chave estiver faltando ou a conversão falhar.
+******************************************************************************
+*/
+template <typename T>
+constexpr std::expected<typename FieldTraits<T>::parsed_type, ErrorCode> convertValue(std::optional<std::string_view> text)
+{
+    if (!text) // A chave é obrigatória.
+    {
+        return std::unexpected(ErrorCode::PARSE_ERROR);
+    }
+    auto value = FieldTraits<T>::parse(*text); // Converte o texto para o tipo intermediário.
+    if (!value)
+    {
+        return std::unexpected(ErrorCode::PARSE_ERROR);
+    }
+    return *value;
+}
+
+/**
+******************************************************************************
+* @brief   : Preenche e valida uma estrutura de configuração a partir do seu esquema.
+* @details : Os campos declarados em ConfigSchema<T>::fields são percorridos uma única vez, em ordem, consultando cada chave com a função lookup. A passagem é interrompida no primeiro campo ausente ou inválido. Esta função é compartilhada por todos os backends de IConfigParser: cada backend só precisa fornecer a função de consulta.
+******************************************************************************.
+* @param: lookup - Função que recebe o nome da chave (std::string_view) e retorna o seu valor textual (std::optional<std::string_view>) na seção ConfigSchema<T>::section.
+* @return: std::expected<T, ErrorCode> - Retorna a estrutura preenchida ou ErrorCode::PARSE_ERROR se algum campo estiver faltando ou for inválido.
+******************************************************************************
+*/
+template <typename T, typename Lookup>
+std::expected<T, ErrorCode> bindConfig(Lookup&& lookup)
+{
+    T config{}; // Estrutura a ser preenchida.
+    bool valid = std::apply([&](const auto&... descriptors) { return (bindField(config, descriptors, lookup) && ...); }, ConfigSchema<T>::fields); // Percorre os campos do esquema em ordem, parando no primeiro erro.
+    if (!valid) // Se algum campo estiver faltando ou for inválido, retorna um código de erro de parsing.
+    {
+        return std::unexpected(ErrorCode::PARSE_ERROR);
+    }
+    return config;
+}
+
+/**
+******************************************************************************
+* @brief   : Substitui um único campo de uma configuração já preenchida, a partir do seu valor textual.
+* @details : O campo é localizado pela chave em ConfigSchema<T>::fields e passa pela mesma conversão e pelo mesmo validador de bindConfig. Como os validadores examinam um campo por vez, uma configuração válida continua válida depois da substituição. É a base das alterações gravadas no journal (ConfigJournal.hpp).
+******************************************************************************.
+* @param: config - A configuração a ser alterada. Não é modificada em caso de erro.
+* @param: key - O nome da chave.
+* @param: text - O novo valor textual.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou PARSE_ERROR se a chave não pertencer ao esquema ou o valor for inválido.
+******************************************************************************
+*/
+template <typename T>
+constexpr std::expected<void, ErrorCode> updateField(T& config, std::string_view key, std::string_view text)
+{
+    auto lookup = [text](std::string_view) -> std::optional<std::string_view> { return text; }; // O valor vale para a única chave consultada.
+    bool found = false; // Indica se a chave pertence ao esquema.
+    bool valid = false; // Indica se o valor foi aceito.
+    std::apply([&](const auto&... descriptors) { ((descriptors.key == key && !found ? (found = true, valid = bindField(config, descriptors, lookup)) : false), ...); }, ConfigSchema<T>::fields);
+    if (!valid)
+    {
+        return std::unexpected(ErrorCode::PARSE_ERROR);
+    }
+    return {};
+}
+
+/**
+******************************************************************************
+* @brief   : Calcula o hash de conteúdo de uma configuração validada, ou do seu código de erro.
+* @details : Os campos de ConfigSchema<T>::fields são misturados em ordem, cada um pela função hash do seu FieldTraits. Duas configurações com os mesmos valores têm sempre o mesmo hash, independentemente do arquivo ou do backend de onde vieram; é o que permite comparar snapshots seção a seção sem comparar os campos das seções que não mudaram.
+******************************************************************************.
+* @param: config - A configuração, ou o seu código de erro.
+* @return: std::uint64_t - O hash. Uma configuração inválida tem um hash derivado somente do código de erro.
+******************************************************************************
+*/
+template <typename T>
+constexpr std::uint64_t hashConfig(const std::expected<T, ErrorCode>& config)
+{
+    if (!config) // O erro é marcado para não coincidir com o hash de uma configuração válida.
+    {
+        return hashMix(hashMix(FNV_OFFSET_BASIS, 1), static_cast<std::uint64_t>(config.error()));
+    }
+    std::uint64_t seed = hashMix(FNV_OFFSET_BASIS, 0);
+    std::apply([&](const auto&... descriptors) { ((seed = FieldTraits<std::remove_cvref_t<decltype((*config).*descriptors.member)>>::hash(seed, (*config).*descriptors.member)), ...); }, ConfigSchema<T>::fields);
+    return seed;
+}
+
+/**
+******************************************************************************
+* @brief   : Compara duas configurações válidas campo a campo.
+******************************************************************************.
+* @param: before - A configuração anterior.
+* @param: after - A configuração nova.
+* @return: std::uint64_t - Uma máscara com o bit i ligado se o i-ésimo campo de ConfigSchema<T>::fields mudou; zero se todos os campos são iguais.
+******************************************************************************
+*/
+template <typename T>
+constexpr std::uint64_t changedFields(const T& before, const T& after)
+{
+    static_assert(std::tuple_size_v<decltype(ConfigSchema<T>::fields)> <= 64, "A máscara de campos comporta até 64 campos.");
+    std::uint64_t mask = 0;
+    std::size_t index = 0;
+    std::apply([&](const auto&... descriptors) { ((mask |= (before.*descriptors.member != after.*descriptors.member ? std::uint64_t{1} << index : 0), ++index), ...); }, ConfigSchema<T>::fields);
+    return mask;
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a chave do i-ésimo campo do esquema.
+******************************************************************************.
+* @param: index - A posição do campo em ConfigSchema<T>::fields.
+* @return: std::string_view - O nome da chave, ou vazio se index estiver fora do esquema.
+******************************************************************************
+*/
+template <typename T>
+constexpr std::string_view fieldKey(std::size_t index)
+{
+    std::string_view key;
+    std::size_t current = 0;
+    std::apply([&](const auto&... descriptors) { ((key = current++ == index ? descriptors.key : key), ...); }, ConfigSchema<T>::fields);
+    return key;
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * ConfigSnapshot.hpp
+ *
+ * Definição do snapshot imutável das configurações validadas, compartilhado pelo ConfigurationManager com os leitores, e das estruturas que o compõem.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef CONFIG_SNAPSHOT_HPP
+#define CONFIG_SNAPSHOT_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include "IConfigParser.hpp"
+#include "error-handler.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Estrutura que representa uma instância de uma configuração declarada em uma seção numerada (por exemplo, [UART3]), com o resultado da sua validação.
+template <typename T>
+struct ConfigInstance
+{
+    std::pmr::string section; // Nome da seção de origem (por exemplo, "UART3"), guardado no recurso de memória do gerenciador.
+    std::expected<T, ErrorCode> config; // Configuração validada, ou o código de erro da instância.
+    std::uint64_t hash = 0; // Hash de conteúdo de config (hashConfig), calculado na validação. Permite comparar snapshots sem comparar os campos das instâncias que não mudaram.
+};
+
+// Valor de uma chave avulsa já convertido, guardado no snapshot. Cada alternativa é o tipo intermediário (FieldTraits<T>::parsed_type) de um tipo aceito por get<T>: int ou std::string. Os textos são visões do conteúdo do parser do snapshot, por isso não alocam.
+using KeyValue = std::variant<std::expected<int, ErrorCode>, std::expected<std::string_view, ErrorCode>>;
+
+// Identificador de uma chave (seção, chave) já resolvida por ConfigurationManager::intern. A leitura por meio dele é um acesso direto a ConfigSnapshot::values, sem hash nem comparação de textos. Ele continua válido depois de um reload, mas só tem significado para o gerenciador que o criou.
+template <typename T>
+struct KeyHandle
+{
+    std::uint32_t slot; // Posição do valor em ConfigSnapshot::values.
+};
+
+// Estrutura que guarda o resultado já validado de cada configuração, incluindo os erros. Ela é construída uma única vez e nunca é alterada depois de publicada, por isso pode ser compartilhada livremente entre os chamadores.
+struct ConfigSnapshot
+{
+    std::expected<TcpConfig, ErrorCode> tcp; // Configuração TCP validada, ou o código de erro retornado pelo parser.
+    std::expected<UartConfig, ErrorCode> uart; // Configuração UART validada, ou o código de erro retornado pelo parser.
+    std::pmr::vector<ConfigInstance<TcpConfig>> tcpInstances; // Instâncias TCP declaradas nas seções [TCP0], [TCP1], ..., em ordem numérica crescente.
+    std::pmr::vector<ConfigInstance<UartConfig>> uartInstances; // Instâncias UART declaradas nas seções [UART0], [UART1], ..., em ordem numérica crescente.
+    std::shared_ptr<const IConfigParser> parser; // Parser de onde vieram as configurações, consultado pelo acessor get<T>(section, key). Ele vive enquanto o snapshot viver, e as visões de values apontam para o seu conteúdo.
+    std::pmr::vector<KeyValue> values; // Valores das chaves registradas com intern, na ordem dos identificadores.
+};
+
+/**
+******************************************************************************
+* @brief   : Extrai o número de uma seção numerada, como "UART12" para o prefixo "UART".
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: prefix - O prefixo esperado (o nome da seção declarado no esquema, como "UART").
+* @return: std::optional<std::uint64_t> - O número da instância, ou std::nullopt se a seção não for o prefixo seguido apenas de dígitos.
+******************************************************************************
+*/
+inline std::optional<std::uint64_t> instanceNumber(std::string_view section, std::string_view prefix)
+{
+    if (section.size() <= prefix.size() || !section.starts_with(prefix)) // A seção precisa ter o prefixo e pelo menos um dígito.
+    {
+        return std::nullopt;
+    }
+    std::string_view digits = section.substr(prefix.size()); // Parte numérica da seção.
+    std::uint64_t number = 0;
+    auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), number); // Converte os dígitos, rejeitando sinais e espaços.
+    if (error != std::errc() || end != digits.data() + digits.size())
+    {
+        return std::nullopt;
+    }
+    return number;
+}
+
+#endif
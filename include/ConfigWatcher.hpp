@@ -0,0 +1,56 @@
+/*
+ * ConfigWatcher.hpp
+ *
+ * Definição da classe ConfigWatcher, responsável pelo modo opcional de recarga automática (hot reload). Ela observa o arquivo de configuração em uma thread de fundo (com inotify no Linux) e, a cada alteração, cria um novo parser e o entrega ao ConfigurationManager, que só publica a nova configuração se ela for válida.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef CONFIG_WATCHER_HPP
+#define CONFIG_WATCHER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include "ConfigurationManager.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Classe ConfigWatcher, que recarrega a configuração de um ConfigurationManager sempre que o arquivo observado for alterado. O arquivo é considerado alterado quando é fechado após uma escrita ou quando outro arquivo é renomeado para o seu nome (o padrão usado pelos editores e por gravações atômicas). A observação é registrada por start, antes do seu retorno: toda alteração feita depois disso gera uma recarga.
+class ConfigWatcher
+{
+public:
+    using ParserFactory = std::function<std::expected<std::unique_ptr<IConfigParser>, ErrorCode>(const std::string&)>; // Função que cria um parser a partir do caminho do arquivo, como a função createParser.
+private:
+    ConfigurationManager& m_manager; // Manager que recebe as novas configurações. Deve viver mais que o ConfigWatcher.
+    std::string m_filePath; // Caminho do arquivo observado.
+    ParserFactory m_factory; // Função usada para criar o parser a cada alteração.
+    std::atomic<std::uint64_t> m_reloadCount{0}; // Quantidade de recargas aceitas.
+    std::atomic<std::uint64_t> m_rejectedCount{0}; // Quantidade de recargas rejeitadas (arquivo inválido ou ilegível).
+    int m_fd = -1; // Descritor do inotify, com o diretório do arquivo já registrado (somente no Linux).
+    std::filesystem::file_time_type m_lastWrite{}; // Data de modificação conhecida do arquivo (somente nas demais plataformas, que consultam o arquivo periodicamente).
+    std::jthread m_thread; // Thread de fundo que observa o arquivo. Declarada por último para ser parada antes dos demais membros serem destruídos.
+
+    ConfigWatcher(ConfigurationManager& manager, std::string filePath, ParserFactory factory); // Construtor usado por start.
+    std::expected<void, ErrorCode> watch(); // Registra a observação do arquivo.
+    void run(std::stop_token stopToken); // Laço da thread de fundo.
+    void reload(); // Cria o parser e tenta publicar a nova configuração.
+public:
+    static std::expected<std::unique_ptr<ConfigWatcher>, ErrorCode> start(ConfigurationManager& manager, std::string filePath, ParserFactory factory); // Registra a observação do arquivo e inicia a thread de fundo. Retorna FILE_OPEN_FAILED se o arquivo não puder ser observado (por exemplo, sem inotify ou sem permissão no diretório).
+    ~ConfigWatcher(); // Destrutor que para a thread de fundo e libera a observação.
+
+    ConfigWatcher(const ConfigWatcher&) = delete; // O ConfigWatcher não pode ser copiado, pois possui uma thread.
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete; // A atribuição por cópia é proibida pelo mesmo motivo.
+
+    std::uint64_t reloadCount() const { return m_reloadCount.load(std::memory_order_relaxed); } // Retorna a quantidade de recargas aceitas.
+    std::uint64_t rejectedCount() const { return m_rejectedCount.load(std::memory_order_relaxed); } // Retorna a quantidade de recargas rejeitadas.
+};
+
+#endif
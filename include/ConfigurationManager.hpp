@@ -11,19 +11,228 @@
 #ifndef CONFIGURATION_MANAGER_HPP
 #define CONFIGURATION_MANAGER_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include "ConfigDiff.hpp"
+#include "ConfigJournal.hpp"
+#include "ConfigMetrics.hpp"
+#include "ConfigSchema.hpp"
+#include "ConfigSnapshot.hpp"
 #include "IConfigParser.hpp"
+#include "SnapshotCell.hpp"
+#include "ThreadPool.hpp"
 /*----------------------------------------------------------------------------*/
 
-// Classe ConfigurationManager, que é responsável por gerenciar a configuração do sistema, fornecendo uma interface para acessar os dados de configuração de forma segura e fácil de usar. Ela utiliza um parser (que implementa a interface IConfigParser) para ler os dados do arquivo de configuração e fornece métodos para acessar as configurações específicas, como TCP e UART.
+using SubscriptionId = std::uint64_t; // Identificador de uma assinatura de mudanças, usado para cancelá-la.
+using TcpChangeCallback = std::function<void(const ConfigChange<TcpConfig>& change)>; // Função chamada quando uma seção TCP assinada muda, com os valores anterior e novo.
+using UartChangeCallback = std::function<void(const ConfigChange<UartConfig>& change)>; // Função chamada quando uma seção UART assinada muda, com os valores anterior e novo.
+
+// Classe ConfigurationManager, que é responsável por gerenciar a configuração do sistema, fornecendo uma interface para acessar os dados de configuração de forma segura e fácil de usar. Ela utiliza um parser (que implementa a interface IConfigParser) para ler os dados do arquivo de configuração uma única vez e fornece métodos para acessar as configurações específicas, como TCP e UART, a partir de um snapshot imutável. Os getters podem ser chamados por várias threads ao mesmo tempo, inclusive durante um reload.
 class ConfigurationManager 
 {
 private:
-    std::unique_ptr<IConfigParser> m_parser; // Um ponteiro único para um objeto que implementa a interface IConfigParser, usado para ler os dados de configuração do arquivo. O uso de std::unique_ptr garante que o recurso seja gerenciado corretamente, evitando vazamentos de memória e garantindo a propriedade exclusiva do parser dentro da classe ConfigurationManager.
+    using KeyResolver = KeyValue (*)(const IConfigParser* parser, std::string_view section, std::string_view key); // Função que consulta e converte o valor de uma chave para o tipo de um identificador.
+
+    // Chave registrada por intern. O snapshot guarda, na mesma posição, o valor resolvido.
+    struct KeyBinding
+    {
+        std::pmr::string section; // Nome da seção.
+        std::pmr::string key; // Nome da chave.
+        KeyResolver resolve; // Conversão para o tipo pedido em intern.
+    };
+
+    // Assinatura das mudanças de uma seção. Somente um dos callbacks é definido, conforme o tipo da seção.
+    struct Subscription
+    {
+        SubscriptionId id; // Identificador retornado ao assinante.
+        std::string section; // Seção assinada (por exemplo, "TCP" ou "UART3").
+        TcpChangeCallback tcp; // Callback de uma seção TCP.
+        UartChangeCallback uart; // Callback de uma seção UART.
+    };
+
+    // Publicação de um snapshot, preparada antes da troca para que nada possa falhar depois dela.
+    struct PendingPublication
+    {
+        std::pmr::vector<std::shared_ptr<const Subscription>> subscriptions; // Cópia das assinaturas ativas.
+        ConfigDiff diff; // Mudanças em relação ao snapshot publicado, calculadas somente se houver assinantes.
+    };
+
+    std::pmr::memory_resource* m_resource; // Recurso de memória de onde vêm os snapshots e as listas de instâncias. Declarado antes de m_snapshot, pois é usado na sua construção.
+    ThreadPool m_pool; // Threads usadas para validar em paralelo as seções numeradas. Declarado antes de m_snapshot, pois é usado na sua construção.
+    std::pmr::vector<KeyBinding> m_bindings; // Chaves registradas com intern, na ordem dos identificadores. Só é acessado por quem detém m_reloadMutex.
+    mutable std::mutex m_metricsMutex; // Protege m_loadMetrics, escrito pelas cargas e lido por metrics.
+    ConfigMetrics m_loadMetrics; // Medidas das cargas (o campo access não é usado; os getters contam em m_counters). Declarado antes de m_snapshot, pois a primeira carga é medida na sua construção.
+    mutable AccessCounters m_counters; // Chamadas aos acessores, contadas somente com a instrumentação ligada.
+    SnapshotCell<ConfigSnapshot> m_snapshot; // Snapshot imutável com as configurações já validadas e com o parser de onde elas vieram. Os getters apenas leem este snapshot, sem adquirir locks; um reload publica um novo snapshot por inteiro, com uma troca atômica.
+    mutable std::mutex m_reloadMutex; // Serializa as chamadas a reload, intern, set e openJournal, que substituem o snapshot. Os leitores nunca o adquirem.
+    std::mutex m_subscriptionMutex; // Protege m_subscriptions e m_nextSubscription. Nunca é mantido durante a chamada de um callback.
+    std::pmr::vector<std::shared_ptr<const Subscription>> m_subscriptions; // Assinaturas ativas. Cada reload copia a lista, de modo que os callbacks podem assinar e cancelar assinaturas.
+    SubscriptionId m_nextSubscription = 1; // Próximo identificador de assinatura.
+    std::unique_ptr<ConfigJournal> m_journal; // Journal das alterações feitas com set, ou nullptr antes de openJournal. Só é acessado por quem detém m_reloadMutex.
+    std::shared_ptr<const JournaledParser> m_unjournaled; // Alterações feitas com set antes de openJournal, que não estão no journal e são sobrepostas a cada reload, sob as do journal, ou nullptr. Só é acessado por quem detém m_reloadMutex.
+    std::shared_ptr<const JournaledParser> m_journaled; // Parser do snapshot publicado quando há alterações (as alterações sobrepostas ao parser base), ou nullptr. Só é acessado por quem detém m_reloadMutex.
+
+    static std::shared_ptr<const ConfigSnapshot> buildSnapshot(std::unique_ptr<IConfigParser> parser, ThreadPool& pool, std::pmr::memory_resource* resource, std::span<const KeyBinding> bindings, LoadMetrics* metrics); // Consulta o parser uma única vez e monta o snapshot com os resultados (ou erros) de cada configuração e de cada chave registrada, validando as seções numeradas em paralelo. O snapshot passa a ser o dono do parser. Se metrics não for nulo, recebe as medidas da carga. Se o recurso de memória se esgotar, retorna um snapshot com OUT_OF_MEMORY em todas as configurações.
+    static std::optional<ErrorReport> firstFailure(const ConfigSnapshot& snapshot, bool describe); // Retorna a primeira configuração inválida do snapshot, na ordem em que reload as verifica, ou std::nullopt se ele puder ser publicado. Se describe for true, localiza também a seção, a chave e a posição do erro.
+    void recordLoad(const LoadMetrics& load, std::optional<ErrorReport> failure, bool rejected); // Guarda as medidas de uma carga.
+    std::expected<SubscriptionId, ErrorCode> addSubscription(std::string section, TcpChangeCallback tcp, UartChangeCallback uart); // Registra uma assinatura. Retorna OUT_OF_MEMORY se o recurso de memória se esgotou.
+    static void notify(const ConfigDiff& diff, std::span<const std::shared_ptr<const Subscription>> subscriptions); // Chama o callback de cada assinatura cuja seção mudou.
+    std::expected<PendingPublication, ErrorCode> preparePublication(const std::shared_ptr<const ConfigSnapshot>& snapshot); // Copia as assinaturas e compara o snapshot com o publicado. Retorna OUT_OF_MEMORY se o recurso de memória se esgotou. Deve ser chamado sob m_reloadMutex.
+    void publish(std::shared_ptr<const ConfigSnapshot> snapshot, const PendingPublication& publication); // Publica o snapshot com uma troca atômica e notifica os assinantes. Não falha. Deve ser chamado sob m_reloadMutex.
+    template <typename T>
+    std::expected<void, ErrorCode> setField(std::string_view section, std::string_view key, std::string_view value); // Valida, grava no journal e publica a alteração de um campo de uma seção do tipo T.
+    std::expected<std::uint32_t, ErrorCode> internKey(std::string_view section, std::string_view key, KeyResolver resolve); // Registra uma chave (ou reaproveita o registro existente) e publica um snapshot com o seu valor. Retorna a posição do valor.
+
+    template <typename T>
+    static std::expected<typename FieldTraits<T>::parsed_type, ErrorCode> convertKey(const IConfigParser* parser, std::string_view section, std::string_view key); // Consulta e converte o valor de uma chave no parser indicado.
+    template <typename T>
+    static KeyValue resolveKey(const IConfigParser* parser, std::string_view section, std::string_view key) { return convertKey<T>(parser, section, key); } // Versão de convertKey guardada em KeyBinding.
+    template <typename T>
+    static std::expected<T, ErrorCode> toValue(const std::expected<typename FieldTraits<T>::parsed_type, ErrorCode>& value); // Copia um valor convertido para o tipo pedido pelo chamador.
 public:
-    ConfigurationManager(std::unique_ptr<IConfigParser> parser); // Construtor que recebe um ponteiro único para um objeto que implementa a interface IConfigParser. O construtor é responsável por inicializar o membro m_parser com o parser fornecido, usando std::move para transferir a propriedade do parser para a classe ConfigurationManager. Isso garante que o parser seja gerenciado corretamente e evita cópias desnecessárias.
-    std::expected<TcpConfig, ErrorCode> get_tcp_config(); // Método para obter a configuração TCP. Ele chama o método parseTcp do parser para ler os dados de configuração TCP do arquivo e retorna um std::expected contendo a configuração TCP ou um código de erro, permitindo que o chamador lide com falhas.
-    std::expected<UartConfig, ErrorCode> get_uart_config(); // Método para obter a configuração UART, análogo ao método get_tcp_config.
+    ConfigurationManager(std::unique_ptr<IConfigParser> parser, unsigned threadCount = 1, std::pmr::memory_resource* resource = std::pmr::get_default_resource()); // Construtor que recebe um ponteiro único para um objeto que implementa a interface IConfigParser. O construtor transfere a propriedade do parser para a classe ConfigurationManager com std::move e monta o snapshot das configurações, de modo que o custo de interpretação e validação é pago uma única vez. O parâmetro threadCount define quantas threads validam as seções numeradas, na construção e em cada reload. O parâmetro resource define de onde vêm os snapshots (na construção e em cada reload); ele deve viver mais que o gerenciador e que os snapshots entregues aos chamadores, e aceitar liberações feitas por qualquer thread (um snapshot é liberado pela última thread que o usa).
+    std::expected<TcpConfig, ErrorCode> get_tcp_config() const; // Método para obter a configuração TCP. Ele retorna uma cópia do resultado memorizado no snapshot (a configuração TCP ou o código de erro), sem interpretar o arquivo novamente.
+    std::expected<UartConfig, ErrorCode> get_uart_config() const; // Método para obter a configuração UART, análogo ao método get_tcp_config.
+    std::shared_ptr<const std::pmr::vector<ConfigInstance<TcpConfig>>> get_all_tcp_configs() const; // Método para obter todas as instâncias TCP ([TCP0], [TCP1], ...) em um vetor contíguo, em ordem numérica, com o resultado de cada instância. Nenhuma cópia é feita.
+    std::shared_ptr<const std::pmr::vector<ConfigInstance<UartConfig>>> get_all_uart_configs() const; // Método para obter todas as instâncias UART ([UART0], [UART1], ...), análogo ao método get_all_tcp_configs.
+    std::shared_ptr<const ConfigSnapshot> get_snapshot() const; // Método para obter o snapshot completo sem nenhuma cópia. O std::shared_ptr mantém o snapshot válido enquanto o chamador o utilizar.
+    std::expected<void, ErrorCode> reload(std::unique_ptr<IConfigParser> parser, std::optional<std::uint64_t> generation = std::nullopt); // Método para substituir a configuração a partir de um novo parser. O novo snapshot só é publicado se todas as configurações (inclusive todas as instâncias numeradas) forem válidas; caso contrário, o último snapshot válido é mantido e o código de erro é retornado (OUT_OF_MEMORY se o recurso de memória se esgotou). Depois da publicação, os assinantes das seções que mudaram são notificados. As alterações feitas com set que o arquivo lido pelo parser não contém são sobrepostas a ele: as que ainda estão no journal e as incorporadas por compactações posteriores à geração generation (journalGeneration, lida antes da criação do parser; sem ela, o parser é considerado tão recente quanto a última compactação). Sem o journal, todas as alterações feitas com set são sobrepostas. Uma mudança do arquivo feita depois de uma compactação prevalece sobre as alterações incorporadas por ela.
+
+    std::expected<void, ErrorCode> openJournal(const std::string& configPath, std::size_t compactionThreshold = 1024); // Método para abrir o journal do arquivo de configuração (ConfigJournal.hpp) e reaplicar as alterações gravadas nele sobre o snapshot corrente. A partir daí, cada set é gravado no journal, e o journal é incorporado ao arquivo base em segundo plano a cada compactionThreshold alterações (zero desliga a compactação automática). Retorna o erro do journal, o erro da primeira configuração inválida depois da reaplicação (nesse caso, o journal não é aberto), ou UNKNOWN_ERROR se o journal já estiver aberto.
+    std::expected<void, ErrorCode> set(std::string_view section, std::string_view key, std::string_view value); // Método para alterar um campo de uma configuração ([TCP], [UART] ou uma instância numerada) em tempo de execução. O valor é validado pelo esquema, como na carga; se for aceito, é gravado no journal (quando aberto) e um novo snapshot é publicado, com a notificação dos assinantes. Retorna PARSE_ERROR para uma seção ou chave fora dos esquemas, um valor inválido ou com espaços nas extremidades ou quebras de linha, FILE_OPEN_FAILED se a gravação no journal falhar, ou OUT_OF_MEMORY. Sem journal, a alteração vale somente para o processo corrente.
+    std::expected<void, ErrorCode> set(std::string_view section, std::string_view key, int value); // Versão de set para campos inteiros.
+    std::expected<void, ErrorCode> compactJournal(); // Método para incorporar imediatamente o journal ao arquivo base (ConfigJournal::compact). Retorna UNKNOWN_ERROR se o journal não estiver aberto.
+    std::uint64_t journalGeneration() const; // Método para obter a geração do arquivo base (ConfigJournal::generation), ou zero se o journal não estiver aberto. Deve ser lida antes da criação de um parser entregue a reload.
+    std::optional<JournalStats> journalStats() const; // Método para obter o estado do journal, ou std::nullopt se ele não estiver aberto.
+
+    std::expected<SubscriptionId, ErrorCode> subscribeTcp(TcpChangeCallback callback); // Método para ser notificado quando a seção [TCP] mudar em um reload.
+    std::expected<SubscriptionId, ErrorCode> subscribeUart(UartChangeCallback callback); // Método para ser notificado quando a seção [UART] mudar em um reload.
+    std::expected<SubscriptionId, ErrorCode> subscribeTcpSection(std::string section, TcpChangeCallback callback); // Método para ser notificado quando uma seção TCP específica ([TCP] ou uma instância como [TCP3]) mudar, for acrescentada ou for removida em um reload.
+    std::expected<SubscriptionId, ErrorCode> subscribeUartSection(std::string section, UartChangeCallback callback); // Método para ser notificado quando uma seção UART específica mudar, análogo a subscribeTcpSection.
+    bool unsubscribe(SubscriptionId id); // Método para cancelar uma assinatura. Retorna false se ela não existir.
+
+    template <typename T>
+    std::expected<T, ErrorCode> get(std::string_view section, std::string_view key) const; // Método genérico para ler uma chave qualquer como int ou std::string. Consulta o parser do snapshot corrente a cada chamada; para leituras frequentes, use intern.
+    template <typename T>
+    std::expected<KeyHandle<T>, ErrorCode> intern(std::string_view section, std::string_view key); // Método para resolver uma chave uma única vez. O valor convertido passa a ser guardado em cada snapshot (inclusive nos publicados por reload), e a leitura por meio do identificador não consulta o parser. Chamadas repetidas com a mesma chave e o mesmo tipo retornam o mesmo identificador.
+    template <typename T>
+    std::expected<T, ErrorCode> get(KeyHandle<T> handle) const; // Método para ler o valor guardado de uma chave registrada com intern, sem hash nem comparação de textos.
+
+    ConfigMetrics metrics() const; // Método para obter as medidas da instrumentação (ConfigMetrics.hpp): tempos e tamanhos da última carga, o primeiro erro dela com arquivo, linha, coluna e chave, e as chamadas aos acessores. A coleta é ligada com setConfigMetricsEnabled(true).
+    std::expected<void, ErrorCode> writeMetrics(const std::string& filePath) const; // Método para gravar as medidas em JSON, de forma atômica, para coletores de monitoramento que leem um arquivo local.
 };
 
+/**
+******************************************************************************
+* @brief   : Consulta e converte o valor de uma chave no parser indicado.
+******************************************************************************.
+* @param: parser - O parser do snapshot, ou nullptr.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @return: std::expected<typename FieldTraits<T>::parsed_type, ErrorCode> - O valor convertido, UNKNOWN_ERROR se não houver parser, ou PARSE_ERROR se a chave estiver faltando ou for inválida.
+******************************************************************************
+*/
+template <typename T>
+std::expected<typename FieldTraits<T>::parsed_type, ErrorCode> ConfigurationManager::convertKey(const IConfigParser* parser, std::string_view section, std::string_view key)
+{
+    if (!parser) // Snapshot sem parser (por exemplo, o snapshot de OUT_OF_MEMORY).
+    {
+        return std::unexpected(ErrorCode::UNKNOWN_ERROR);
+    }
+    return convertValue<T>(parser->findValue(section, key));
+}
+
+/**
+******************************************************************************
+* @brief   : Copia um valor convertido para o tipo pedido pelo chamador.
+******************************************************************************.
+* @param: value - O valor convertido (por exemplo, uma visão do texto), ou o seu código de erro.
+* @return: std::expected<T, ErrorCode> - O valor no tipo T, ou o mesmo código de erro.
+******************************************************************************
+*/
+template <typename T>
+std::expected<T, ErrorCode> ConfigurationManager::toValue(const std::expected<typename FieldTraits<T>::parsed_type, ErrorCode>& value)
+{
+    if (!value)
+    {
+        return std::unexpected(value.error());
+    }
+    T result{};
+    FieldTraits<T>::assign(result, *value);
+    return result;
+}
+
+/**
+******************************************************************************
+* @brief   : Método genérico para ler uma chave qualquer.
+* @details : O parser do snapshot corrente é consultado e o valor é convertido a cada chamada, com o custo de um hash e de comparações de texto. O parser permanece vivo durante a consulta, mesmo que um reload publique outro snapshot nesse meio tempo.
+******************************************************************************.
+* @param: section - O nome da seção (vazio para a seção global).
+* @param: key - O nome da chave.
+* @return: std::expected<T, ErrorCode> - O valor convertido, PARSE_ERROR se a chave estiver faltando ou for inválida, ou UNKNOWN_ERROR se o snapshot não tiver parser.
+******************************************************************************
+*/
+template <typename T>
+std::expected<T, ErrorCode> ConfigurationManager::get(std::string_view section, std::string_view key) const
+{
+    AccessCounters::count(m_counters.byName);
+    return m_snapshot.read([section, key](const ConfigSnapshot& snapshot) { return toValue<T>(convertKey<T>(snapshot.parser.get(), section, key)); });
+}
+
+/**
+******************************************************************************
+* @brief   : Método para resolver uma chave uma única vez em um identificador.
+******************************************************************************.
+* @param: section - O nome da seção (vazio para a seção global).
+* @param: key - O nome da chave.
+* @return: std::expected<KeyHandle<T>, ErrorCode> - O identificador, ou OUT_OF_MEMORY se o recurso de memória se esgotou. Uma chave ausente ou inválida não é um erro aqui: o erro fica guardado e é retornado pelas leituras, até que um reload traga um valor válido.
+******************************************************************************
+*/
+template <typename T>
+std::expected<KeyHandle<T>, ErrorCode> ConfigurationManager::intern(std::string_view section, std::string_view key)
+{
+    std::expected<std::uint32_t, ErrorCode> slot = internKey(section, key, &resolveKey<T>);
+    if (!slot)
+    {
+        return std::unexpected(slot.error());
+    }
+    return KeyHandle<T>{*slot};
+}
+
+/**
+******************************************************************************
+* @brief   : Método para ler o valor guardado de uma chave registrada com intern.
+* @details : A leitura é um acesso direto à posição do identificador no snapshot corrente, sem locks, sem hash e sem comparação de textos. O valor foi convertido quando o snapshot foi montado; para int, a chamada não faz nenhuma alocação.
+******************************************************************************.
+* @param: handle - O identificador retornado por intern.
+* @return: std::expected<T, ErrorCode> - O valor guardado, o erro guardado na resolução da chave, ou UNKNOWN_ERROR se o identificador não pertencer a este gerenciador.
+******************************************************************************
+*/
+template <typename T>
+std::expected<T, ErrorCode> ConfigurationManager::get(KeyHandle<T> handle) const
+{
+    using Cached = std::expected<typename FieldTraits<T>::parsed_type, ErrorCode>; // Alternativa de KeyValue correspondente a T.
+    AccessCounters::count(m_counters.byHandle);
+    return m_snapshot.read([handle](const ConfigSnapshot& snapshot) -> std::expected<T, ErrorCode>
+    {
+        const Cached* value = handle.slot < snapshot.values.size() ? std::get_if<Cached>(&snapshot.values[handle.slot]) : nullptr;
+        if (!value) // Identificador de outro gerenciador, ou snapshot de OUT_OF_MEMORY sem valores.
+        {
+            return std::unexpected(ErrorCode::UNKNOWN_ERROR);
+        }
+        return toValue<T>(*value);
+    });
+}
+
 #endif
\ No newline at end of file
@@ -12,7 +12,12 @@
 #define I_CONFIG_PARSER_HPP
 
 #include <expected>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
+#include "ConfigMetrics.hpp"
 #include "error-handler.hpp" 
 /*----------------------------------------------------------------------------*/
 
@@ -39,6 +44,18 @@ public:
     virtual ~IConfigParser() = default; // Destrutor virtual para garantir que os recursos sejam liberados corretamente quando um objeto que implementa esta interface for destruído.
     virtual std::expected<TcpConfig, ErrorCode> parseTcp() = 0; // Método virtual puro para ler e interpretar os dados de configuração TCP do arquivo. Retorna um std::expected contendo a configuração TCP ou um código de erro, permitindo que o chamador lide com falhas.
     virtual std::expected<UartConfig, ErrorCode> parseUart() = 0; // Método virtual puro para ler e interpretar os dados de configuração UART do arquivo, análogo ao método parseTcp.
+
+    // Métodos para arquivos com várias instâncias de uma mesma configuração, declaradas em seções numeradas ([UART0], [UART1], ..., [TCP0], ...). As implementações padrão descrevem um parser sem suporte a seções numeradas. Os três métodos devem poder ser chamados por várias threads ao mesmo tempo.
+    virtual std::span<const std::string_view> sectionNames() const { return {}; } // Retorna os nomes de todas as seções do arquivo que contêm chaves, na ordem em que aparecem, sem copiá-los. A lista e as visões permanecem válidas enquanto o parser existir.
+    virtual std::expected<TcpConfig, ErrorCode> parseTcpSection(std::string_view section) const { (void)section; return std::unexpected(ErrorCode::PARSE_ERROR); } // Lê e interpreta a configuração TCP de uma seção específica (por exemplo, "TCP3").
+    virtual std::expected<UartConfig, ErrorCode> parseUartSection(std::string_view section) const { (void)section; return std::unexpected(ErrorCode::PARSE_ERROR); } // Lê e interpreta a configuração UART de uma seção específica (por exemplo, "UART12").
+
+    // Consulta genérica de chaves, usada pelos acessores tipados do ConfigurationManager (get<T> e KeyHandle). A implementação padrão descreve um parser sem valores textuais (por exemplo, um snapshot binário com campos já convertidos). Deve poder ser chamada por várias threads ao mesmo tempo.
+    virtual std::optional<std::string_view> findValue(std::string_view section, std::string_view key) const { (void)section; (void)key; return std::nullopt; } // Retorna o valor textual de uma chave em uma seção, com as mesmas regras usadas pelos esquemas (inclusive a seção global como alternativa), ou std::nullopt se a chave não existir. A visão permanece válida enquanto o parser existir.
+
+    // Instrumentação (ConfigMetrics.hpp). As implementações padrão descrevem um parser sem medidas e sem posições de origem.
+    virtual LoadMetrics loadMetrics() const { return {}; } // Retorna as medidas da carga feita na construção (E/S, tokenização, bytes, linhas e pico de memória). Só são coletadas se configMetricsEnabled() for true durante a construção.
+    virtual SourceLocation locate(std::string_view section, std::string_view key) const { (void)section; (void)key; return {}; } // Retorna a posição do valor de uma chave ou, se ela não existir, do cabeçalho da seção. Usado somente para descrever erros, portanto pode ser lento.
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+/*
+ * IniIndex.hpp
+ *
+ * Definição da classe IniIndex, um índice (seção, chave) -> valor construído uma única vez durante a carga do arquivo. As entradas ficam em um vetor contíguo e são localizadas por uma tabela hash de endereçamento aberto, de modo que cada consulta custa O(1), independentemente do tamanho do arquivo.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef INI_INDEX_HPP
+#define INI_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+/*----------------------------------------------------------------------------*/
+
+// Estrutura que representa uma entrada do índice. Os campos são visões do buffer de origem, que deve permanecer válido enquanto o índice for usado.
+struct IniEntry
+{
+    std::string_view section; // Nome da seção a que a chave pertence.
+    std::string_view key; // Nome da chave.
+    std::string_view value; // Valor associado à chave.
+    std::uint32_t origin = 0; // Origem do valor, definida por quem insere (por exemplo, a camada de um carregamento em camadas). Zero quando há uma única origem.
+};
+
+// Classe IniIndex, que associa cada par (seção, chave) ao seu valor. Chaves iguais em seções diferentes são entradas distintas; uma chave repetida na mesma seção sobrescreve o valor anterior. Toda a memória do índice vem de um std::pmr::memory_resource, o que permite construí-lo sobre uma arena estática em sistemas sem heap após a inicialização.
+class IniIndex
+{
+private:
+    // Estrutura de um slot da tabela hash. Um slot vazio tem entry igual a zero; os demais guardam a posição da entrada + 1 e os 32 bits altos do hash, usados para descartar comparações de strings.
+    struct Slot
+    {
+        std::uint32_t entry = 0; // Posição da entrada em m_entries, somada de 1 (zero indica slot vazio).
+        std::uint32_t tag = 0; // Parte alta do hash do par (seção, chave).
+    };
+
+    std::pmr::vector<IniEntry> m_entries; // Entradas do índice, armazenadas de forma contígua na ordem em que apareceram pela primeira vez.
+    std::pmr::vector<Slot> m_slots; // Tabela hash de endereçamento aberto com sondagem linear. O tamanho é sempre uma potência de dois.
+    std::pmr::vector<std::string_view> m_sections; // Nomes das seções que contêm chaves, na ordem em que apareceram pela primeira vez.
+    std::pmr::unordered_set<std::string_view> m_knownSections; // Conjunto das seções já registradas, consultado apenas quando a seção muda entre duas inserções.
+    std::string_view m_lastSection; // Seção da última inserção. Como as chaves de uma seção são inseridas em sequência, a seção só precisa ser registrada quando muda.
+
+    void rehash(std::size_t slotCount); // Reconstrói a tabela hash com a quantidade de slots indicada.
+public:
+    explicit IniIndex(std::pmr::memory_resource* resource = std::pmr::get_default_resource()); // Construtor que recebe o recurso de memória de onde vêm todas as estruturas do índice (por padrão, o operador new global). O recurso deve viver mais que o índice. Se ele se esgotar, insert e reserve lançam std::bad_alloc.
+
+    static std::uint64_t hash(std::string_view section, std::string_view key); // Calcula o hash (FNV-1a de 64 bits) de um par (seção, chave).
+
+    void reserve(std::size_t entryCount); // Reserva espaço para a quantidade de entradas indicada, evitando reconstruções da tabela durante a carga.
+    void insert(std::string_view section, std::string_view key, std::string_view value, std::uint32_t origin = 0); // Insere um par (seção, chave) ou sobrescreve o valor (e a origem) de um par já existente.
+    std::optional<std::string_view> find(std::string_view section, std::string_view key) const; // Procura o valor de um par (seção, chave). Retorna std::nullopt se o par não existir.
+    const IniEntry* findEntry(std::string_view section, std::string_view key) const; // Procura a entrada de um par (seção, chave), com o valor e a sua origem. Retorna nullptr se o par não existir.
+
+    std::size_t size() const { return m_entries.size(); } // Retorna a quantidade de entradas do índice.
+    std::span<const IniEntry> entries() const { return m_entries; } // Retorna todas as entradas do índice, na ordem em que apareceram pela primeira vez.
+    std::span<const std::string_view> sections() const { return m_sections; } // Retorna os nomes das seções que contêm chaves, na ordem em que apareceram pela primeira vez.
+};
+
+#endif
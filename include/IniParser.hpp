@@ -11,22 +11,40 @@
 #ifndef INI_PARSER_HPP
 #define INI_PARSER_HPP
 
+#include <memory_resource>
 #include <string>
-#include <fstream>
-#include <map>
+#include <optional>
+#include <span>
+#include <string_view>
+#include "ConfigMetrics.hpp"
 #include "IConfigParser.hpp"
+#include "IniIndex.hpp"
+#include "MappedFile.hpp"
 /*----------------------------------------------------------------------------*/
 
-// Classe IniParser, que é responsável por ler arquivos de configuração no formato INI e interpretar os dados para fornecer as configurações de TCP e UART. Esta classe implementa a interface IConfigParser.
+// Classe IniParser, que é responsável por ler arquivos de configuração no formato INI e interpretar os dados para fornecer as configurações de TCP e UART. Esta classe implementa a interface IConfigParser. Em sistemas POSIX, nenhuma memória é pedida ao operador new global quando o parser recebe um recurso de memória próprio: o arquivo é mapeado com mmap e o índice vem do recurso.
 class IniParser : public IConfigParser 
 {
 private:
-    std::string m_filePath; // Caminho para o arquivo de configuração INI
-    std::map <std::string, std::string> m_configData; // Mapa para armazenar as chaves e valores lidos do arquivo de configuração. A chave é o nome da configuração (por exemplo, "ip", "port", "protocol" para TCP) e o valor é a string correspondente lida do arquivo. Este mapa facilita a busca dos valores de configuração durante a interpretação dos dados e otimiza o processo de parsing, permitindo que o método parseTcp e parseUart acessem os dados de configuração de forma eficiente.
+    CountingResource m_memory; // Repassa os pedidos de memória ao recurso recebido na construção, contabilizando o pico quando a instrumentação está ligada. Declarado antes dos membros que o usam.
+    std::pmr::string m_filePath; // Caminho para o arquivo de configuração INI, guardado no recurso de memória do parser.
+    MappedFile m_file; // Conteúdo do arquivo de configuração, mapeado em memória (ou lido uma única vez para um buffer próprio). As entradas de m_index apontam para este bloco, por isso ele deve ser declarado antes do índice.
+    IniIndex m_index; // Índice (seção, chave) -> valor construído uma única vez no construtor, como visões do conteúdo de m_file. Chaves iguais em seções diferentes não se sobrescrevem, e cada consulta dos métodos parseTcp e parseUart custa O(1), independentemente do tamanho do arquivo.
+    std::optional<ErrorCode> m_loadError; // Erro da construção do índice (OUT_OF_MEMORY se o recurso de memória se esgotou). Quando presente, todas as consultas o retornam.
+    LoadMetrics m_metrics; // Medidas da carga, preenchidas somente com a instrumentação ligada.
+
+    void buildIndex(const std::string& filePath, bool measure); // Tokeniza o conteúdo de m_file e constrói o índice.
 public:
-    IniParser(const std::string& filePath); // Construtor que recebe o caminho para o arquivo de configuração INI. Ele é responsável por ler o arquivo e armazenar os dados em um mapa para uso posterior pelos métodos parseTcp e parseUart. O construtor deve lidar com a leitura do arquivo, verificando se ele existe e se pode ser aberto, e deve interpretar as linhas do arquivo para preencher o mapa de configuração. Se o arquivo não puder ser lido ou estiver mal formatado, o construtor deve lançar uma exceção ou lidar com o erro de forma apropriada.
-    std::expected<TcpConfig, ErrorCode> parseTcp() override; // Método para ler e interpretar os dados de configuração TCP do arquivo. Ele deve acessar o mapa de configuração preenchido pelo construtor, extrair os valores correspondentes às chaves "ip", "port" e "protocol", e preencher uma estrutura TcpConfig com esses valores. O método deve validar os dados (por exemplo, verificar se a porta é um número válido e se o protocolo é "TCP" ou "UDP") e retornar um std::expected contendo a configuração TCP ou um código de erro, permitindo que o chamador lide com falhas.
+    IniParser(const std::string& filePath, std::pmr::memory_resource* resource = std::pmr::get_default_resource()); // Construtor que recebe o caminho para o arquivo de configuração INI e, opcionalmente, o recurso de memória de onde vem todo o armazenamento interno do parser (por exemplo, um std::pmr::monotonic_buffer_resource sobre um array estático). O recurso deve viver mais que o parser. Ele é responsável por mapear o arquivo em memória e construir o índice (seção, chave) -> valor para uso posterior pelos métodos parseTcp e parseUart. O construtor deve lidar com a leitura do arquivo, verificando se ele existe e se pode ser aberto, e deve interpretar as linhas do arquivo para preencher o índice de configuração. Se o arquivo não puder ser lido ou estiver mal formatado, o construtor deve lançar uma exceção ou lidar com o erro de forma apropriada.
+    IniParser(MappedFile file, const std::string& filePath, std::pmr::memory_resource* resource = std::pmr::get_default_resource()); // Construtor que recebe o conteúdo de um arquivo já aberto (por exemplo, por createParser, que o abre uma única vez para detectar o formato), sem abri-lo novamente.
+    std::expected<TcpConfig, ErrorCode> parseTcp() override; // Método para ler e interpretar os dados de configuração TCP do arquivo. Ele deve consultar no índice preenchido pelo construtor os valores das chaves "ip", "port" e "protocol" da seção [TCP], e preencher uma estrutura TcpConfig com esses valores. O método deve validar os dados (por exemplo, verificar se a porta é um número válido e se o protocolo é "TCP" ou "UDP") e retornar um std::expected contendo a configuração TCP ou um código de erro, permitindo que o chamador lide com falhas.
     std::expected<UartConfig, ErrorCode> parseUart() override; // Método para ler e interpretar os dados de configuração UART do arquivo, análogo ao método parseTcp. 
+    std::span<const std::string_view> sectionNames() const override; // Retorna os nomes das seções do arquivo que contêm chaves, na ordem em que aparecem.
+    std::expected<TcpConfig, ErrorCode> parseTcpSection(std::string_view section) const override; // Lê e interpreta a configuração TCP de uma seção específica (por exemplo, "TCP3").
+    std::expected<UartConfig, ErrorCode> parseUartSection(std::string_view section) const override; // Lê e interpreta a configuração UART de uma seção específica (por exemplo, "UART12").
+    std::optional<std::string_view> findValue(std::string_view section, std::string_view key) const override; // Procura o valor de uma chave na seção indicada, recorrendo à seção global para arquivos sem cabeçalhos.
+    LoadMetrics loadMetrics() const override { return m_metrics; } // Retorna os tempos de E/S e de tokenização, os bytes, as linhas e o pico de memória do índice.
+    SourceLocation locate(std::string_view section, std::string_view key) const override; // Retorna a linha e a coluna do valor de uma chave ou, se ela não existir, do cabeçalho da seção.
 };
 
 #endif
\ No newline at end of file
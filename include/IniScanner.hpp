@@ -0,0 +1,43 @@
+/*
+ * IniScanner.hpp
+ *
+ * Definição dos núcleos de varredura do IniTokenizer. Cada núcleo examina um bloco de 64 bytes de uma só vez e devolve máscaras de bits com as posições dos caracteres estruturais da linha ('\n' e '='), de modo que cada byte do arquivo é examinado uma única vez. Há versões SSE2 e AVX2, escolhidas em tempo de execução conforme o processador, e uma versão escalar portável.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef INI_SCANNER_HPP
+#define INI_SCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+/*----------------------------------------------------------------------------*/
+
+inline constexpr std::size_t INI_SCAN_BLOCK = 64; // Tamanho do bloco examinado por chamada, em bytes (um bit por byte nas máscaras).
+
+// Máscaras de um bloco: o bit i está ligado se o byte i do bloco for o caractere correspondente.
+struct IniBlockMasks
+{
+    std::uint64_t newlines; // Posições de '\n'.
+    std::uint64_t delimiters; // Posições de '='.
+};
+
+// Níveis de instrução dos núcleos, do mais portável ao mais largo.
+enum class IniScanLevel
+{
+    SCALAR, // Um byte por vez; disponível em qualquer plataforma.
+    SSE2, // 16 bytes por instrução (x86).
+    AVX2 // 32 bytes por instrução (x86 com AVX2).
+};
+
+using IniBlockScanner = IniBlockMasks (*)(const char* block); // Núcleo que examina os 64 bytes a partir de block.
+
+IniScanLevel bestIniScanLevel(); // Retorna o nível mais largo suportado pelo processador em execução. A detecção é feita uma única vez.
+IniBlockScanner iniBlockScanner(IniScanLevel level); // Retorna o núcleo do nível indicado, ou o do melhor nível suportado se o indicado não estiver disponível.
+const char* iniScanLevelName(IniScanLevel level); // Retorna o nome do nível ("scalar", "sse2" ou "avx2").
+std::size_t estimateIniEntries(std::string_view text); // Retorna um limite superior da quantidade de pares chave/valor de um texto INI (o menor valor entre a quantidade de '=' e a de linhas), calculado sem alocar, para dimensionar o índice antes da carga.
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * IniTokenizer.hpp
+ *
+ * Definição da classe IniTokenizer, responsável por percorrer o conteúdo de um arquivo INI já carregado em memória e extrair os pares chave/valor, junto com a seção a que pertencem, sem copiar nenhum byte. Os tokens produzidos são std::string_view que apontam diretamente para o buffer de origem.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef INI_TOKENIZER_HPP
+#define INI_TOKENIZER_HPP
+
+#include <cstddef>
+#include <string_view>
+#include "ConfigMetrics.hpp"
+#include "IniScanner.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Estrutura que representa um par chave/valor extraído de uma linha do arquivo INI. Todos os campos apontam para o buffer de origem, que deve permanecer válido enquanto o token for usado.
+struct IniToken
+{
+    std::string_view section; // Nome da seção em que a chave foi declarada (por exemplo, "TCP"). Chaves declaradas antes de qualquer cabeçalho pertencem à seção global, de nome vazio.
+    std::string_view key; // Chave, que é a parte da linha antes do primeiro '=', sem espaços nas extremidades.
+    std::string_view value; // Valor, que é a parte da linha após o primeiro '=', sem espaços nas extremidades.
+};
+
+// Tipos de linha de um arquivo INI, conforme classificados pela função parseIniLine.
+enum class IniLineType
+{
+    IGNORED, // Linha vazia, comentário, cabeçalho malformado ou linha sem o delimitador '='.
+    SECTION, // Cabeçalho de seção bem formado ("[secao]").
+    KEY_VALUE // Par chave/valor.
+};
+
+// Classe IniTokenizer, que percorre o texto linha por linha e entrega um IniToken a cada chamada de next(). Cabeçalhos "[secao]" alteram a seção corrente; linhas vazias, comentários (iniciados por ';' ou '#') e linhas sem o delimitador '=' são ignorados. Os finais de linha e os delimitadores são localizados 64 bytes por vez pelos núcleos de IniScanner.hpp.
+class IniTokenizer
+{
+private:
+    std::string_view m_text; // Texto completo a ser percorrido.
+    std::size_t m_position = 0; // Posição do início da próxima linha a ser analisada.
+    std::string_view m_section; // Seção corrente, definida pelo último cabeçalho encontrado.
+    IniBlockScanner m_scanner; // Núcleo de varredura usado pelo tokenizador, escolhido na construção.
+    std::size_t m_blockStart = std::string_view::npos; // Posição do bloco de 64 bytes cujas máscaras estão em m_masks (npos antes do primeiro bloco).
+    IniBlockMasks m_masks{0, 0}; // Máscaras de '\n' e '=' do bloco corrente. Como o texto é percorrido sempre para a frente, cada bloco é examinado uma única vez.
+    std::size_t m_lines = 0; // Quantidade de linhas percorridas.
+
+    std::size_t findStructural(std::size_t position, bool includeDelimiters); // Retorna a posição do próximo '\n' (ou também '=') a partir de position, ou o tamanho do texto se não houver.
+public:
+    explicit IniTokenizer(std::string_view text, IniScanLevel level = bestIniScanLevel()); // Construtor que recebe o texto a ser percorrido e, opcionalmente, o nível de instruções da varredura (por padrão, o melhor suportado pelo processador). O texto não é copiado.
+    bool next(IniToken& token); // Avança até o próximo par chave/valor e o armazena em token. Retorna false quando o texto termina.
+    std::size_t lineCount() const { return m_lines; } // Retorna a quantidade de linhas percorridas até o momento (todas as linhas do texto, depois que next retornar false).
+};
+
+std::string_view trimIni(std::string_view text); // Remove espaços e tabulações das extremidades de um trecho de texto, sem copiá-lo.
+IniLineType parseIniLine(std::string_view line, std::size_t delimiter, std::string_view& first, std::string_view& second); // Classifica uma linha cuja posição do primeiro '=' (ou npos) já é conhecida, evitando examiná-la novamente.
+SourceLocation iniPositionOf(std::string_view text, const char* position); // Retorna a linha e a coluna (a partir de 1) de um ponteiro para dentro do texto, ou linha 0 se ele estiver fora. O campo file não é preenchido.
+IniLineType parseIniLine(std::string_view line, std::string_view& first, std::string_view& second); // Classifica uma linha (sem o '\n') e extrai o nome da seção (em first) ou a chave e o valor (em first e second), sem copiá-los. É a regra usada pelo IniTokenizer, compartilhada com os parsers que recebem o texto linha a linha.
+
+#endif
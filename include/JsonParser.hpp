@@ -0,0 +1,55 @@
+/*
+ * JsonParser.hpp
+ *
+ * Definição da classe JsonParser, que lê arquivos de configuração no formato JSON e fornece as configurações de TCP e UART. Cada membro do objeto principal cujo valor é um objeto é uma seção ({"TCP": {"ip": "...", "port": 502}, "UART3": {...}}); os membros escalares do objeto principal formam a seção global. O documento é percorrido uma única vez, sem construir uma árvore: os valores escalares são indexados como visões do próprio arquivo.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef JSON_PARSER_HPP
+#define JSON_PARSER_HPP
+
+#include <cstddef>
+#include <list>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include "ConfigMetrics.hpp"
+#include "IConfigParser.hpp"
+#include "IniIndex.hpp"
+#include "MappedFile.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Classe JsonParser, que implementa a interface IConfigParser sobre um documento JSON. A leitura é feita sob demanda, como no IniParser: o texto é validado e percorrido uma única vez, e somente os valores escalares das seções (strings, números e literais) são guardados, no mesmo IniIndex usado pelo INI, como visões do arquivo mapeado. Objetos e listas aninhados dentro de uma seção são validados e descartados. Apenas as strings com sequências de escape são copiadas, já decodificadas, para o recurso de memória do parser. As configurações são preenchidas e validadas por bindConfig, com as mesmas regras e os mesmos códigos de erro do INI: um número é entregue ao esquema como o seu texto, e uma string com dígitos é aceita em um campo inteiro.
+class JsonParser : public IConfigParser
+{
+private:
+    CountingResource m_memory; // Repassa os pedidos de memória ao recurso recebido na construção, contabilizando o pico quando a instrumentação está ligada. Declarado antes dos membros que o usam.
+    std::pmr::string m_filePath; // Caminho do arquivo, guardado no recurso de memória do parser.
+    MappedFile m_file; // Conteúdo do arquivo. As entradas de m_index apontam para este bloco, por isso ele deve ser declarado antes do índice.
+    std::pmr::list<std::pmr::string> m_decoded; // Strings com sequências de escape, já decodificadas. Uma std::list não move os elementos existentes ao crescer, por isso as visões guardadas no índice continuam válidas, e, ao contrário de um std::deque, não aloca nada enquanto está vazia.
+    IniIndex m_index; // Índice (seção, chave) -> valor, com visões de m_file (ou de m_decoded).
+    std::optional<ErrorCode> m_loadError; // Erro da carga: INVALID_FORMAT para um documento mal formado, ou OUT_OF_MEMORY. Quando presente, todas as consultas o retornam.
+    std::size_t m_errorOffset = 0; // Posição, em bytes, em que o documento deixou de ser válido, usada por locate.
+    LoadMetrics m_metrics; // Medidas da carga, preenchidas somente com a instrumentação ligada.
+
+    void buildIndex(const std::string& filePath, bool measure); // Percorre o documento e constrói o índice.
+public:
+    JsonParser(const std::string& filePath, std::pmr::memory_resource* resource = std::pmr::get_default_resource()); // Construtor que mapeia o arquivo e constrói o índice. O recurso de memória recebe o índice, o caminho e as strings decodificadas, e deve viver mais que o parser.
+    JsonParser(MappedFile file, const std::string& filePath, std::pmr::memory_resource* resource = std::pmr::get_default_resource()); // Construtor que recebe o conteúdo de um arquivo já aberto (por exemplo, por createParser), sem abri-lo novamente.
+
+    std::expected<TcpConfig, ErrorCode> parseTcp() override; // Lê e valida a configuração TCP do objeto "TCP".
+    std::expected<UartConfig, ErrorCode> parseUart() override; // Lê e valida a configuração UART do objeto "UART".
+    std::span<const std::string_view> sectionNames() const override; // Retorna os nomes dos objetos do documento que contêm valores escalares, na ordem em que aparecem.
+    std::expected<TcpConfig, ErrorCode> parseTcpSection(std::string_view section) const override; // Lê e valida a configuração TCP de um objeto específico (por exemplo, "TCP3").
+    std::expected<UartConfig, ErrorCode> parseUartSection(std::string_view section) const override; // Lê e valida a configuração UART de um objeto específico (por exemplo, "UART12").
+    std::optional<std::string_view> findValue(std::string_view section, std::string_view key) const override; // Procura o valor de uma chave no objeto indicado, recorrendo aos membros escalares do objeto principal.
+    LoadMetrics loadMetrics() const override { return m_metrics; } // Retorna os tempos de E/S e de leitura do documento, os bytes, as linhas e o pico de memória do índice.
+    SourceLocation locate(std::string_view section, std::string_view key) const override; // Retorna a linha e a coluna do valor de uma chave, do nome do objeto da seção ou, para um documento mal formado, do ponto em que ele deixou de ser válido.
+};
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * LayeredParser.hpp
+ *
+ * Definição da classe LayeredParser, que carrega a configuração em camadas: um arquivo INI base seguido dos fragmentos de um diretório no estilo conf.d (por exemplo, sobrescritas por instalação e por dispositivo). Os fragmentos são lidos e tokenizados em paralelo e combinados com precedência bem definida: a última camada prevalece para cada par (seção, chave).
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef LAYERED_PARSER_HPP
+#define LAYERED_PARSER_HPP
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "IConfigParser.hpp"
+#include "IniIndex.hpp"
+#include "MappedFile.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Estrutura que representa uma camada da configuração: um arquivo e o seu conteúdo mapeado em memória.
+struct ConfigLayer
+{
+    std::string path; // Caminho do arquivo da camada.
+    MappedFile file; // Conteúdo do arquivo. As entradas do índice apontam para este bloco.
+};
+
+// Classe LayeredParser, que implementa a interface IConfigParser sobre a combinação de várias camadas INI. A camada 0 é o arquivo base; as seguintes são os arquivos *.ini do diretório, em ordem alfabética do nome. Cada valor guarda a camada de onde veio, consultável por originOf. Se alguma camada não puder ser lida, todas as configurações retornam FILE_OPEN_FAILED, para que uma sobrescrita nunca seja aplicada pela metade.
+class LayeredParser : public IConfigParser
+{
+private:
+    std::vector<ConfigLayer> m_layers; // Camadas, na ordem de precedência (a última prevalece). Declaradas antes do índice, que aponta para o seu conteúdo.
+    IniIndex m_index; // Índice (seção, chave) -> valor com o resultado da combinação de todas as camadas. A origem de cada entrada é a posição da sua camada em m_layers.
+    std::optional<ErrorCode> m_loadError; // Erro da carga, retornado por todas as configurações, ou std::nullopt se todas as camadas foram lidas.
+    LoadMetrics m_metrics; // Medidas da carga, preenchidas somente com a instrumentação ligada.
+
+    const IniEntry* findEntry(std::string_view section, std::string_view key) const; // Procura a entrada de uma chave na seção indicada, recorrendo à seção global.
+public:
+    LayeredParser(const std::string& basePath, const std::string& directoryPath, unsigned threadCount = 1); // Construtor que carrega o arquivo base e os fragmentos *.ini do diretório, lendo e tokenizando os arquivos em paralelo com threadCount threads. Um diretório inexistente equivale a um diretório vazio.
+    std::expected<TcpConfig, ErrorCode> parseTcp() override; // Lê e interpreta a configuração TCP resultante da combinação das camadas.
+    std::expected<UartConfig, ErrorCode> parseUart() override; // Lê e interpreta a configuração UART resultante da combinação das camadas.
+    std::span<const std::string_view> sectionNames() const override; // Retorna os nomes das seções de todas as camadas, na ordem em que aparecem pela primeira vez.
+    std::expected<TcpConfig, ErrorCode> parseTcpSection(std::string_view section) const override; // Lê e interpreta a configuração TCP de uma seção específica.
+    std::expected<UartConfig, ErrorCode> parseUartSection(std::string_view section) const override; // Lê e interpreta a configuração UART de uma seção específica.
+    std::optional<std::string_view> findValue(std::string_view section, std::string_view key) const override; // Procura o valor de uma chave na seção indicada, já combinado entre as camadas, recorrendo à seção global.
+    LoadMetrics loadMetrics() const override { return m_metrics; } // Retorna o tempo da leitura e tokenização paralela das camadas (em ioNs), o da combinação no índice (em tokenizeNs), e os bytes e as linhas de todas as camadas.
+    SourceLocation locate(std::string_view section, std::string_view key) const override; // Retorna o arquivo da camada, a linha e a coluna do valor de uma chave ou, se ela não existir, do cabeçalho da seção.
+
+    std::optional<std::string_view> originOf(std::string_view section, std::string_view key) const; // Retorna o caminho do arquivo de onde veio o valor de uma chave, ou std::nullopt se a chave não existir.
+    std::size_t layerCount() const { return m_layers.size(); } // Retorna a quantidade de camadas carregadas, incluindo o arquivo base.
+    std::optional<ErrorCode> loadError() const { return m_loadError; } // Retorna o erro da carga (FILE_OPEN_FAILED se alguma camada não pôde ser lida), ou std::nullopt.
+};
+
+#endif
@@ -0,0 +1,87 @@
+/*
+ * LazyIniParser.hpp
+ *
+ * Definição da classe LazyIniParser, que lê arquivos INI sob demanda. A carga apenas localiza os cabeçalhos das seções, em uma única passagem rápida; o corpo de cada seção é tokenizado e indexado na primeira consulta a ela, e o resultado é guardado para as consultas seguintes. Um processo que lê duas seções de um arquivo compartilhado com dezenas de outras paga, na inicialização e em memória, aproximadamente o que lê.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef LAZY_INI_PARSER_HPP
+#define LAZY_INI_PARSER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <list>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ConfigMetrics.hpp"
+#include "IConfigParser.hpp"
+#include "IniIndex.hpp"
+#include "MappedFile.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Classe LazyIniParser, que implementa a interface IConfigParser com as mesmas regras do IniParser (seções repetidas se somam, a última declaração de uma chave prevalece e a seção global serve de alternativa), mas sem tokenizar o arquivo inteiro na construção. O índice de cada seção é construído uma única vez, protegido por um mutex, e publicado com um ponteiro atômico; as consultas a uma seção já indexada não adquirem nenhum lock. Os métodos podem ser chamados por várias threads ao mesmo tempo.
+class LazyIniParser : public IConfigParser
+{
+private:
+    // Trecho do arquivo com o corpo de uma seção (as linhas entre o seu cabeçalho e o cabeçalho seguinte).
+    struct SectionRange
+    {
+        std::size_t begin; // Posição do início da primeira linha do corpo.
+        std::size_t end; // Posição seguinte ao final do corpo.
+        std::uint32_t next; // Posição, em m_ranges, do próximo trecho da mesma seção, ou NO_RANGE.
+    };
+
+    // Seção do arquivo que contém chaves, com os seus trechos e o seu índice, construído na primeira consulta.
+    struct Section
+    {
+        std::string_view name; // Nome da seção, como visão do cabeçalho no arquivo (vazio para a seção global).
+        std::uint32_t firstRange = 0; // Primeiro trecho da seção em m_ranges.
+        std::uint32_t lastRange = 0; // Último trecho da seção, ao qual o próximo é encadeado.
+        mutable std::atomic<const IniIndex*> index{nullptr}; // Índice da seção, nulo até a primeira consulta. Aponta para um elemento de m_parsed.
+    };
+
+    static constexpr std::uint32_t NO_RANGE = UINT32_MAX; // Indica o final da lista de trechos de uma seção.
+
+    mutable CountingResource m_memory; // Repassa os pedidos de memória ao recurso recebido na construção, contabilizando o pico quando a instrumentação está ligada. Declarado antes dos membros que o usam; mutável porque as consultas indexam as seções.
+    std::pmr::string m_filePath; // Caminho do arquivo, guardado no recurso de memória do parser.
+    MappedFile m_file; // Conteúdo do arquivo. Os nomes das seções e os índices apontam para este bloco, por isso ele deve ser declarado antes deles.
+    std::pmr::vector<SectionRange> m_ranges; // Trechos de todas as seções, na ordem do arquivo.
+    std::pmr::unordered_map<std::string_view, Section> m_sections; // Seções que contêm chaves, por nome. Os nós de um std::unordered_map não mudam de endereço, o que permite guardar o ponteiro atômico no próprio nó.
+    std::pmr::vector<std::string_view> m_sectionNames; // Nomes das seções que contêm chaves, na ordem em que aparecem.
+    mutable std::mutex m_parseMutex; // Serializa a indexação das seções, inclusive os pedidos ao recurso de memória feitos depois da construção.
+    mutable std::pmr::list<IniIndex> m_parsed; // Índices das seções já consultadas. Uma std::list não move os elementos existentes ao crescer, por isso os ponteiros publicados continuam válidos, e não aloca nada enquanto está vazia.
+    std::optional<ErrorCode> m_loadError; // Erro da localização das seções (OUT_OF_MEMORY se o recurso de memória se esgotou). Quando presente, todas as consultas o retornam.
+    LoadMetrics m_metrics; // Medidas da carga, preenchidas somente com a instrumentação ligada.
+
+    void buildSectionTable(const std::string& filePath, bool measure); // Localiza os cabeçalhos e registra os trechos de cada seção.
+    void addRange(std::string_view name, std::size_t begin, std::size_t end); // Registra o corpo de uma seção, se ele contiver alguma chave.
+    std::expected<const IniIndex*, ErrorCode> sectionIndex(std::string_view section) const; // Retorna o índice de uma seção, construindo-o na primeira consulta, ou nullptr se a seção não existir.
+    template <typename T>
+    std::expected<T, ErrorCode> parseSection(std::string_view section) const; // Indexa a seção e a seção global e preenche a configuração pelo esquema.
+public:
+    LazyIniParser(const std::string& filePath, std::pmr::memory_resource* resource = std::pmr::get_default_resource()); // Construtor que mapeia o arquivo e localiza as seções, sem tokenizá-las. O recurso de memória recebe a tabela de seções e os índices; como as seções são indexadas na primeira consulta, por qualquer thread, ele deve viver mais que o parser e aceitar pedidos de outras threads (os pedidos do parser nunca são simultâneos).
+    LazyIniParser(MappedFile file, const std::string& filePath, std::pmr::memory_resource* resource = std::pmr::get_default_resource()); // Construtor que recebe o conteúdo de um arquivo já aberto (por exemplo, por createParser), sem abri-lo novamente.
+
+    std::expected<TcpConfig, ErrorCode> parseTcp() override; // Lê e valida a configuração TCP da seção [TCP], indexando-a na primeira chamada.
+    std::expected<UartConfig, ErrorCode> parseUart() override; // Lê e valida a configuração UART da seção [UART], indexando-a na primeira chamada.
+    std::span<const std::string_view> sectionNames() const override; // Retorna os nomes das seções que contêm chaves, na ordem em que aparecem, sem indexá-las.
+    std::expected<TcpConfig, ErrorCode> parseTcpSection(std::string_view section) const override; // Lê e valida a configuração TCP de uma seção específica (por exemplo, "TCP3").
+    std::expected<UartConfig, ErrorCode> parseUartSection(std::string_view section) const override; // Lê e valida a configuração UART de uma seção específica (por exemplo, "UART12").
+    std::optional<std::string_view> findValue(std::string_view section, std::string_view key) const override; // Procura o valor de uma chave na seção indicada, recorrendo à seção global. Retorna std::nullopt também se a indexação da seção esgotar o recurso de memória.
+    LoadMetrics loadMetrics() const override { return m_metrics; } // Retorna os tempos de E/S e da localização das seções, os bytes, as linhas e o pico de memória da tabela de seções.
+    SourceLocation locate(std::string_view section, std::string_view key) const override; // Retorna a linha e a coluna do valor de uma chave ou, se ela não existir, do cabeçalho da seção.
+    std::size_t parsedSectionCount() const; // Retorna a quantidade de seções já indexadas (a seção global conta como uma).
+};
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * MappedFile.hpp
+ *
+ * Definição da classe MappedFile, responsável por disponibilizar o conteúdo completo de um arquivo como um único bloco contíguo de memória somente leitura. Em sistemas POSIX o arquivo é mapeado em memória (mmap); nas demais plataformas ele é lido uma única vez para um buffer próprio. Também define a substituição atômica e durável de um arquivo, usada pelo journal e pelo snapshot binário.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <string_view>
+#include "error-handler.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Classe MappedFile, que mantém o conteúdo de um arquivo acessível como um std::string_view durante todo o seu tempo de vida. Os parsers guardam std::string_view apontando para este bloco, portanto o MappedFile deve viver pelo menos tanto quanto eles.
+class MappedFile
+{
+private:
+    const char* m_data = nullptr; // Ponteiro para o início do conteúdo do arquivo (região mapeada ou buffer próprio).
+    std::size_t m_size = 0; // Tamanho do conteúdo em bytes.
+    bool m_isOpen = false; // Indica se o arquivo foi aberto com sucesso (um arquivo vazio também é considerado aberto).
+    bool m_isMapped = false; // Indica se m_data aponta para uma região mapeada com mmap, que precisa ser liberada com munmap.
+    std::string m_buffer; // Buffer próprio usado quando o mapeamento em memória não está disponível na plataforma.
+
+    void release(); // Libera a região mapeada ou o buffer próprio e volta ao estado vazio.
+public:
+    MappedFile() = default; // Construtor padrão, que cria um MappedFile vazio e fechado.
+    explicit MappedFile(const std::string& filePath); // Construtor que abre e mapeia (ou lê) o arquivo indicado. Em caso de falha, isOpen() retorna false.
+    ~MappedFile(); // Destrutor que libera a região mapeada.
+
+    MappedFile(const MappedFile&) = delete; // A cópia é proibida, pois a região mapeada tem um único dono.
+    MappedFile& operator=(const MappedFile&) = delete; // A atribuição por cópia é proibida pelo mesmo motivo.
+    MappedFile(MappedFile&& other) noexcept; // Construtor de movimentação, que transfere a posse da região mapeada.
+    MappedFile& operator=(MappedFile&& other) noexcept; // Atribuição por movimentação, análoga ao construtor de movimentação.
+
+    bool isOpen() const { return m_isOpen; } // Retorna true se o arquivo foi aberto com sucesso.
+    std::size_t size() const { return m_size; } // Retorna o tamanho do conteúdo em bytes.
+    std::string_view view() const { return std::string_view(m_data, m_size); } // Retorna uma visão do conteúdo completo do arquivo.
+};
+
+std::expected<void, ErrorCode> replaceFile(const std::string& filePath, std::string_view content); // Substitui um arquivo de forma atômica e durável: arquivo temporário, fsync, renomeação e, em sistemas POSIX, fsync do diretório. Retorna FILE_OPEN_FAILED se a gravação falhar (nesse caso, o arquivo não muda).
+bool syncDirectory(const std::string& filePath); // Sincroniza com o armazenamento o diretório que contém um arquivo, para que a sua criação ou renomeação sobreviva a uma queda de energia. Retorna false se a sincronização falhar.
+#if defined(__unix__) || defined(__APPLE__)
+bool writeAll(int fd, std::string_view bytes); // Grava um bloco inteiro em um descritor, repetindo as gravações parciais. Retorna false se alguma gravação falhar.
+#endif
+
+#endif
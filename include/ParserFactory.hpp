@@ -0,0 +1,42 @@
+/*
+ * ParserFactory.hpp
+ *
+ * Definição da função Factory createParser, responsável por escolher e instanciar o parser adequado para um arquivo de configuração. O arquivo é aberto uma única vez, o formato é detectado pelo conteúdo (INI ou JSON) e o mesmo bloco é entregue ao parser escolhido. Quando existe um snapshot binário atualizado ao lado do arquivo INI, ele é usado no lugar do INI, evitando a interpretação do texto na inicialização. A função createLayeredParser cria o parser de uma configuração em camadas (arquivo base e diretório conf.d).
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef PARSER_FACTORY_HPP
+#define PARSER_FACTORY_HPP
+
+#include <expected>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "IConfigParser.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Formatos de arquivo de configuração reconhecidos por detectConfigFormat.
+enum class ConfigFormat
+{
+    INI, // Texto no formato INI (inclusive um arquivo vazio).
+    JSON, // Documento JSON cujo primeiro caractere significativo é '{'.
+    UNKNOWN // Conteúdo binário, que nenhum parser de texto aceita.
+};
+
+// Modos de carga de um arquivo INI por createParser.
+enum class IniLoadMode
+{
+    EAGER, // Tokeniza o arquivo inteiro na carga (IniParser). Indicado quando a maior parte das seções é lida.
+    LAZY // Localiza apenas os cabeçalhos na carga e tokeniza cada seção na primeira consulta (LazyIniParser). Indicado para arquivos compartilhados com muitas seções de outros subsistemas.
+};
+
+ConfigFormat detectConfigFormat(std::string_view content); // Detecta o formato de um arquivo de configuração pelo seu conteúdo, examinando apenas o início do texto.
+
+std::expected<std::unique_ptr<IConfigParser>, ErrorCode> createParser(const std::string& filePath, IniLoadMode mode = IniLoadMode::EAGER); // Cria o parser adequado para o arquivo de configuração, escolhido pelo conteúdo (e, para um INI, pelo modo de carga), ou retorna um código de erro se o arquivo não puder ser aberto ou tiver um formato não suportado.
+std::expected<std::unique_ptr<IConfigParser>, ErrorCode> createLayeredParser(const std::string& basePath, const std::string& directoryPath, unsigned threadCount = 1); // Cria um parser que combina o arquivo INI base com os fragmentos *.ini de um diretório no estilo conf.d, ou retorna FILE_OPEN_FAILED se o arquivo base não existir ou se algum fragmento não puder ser lido.
+std::string snapshotPathFor(const std::string& filePath); // Retorna o caminho do snapshot binário associado a um arquivo de configuração (o próprio caminho acrescido de ".snap").
+
+#endif
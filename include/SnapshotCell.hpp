@@ -0,0 +1,127 @@
+/*
+ * SnapshotCell.hpp
+ *
+ * Definição da classe SnapshotCell, uma célula que publica snapshots imutáveis para muitas threads leitoras sem que elas precisem adquirir nenhum lock. A troca de snapshot segue o estilo RCU: o escritor prepara o novo snapshot por completo, publica-o com uma única escrita atômica e só reaproveita o espaço antigo depois que os leitores que ainda o usavam terminaram.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef SNAPSHOT_CELL_HPP
+#define SNAPSHOT_CELL_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+/*----------------------------------------------------------------------------*/
+
+// Classe SnapshotCell, que guarda o snapshot corrente em um de dois slots. Os leitores registram-se no contador do slot ativo, confirmam que ele continua ativo e leem o snapshot; nunca bloqueiam e nunca veem um snapshot parcialmente construído. O escritor grava sempre no slot inativo, depois de esperar que os leitores atrasados desse slot terminem, e então troca o índice ativo.
+template <typename T>
+class SnapshotCell
+{
+private:
+    // Contador de leitores de um slot, alinhado a uma linha de cache para que os dois contadores não disputem a mesma linha.
+    struct alignas(64) ReaderCount
+    {
+        std::atomic<unsigned> value{0}; // Quantidade de leitores usando o slot neste momento.
+    };
+
+    std::shared_ptr<const T> m_slots[2]; // Os dois slots de snapshot. Somente o slot indicado por m_active pode ser lido por novos leitores.
+    std::atomic<unsigned> m_active{0}; // Índice do slot ativo (0 ou 1).
+    mutable ReaderCount m_readers[2]; // Contadores de leitores de cada slot.
+    std::mutex m_writerMutex; // Serializa os escritores entre si. Os leitores nunca o adquirem.
+
+    unsigned enter() const; // Registra um leitor no slot ativo e retorna o seu índice.
+    void leave(unsigned slot) const { m_readers[slot].value.fetch_sub(1); } // Remove o registro de um leitor do slot indicado.
+public:
+    explicit SnapshotCell(std::shared_ptr<const T> initial) { m_slots[0] = std::move(initial); } // Construtor que publica o snapshot inicial no slot 0.
+
+    SnapshotCell(const SnapshotCell&) = delete; // A célula não pode ser copiada, pois os leitores referenciam os seus contadores.
+    SnapshotCell& operator=(const SnapshotCell&) = delete; // A atribuição por cópia é proibida pelo mesmo motivo.
+
+    template <typename Reader>
+    auto read(Reader&& reader) const; // Executa reader sobre o snapshot corrente, sem adquirir locks, e retorna o seu resultado.
+    std::shared_ptr<const T> load() const { return read([this](const T&, unsigned slot) { return m_slots[slot]; }); } // Retorna o snapshot corrente, mantendo-o vivo enquanto o chamador o usar.
+    void store(std::shared_ptr<const T> next); // Publica um novo snapshot. Os leitores passam a vê-lo por inteiro, ou continuam vendo o anterior.
+};
+
+/**
+******************************************************************************
+* @brief   : Registra um leitor no slot ativo.
+* @details : O leitor incrementa o contador do slot que acredita estar ativo e confirma, em seguida, que o slot continua ativo. Se um escritor trocou o slot nesse intervalo, o registro é desfeito e a tentativa é repetida. Como todas as operações são sequencialmente consistentes, um escritor que encontrou o contador zerado sempre publica a troca antes que um leitor atrasado confirme o slot, e esse leitor então repete a tentativa.
+******************************************************************************.
+* @return: unsigned - O índice do slot em que o leitor ficou registrado.
+******************************************************************************
+*/
+template <typename T>
+unsigned SnapshotCell<T>::enter() const
+{
+    for (;;) // Repete até registrar-se em um slot que continua ativo. Só há nova tentativa quando uma troca acontece no meio do registro.
+    {
+        unsigned slot = m_active.load(); // Slot que o leitor acredita estar ativo.
+        m_readers[slot].value.fetch_add(1); // Registra o leitor no slot.
+        if (m_active.load() == slot) // Confirma que o slot continua ativo; a partir daqui o escritor não pode alterá-lo.
+        {
+            return slot;
+        }
+        leave(slot); // O slot foi trocado no meio do registro: desfaz e tenta novamente.
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Executa uma função de leitura sobre o snapshot corrente.
+* @details : A função recebe uma referência constante para o snapshot (e, opcionalmente, o índice do slot) e deve apenas copiar o que precisar. O snapshot não pode ser substituído enquanto a função executa, e nenhum lock é adquirido.
+******************************************************************************.
+* @param: reader - Função chamada com o snapshot corrente.
+* @return: O valor retornado por reader.
+******************************************************************************
+*/
+template <typename T>
+template <typename Reader>
+auto SnapshotCell<T>::read(Reader&& reader) const
+{
+    unsigned slot = enter(); // Registra o leitor no slot ativo.
+    struct Guard // Garante que o registro seja desfeito ao final da leitura.
+    {
+        const SnapshotCell* cell;
+        unsigned slot;
+        ~Guard() { cell->leave(slot); }
+    } guard{this, slot};
+
+    if constexpr (std::is_invocable_v<Reader, const T&, unsigned>) // Leitores internos também recebem o índice do slot.
+    {
+        return reader(*m_slots[slot], slot);
+    }
+    else
+    {
+        return reader(*m_slots[slot]);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Publica um novo snapshot.
+* @details : O escritor grava no slot inativo, depois de esperar que os leitores que ainda o usavam (de duas publicações atrás) terminem, e então troca o índice ativo com uma única escrita atômica. O snapshot substituído só é destruído quando o último std::shared_ptr que o referencia for liberado.
+******************************************************************************.
+* @param: next - O novo snapshot, já construído e validado.
+******************************************************************************
+*/
+template <typename T>
+void SnapshotCell<T>::store(std::shared_ptr<const T> next)
+{
+    std::lock_guard lock(m_writerMutex); // Serializa os escritores; os leitores não são afetados.
+    unsigned target = 1 - m_active.load(); // O novo snapshot é gravado no slot inativo.
+    while (m_readers[target].value.load() != 0) // Espera os leitores atrasados do slot inativo terminarem as suas leituras.
+    {
+        std::this_thread::yield();
+    }
+    m_slots[target] = std::move(next); // Grava o novo snapshot; nenhum leitor pode estar lendo este slot.
+    m_active.store(target); // Publica o novo snapshot para os leitores.
+}
+
+#endif
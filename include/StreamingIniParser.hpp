@@ -0,0 +1,80 @@
+/*
+ * StreamingIniParser.hpp
+ *
+ * Definição da classe StreamingIniParser, um parser INI incremental para nós embarcados que recebem a configuração em blocos (por exemplo, pela UART ou por um socket) e não podem guardar o arquivo inteiro. Somente as chaves declaradas nos esquemas são guardadas; todo o restante é descartado à medida que chega, e a memória usada tem um limite fixo definido na construção.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef STREAMING_INI_PARSER_HPP
+#define STREAMING_INI_PARSER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include "ConfigSchema.hpp"
+#include "IConfigParser.hpp"
+/*----------------------------------------------------------------------------*/
+
+// Classe StreamingIniParser, que implementa a interface IConfigParser sobre um fluxo de bytes entregue em blocos de tamanho arbitrário. As linhas podem ser divididas entre blocos. Cada chave de ConfigSchema<TcpConfig> e ConfigSchema<UartConfig> tem dois espaços de tamanho fixo (um para a sua seção e outro para a seção global, que serve de alternativa como no IniParser); os demais pares são descartados. As configurações são preenchidas e validadas por bindConfig, com as mesmas regras e os mesmos códigos de erro dos outros backends.
+class StreamingIniParser : public IConfigParser
+{
+private:
+    // Seções que interessam ao parser. As demais são descartadas.
+    enum class Scope : std::uint8_t
+    {
+        GLOBAL, // Chaves declaradas antes de qualquer cabeçalho.
+        TCP, // Seção ConfigSchema<TcpConfig>::section.
+        UART, // Seção ConfigSchema<UartConfig>::section.
+        OTHER // Qualquer outra seção.
+    };
+
+    // Espaço de tamanho fixo que guarda o último valor de uma chave do esquema em uma seção.
+    struct Slot
+    {
+        std::string_view key; // Nome da chave (por exemplo, "port").
+        Scope schema = Scope::OTHER; // Esquema a que a chave pertence (TCP ou UART).
+        bool global = false; // Indica se o espaço guarda o valor da seção global, usado como alternativa.
+        bool present = false; // Indica se a chave já foi encontrada.
+        std::size_t length = 0; // Comprimento do valor guardado.
+        char* data = nullptr; // Início do espaço, dentro de m_storage.
+    };
+
+    static constexpr std::size_t TCP_FIELDS = std::tuple_size_v<decltype(ConfigSchema<TcpConfig>::fields)>; // Quantidade de chaves do esquema TCP.
+    static constexpr std::size_t UART_FIELDS = std::tuple_size_v<decltype(ConfigSchema<UartConfig>::fields)>; // Quantidade de chaves do esquema UART.
+    static constexpr std::size_t SLOT_COUNT = 2 * (TCP_FIELDS + UART_FIELDS); // Um espaço por chave na sua seção e outro na seção global.
+
+    std::size_t m_lineCapacity; // Maior linha guardada por inteiro. Também é o maior valor aceito para uma chave do esquema.
+    std::unique_ptr<char[]> m_storage; // Bloco único, alocado na construção, com o buffer de linha seguido dos espaços dos valores.
+    std::array<Slot, SLOT_COUNT> m_slots; // Espaços dos valores das chaves dos esquemas.
+    std::size_t m_lineLength = 0; // Quantidade de bytes da linha corrente já guardados no buffer.
+    bool m_lineTruncated = false; // Indica que a linha corrente excedeu o buffer; o restante dela é descartado.
+    Scope m_scope = Scope::GLOBAL; // Seção corrente.
+    std::optional<ErrorCode> m_error; // Primeiro erro encontrado. Depois dele, os blocos seguintes são recusados.
+
+    void processLine(); // Interpreta a linha guardada no buffer.
+    std::optional<std::string_view> findValue(Scope schema, std::string_view key) const; // Procura o valor de uma chave do esquema, recorrendo à seção global.
+public:
+    explicit StreamingIniParser(std::size_t maxLineLength = 256); // Construtor que aloca, de uma só vez, toda a memória usada pelo parser: (1 + SLOT_COUNT) * maxLineLength bytes.
+
+    StreamingIniParser(const StreamingIniParser&) = delete; // Os espaços apontam para m_storage; o parser não pode ser copiado.
+    StreamingIniParser& operator=(const StreamingIniParser&) = delete;
+
+    std::expected<void, ErrorCode> feed(std::span<const std::byte> chunk); // Consome um bloco de bytes de tamanho arbitrário. Retorna INVALID_FORMAT se uma linha relevante não couber no buffer.
+    std::expected<void, ErrorCode> finish(); // Interpreta a última linha, caso ela não termine com '\n'. Deve ser chamado depois do último bloco.
+    std::size_t memoryBound() const { return (1 + SLOT_COUNT) * m_lineCapacity; } // Retorna a memória reservada para linhas e valores, em bytes.
+
+    std::expected<TcpConfig, ErrorCode> parseTcp() override; // Preenche e valida a configuração TCP com os valores recebidos até o momento.
+    std::expected<UartConfig, ErrorCode> parseUart() override; // Preenche e valida a configuração UART com os valores recebidos até o momento.
+    std::optional<std::string_view> findValue(std::string_view section, std::string_view key) const override; // Retorna o valor recebido de uma chave dos esquemas nas seções [TCP] e [UART] (ou na seção global). As demais chaves não são guardadas e resultam em std::nullopt.
+};
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ * ThreadPool.hpp
+ *
+ * Definição da classe ThreadPool, um conjunto fixo de threads de trabalho usado para interpretar e validar em paralelo as seções numeradas de um arquivo de configuração ([UART0], [UART1], ..., [TCP0], ...).
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+/*----------------------------------------------------------------------------*/
+
+// Classe ThreadPool, que executa laços paralelos sobre um intervalo de índices. As threads de trabalho são criadas uma única vez no construtor e ficam bloqueadas enquanto não há trabalho. A thread que chama parallelFor também executa iterações, de modo que um pool de uma thread não cria nenhuma thread extra e executa o laço de forma sequencial.
+class ThreadPool
+{
+private:
+    std::mutex m_mutex; // Protege os campos que descrevem o laço corrente e o estado das threads de trabalho.
+    std::mutex m_callMutex; // Garante que apenas um parallelFor esteja em andamento por vez.
+    std::condition_variable m_wake; // Acorda as threads de trabalho quando um novo laço é publicado ou o pool é destruído.
+    std::condition_variable m_done; // Acorda a thread chamadora quando todas as threads de trabalho saíram do laço corrente.
+    const std::function<void(std::size_t)>* m_body = nullptr; // Corpo do laço corrente.
+    std::size_t m_count = 0; // Quantidade de iterações do laço corrente.
+    std::atomic<std::size_t> m_next{0}; // Próximo índice a ser executado. Cada thread reserva os índices com um fetch_add, sem lock.
+    std::size_t m_generation = 0; // Número do laço corrente, incrementado a cada parallelFor para que cada thread participe de cada laço uma única vez.
+    std::size_t m_busyWorkers = 0; // Quantidade de threads de trabalho ainda executando o laço corrente.
+    bool m_stopping = false; // Indica que o pool está sendo destruído.
+    std::vector<std::jthread> m_workers; // Threads de trabalho. Declaradas por último para serem encerradas antes dos demais membros serem destruídos.
+
+    void work(); // Laço das threads de trabalho.
+    void runIterations(); // Executa iterações do laço corrente até que não reste nenhum índice.
+public:
+    explicit ThreadPool(unsigned threadCount = 1); // Construtor que cria threadCount - 1 threads de trabalho (a thread chamadora é a restante). Zero é tratado como um.
+    ~ThreadPool(); // Destrutor que encerra e aguarda as threads de trabalho.
+
+    ThreadPool(const ThreadPool&) = delete; // O ThreadPool não pode ser copiado, pois possui threads.
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned threadCount() const { return static_cast<unsigned>(m_workers.size()) + 1; } // Retorna a quantidade de threads que executam cada laço, incluindo a chamadora.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body); // Executa body(i) para cada i em [0, count) e só retorna depois que todas as iterações terminaram. O corpo não deve lançar exceções.
+};
+
+#endif
@@ -12,12 +12,14 @@
 #define ERROR_HANDLER_HPP
 /*----------------------------------------------------------------------------*/
 
-// Definição dos códigos de erro usando uma macro para facilitar a adição de novos erros no futuro. A macro ERROR_CODE_LIST é usada para definir os códigos de erro de forma concisa, e a enum struct ErrorCode é gerada a partir dessa lista. A função errorCodeToString é usada para converter os códigos de erro em strings legíveis para exibição ao usuário.
+// Definição dos códigos de erro usando uma macro para facilitar a adição de novos erros no futuro. A macro ERROR_CODE_LIST é usada para definir os códigos de erro de forma concisa, e a enum struct ErrorCode é gerada a partir dessa lista. A função errorCodeToString é usada para converter os códigos de erro em strings legíveis para exibição ao usuário. Os valores numéricos são gravados nos snapshots binários, portanto novos códigos devem ser sempre acrescentados ao final da lista.
 #define ERROR_CODE_LIST \
     X(FILE_OPEN_FAILED) \
     X(INVALID_FORMAT) \
     X(PARSE_ERROR) \
-    X(UNKNOWN_ERROR)
+    X(UNKNOWN_ERROR) \
+    X(STALE_SNAPSHOT) \
+    X(OUT_OF_MEMORY)
 
 // Enumeração dos códigos de erro, gerada a partir da macro ERROR_CODE_LIST. 
 enum struct ErrorCode 
@@ -0,0 +1,568 @@
+/*
+ * BinarySnapshot.cpp
+ *
+ * Implementação do formato de snapshot binário das configurações: gravação a partir do arquivo INI, verificação na carga e o parser BinarySnapshotParser.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "BinarySnapshot.hpp"
+#include "ConfigSchema.hpp"
+#include "ConfigSnapshot.hpp"
+#include "IniParser.hpp"
+#include "LazyIniParser.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <utility>
+#include <vector>
+/*----------------------------------------------------------------------------*/
+
+static_assert(sizeof(BinarySnapshotHeader) == 56, "O layout do cabeçalho faz parte do formato e não pode mudar sem incrementar a versão.");
+static_assert(sizeof(BinaryTcpRecord) == 112, "O layout do registro TCP faz parte do formato e não pode mudar sem incrementar a versão.");
+static_assert(sizeof(BinaryUartRecord) == 64, "O layout do registro UART faz parte do formato e não pode mudar sem incrementar a versão.");
+
+static constexpr char SNAPSHOT_MAGIC[4] = {'C', 'F', 'G', 'S'}; // Identificador do formato.
+static constexpr std::uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304; // Marca de ordem de bytes.
+static constexpr std::size_t NUMBER_SLOT = 12; // Bytes de cada inteiro formatado por BinarySnapshotParser: até 11 caracteres ("-2147483648") e, no último byte, o tamanho do texto.
+static constexpr std::size_t UART_NUMBERS = 3; // Campos inteiros de um registro UART (baudrate, data_bits e stop_bits); um registro TCP tem somente a porta.
+
+/**
+******************************************************************************
+* @brief   : Calcula o hash FNV-1a de 64 bits de uma sequência de bytes.
+******************************************************************************.
+* @param: bytes - Os bytes a serem processados.
+* @return: std::uint64_t - O hash calculado.
+******************************************************************************
+*/
+std::uint64_t hashBytes(std::string_view bytes)
+{
+    std::uint64_t value = 14695981039346656037ull; // Valor inicial (offset basis) do FNV-1a de 64 bits.
+    for (char c : bytes) // Mistura cada byte no hash.
+    {
+        value = (value ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    return value;
+}
+
+/**
+******************************************************************************
+* @brief   : Copia um texto para um campo de tamanho fixo, terminado em nulo.
+******************************************************************************.
+* @param: destination - O campo de destino.
+* @param: text - O texto a ser copiado.
+* @return: bool - Retorna false se o texto não couber no campo (incluindo o terminador nulo).
+******************************************************************************
+*/
+template <std::size_t N>
+static bool copyText(char (&destination)[N], std::string_view text)
+{
+    if (text.size() >= N) // O texto deve deixar espaço para o terminador nulo.
+    {
+        return false;
+    }
+    std::memset(destination, 0, N); // Zera o campo, para que o snapshot gerado seja sempre idêntico para a mesma entrada.
+    std::memcpy(destination, text.data(), text.size()); // Copia o texto.
+    return true;
+}
+
+/**
+******************************************************************************
+* @brief   : Lê um texto de um campo de tamanho fixo, terminado em nulo.
+******************************************************************************.
+* @param: field - O campo de origem.
+* @return: std::string_view - O texto do campo, sem o terminador nulo.
+******************************************************************************
+*/
+template <std::size_t N>
+static std::string_view readText(const char (&field)[N])
+{
+    return std::string_view(field, static_cast<std::size_t>(std::find(field, field + N, '\0') - field)); // O texto termina no primeiro nulo ou no final do campo.
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a data de modificação de um arquivo como um inteiro, na resolução do sistema de arquivos.
+******************************************************************************.
+* @param: filePath - O caminho do arquivo.
+* @return: std::int64_t - A data de modificação, ou zero se não puder ser consultada.
+******************************************************************************
+*/
+static std::int64_t writeTimeOf(const std::string& filePath)
+{
+    std::error_code error; // Erros de consulta resultam em zero, que nunca coincide com um snapshot válido.
+    auto writeTime = std::filesystem::last_write_time(filePath, error);
+    return error ? 0 : static_cast<std::int64_t>(writeTime.time_since_epoch().count());
+}
+
+/**
+******************************************************************************
+* @brief   : Seleciona as seções que recebem um registro do tipo de configuração T.
+******************************************************************************.
+* @param: sections - Os nomes das seções da origem.
+* @return: std::vector<std::string_view> - A seção do esquema (sempre presente, mesmo que ausente da origem, para reproduzir o seu erro) seguida das instâncias numeradas do mesmo tipo (instanceNumber), na ordem da origem. As demais seções, mesmo com o mesmo prefixo (como [TCP_monitor]), não recebem registros, como em parseInstances.
+******************************************************************************
+*/
+template <typename T>
+static std::vector<std::string_view> recordSections(std::span<const std::string_view> sections)
+{
+    std::vector<std::string_view> selected{ConfigSchema<T>::section}; // A seção do esquema vem sempre primeiro.
+    for (std::string_view section : sections) // Acrescenta as instâncias numeradas.
+    {
+        if (instanceNumber(section, ConfigSchema<T>::section))
+        {
+            selected.push_back(section);
+        }
+    }
+    return selected;
+}
+
+/**
+******************************************************************************
+* @brief   : Monta o registro de uma configuração TCP, com os seus valores ou o seu código de erro.
+******************************************************************************.
+* @param: section - A seção de origem.
+* @param: tcp - A configuração validada, ou o código de erro.
+* @return: std::expected<BinaryTcpRecord, ErrorCode> - O registro, ou INVALID_FORMAT se algum texto não couber nos campos de tamanho fixo.
+******************************************************************************
+*/
+static std::expected<BinaryTcpRecord, ErrorCode> makeTcpRecord(std::string_view section, const std::expected<TcpConfig, ErrorCode>& tcp)
+{
+    BinaryTcpRecord record{}; // Registro zerado, para que o snapshot gerado seja sempre idêntico para a mesma entrada.
+    if (!copyText(record.section, section)) // O nome da seção deve caber no campo de tamanho fixo.
+    {
+        return std::unexpected(ErrorCode::INVALID_FORMAT);
+    }
+    if (!tcp) // Grava o código de erro, para reproduzir o mesmo resultado na carga.
+    {
+        record.status = static_cast<std::uint32_t>(tcp.error()) + 1;
+        return record;
+    }
+    if (!copyText(record.ip, tcp->ip) || !copyText(record.protocol, tcp->protocol)) // Os textos devem caber nos campos de tamanho fixo.
+    {
+        return std::unexpected(ErrorCode::INVALID_FORMAT);
+    }
+    record.port = tcp->port;
+    return record;
+}
+
+/**
+******************************************************************************
+* @brief   : Monta o registro de uma configuração UART, análogo à função makeTcpRecord.
+******************************************************************************.
+* @param: section - A seção de origem.
+* @param: uart - A configuração validada, ou o código de erro.
+* @return: std::expected<BinaryUartRecord, ErrorCode> - O registro, ou INVALID_FORMAT se algum texto não couber nos campos de tamanho fixo.
+******************************************************************************
+*/
+static std::expected<BinaryUartRecord, ErrorCode> makeUartRecord(std::string_view section, const std::expected<UartConfig, ErrorCode>& uart)
+{
+    BinaryUartRecord record{}; // Registro zerado, para que o snapshot gerado seja sempre idêntico para a mesma entrada.
+    if (!copyText(record.section, section)) // O nome da seção deve caber no campo de tamanho fixo.
+    {
+        return std::unexpected(ErrorCode::INVALID_FORMAT);
+    }
+    if (!uart) // Grava o código de erro, para reproduzir o mesmo resultado na carga.
+    {
+        record.status = static_cast<std::uint32_t>(uart.error()) + 1;
+        return record;
+    }
+    if (!copyText(record.parity, uart->parity)) // A paridade deve caber no campo de tamanho fixo.
+    {
+        return std::unexpected(ErrorCode::INVALID_FORMAT);
+    }
+    record.baudrate = uart->baudrate;
+    record.dataBits = uart->data_bits;
+    record.stopBits = uart->stop_bits;
+    return record;
+}
+
+/**
+******************************************************************************
+* @brief   : Interpreta e valida o arquivo INI de origem e grava o snapshot binário correspondente.
+* @details : As configurações são obtidas pelo IniParser, portanto seguem exatamente as mesmas regras de validação. Além das seções [TCP] e [UART], é gravado um registro para cada instância numerada (como [UART3]). Configurações inválidas também são gravadas, com o seu código de erro, para que o snapshot reproduza os mesmos resultados do INI. O parser interpreta o mesmo conteúdo mapeado de onde vêm o tamanho e o hash, de modo que uma gravação concorrente da origem não produz um snapshot com um hash que não corresponde aos registros; a data de modificação é lida antes do mapeamento, e uma gravação depois dela faz a carga recorrer ao hash. O snapshot é publicado por replaceFile (fsync, renomeação e fsync do diretório), de modo que, mesmo depois de uma queda de energia, um leitor nunca encontra um snapshot vazio ou incompleto.
+******************************************************************************.
+* @param: sourcePath - O caminho do arquivo INI de origem.
+* @param: snapshotPath - O caminho do snapshot a ser gravado.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, FILE_OPEN_FAILED se a origem não puder ser lida ou o snapshot não puder ser gravado, ou INVALID_FORMAT se algum texto não couber nos campos de tamanho fixo.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> writeBinarySnapshot(const std::string& sourcePath, const std::string& snapshotPath)
+{
+    std::int64_t sourceWriteTime = writeTimeOf(sourcePath); // Lida antes do conteúdo: uma gravação posterior muda a data, e a carga passa a conferir o hash.
+    MappedFile source(sourcePath); // Conteúdo do arquivo de origem, usado para o hash e interpretado pelo parser.
+    if (!source.isOpen()) // A origem deve existir.
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    std::uint64_t sourceSize = source.size();
+    std::uint64_t sourceHash = hashBytes(source.view());
+
+    IniParser parser(std::move(source), sourcePath); // Interpreta e valida o conteúdo já mapeado com as mesmas regras usadas na carga do INI.
+    std::span<const std::string_view> sections = parser.sectionNames(); // Seções da origem, usadas para localizar as instâncias numeradas.
+    std::vector<BinaryTcpRecord> tcpRecords; // Registros TCP: a seção [TCP] seguida das demais seções com o mesmo prefixo.
+    std::vector<BinaryUartRecord> uartRecords; // Registros UART: a seção [UART] seguida das demais seções com o mesmo prefixo.
+
+    for (std::string_view section : recordSections<TcpConfig>(sections)) // Grava um registro por seção TCP.
+    {
+        auto record = makeTcpRecord(section, parser.parseTcpSection(section));
+        if (!record) // Os textos devem caber nos campos de tamanho fixo.
+        {
+            return std::unexpected(record.error());
+        }
+        tcpRecords.push_back(*record);
+    }
+    for (std::string_view section : recordSections<UartConfig>(sections)) // Grava um registro por seção UART.
+    {
+        auto record = makeUartRecord(section, parser.parseUartSection(section));
+        if (!record) // Os textos devem caber nos campos de tamanho fixo.
+        {
+            return std::unexpected(record.error());
+        }
+        uartRecords.push_back(*record);
+    }
+
+    std::string records; // Área de registros, que segue o cabeçalho e é coberta pelo checksum.
+    records.append(reinterpret_cast<const char*>(tcpRecords.data()), tcpRecords.size() * sizeof(BinaryTcpRecord));
+    records.append(reinterpret_cast<const char*>(uartRecords.data()), uartRecords.size() * sizeof(BinaryUartRecord));
+
+    BinarySnapshotHeader header{}; // Cabeçalho do snapshot.
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = BINARY_SNAPSHOT_VERSION;
+    header.headerSize = sizeof(BinarySnapshotHeader);
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.tcpCount = static_cast<std::uint32_t>(tcpRecords.size());
+    header.uartCount = static_cast<std::uint32_t>(uartRecords.size());
+    header.sourceSize = sourceSize;
+    header.sourceWriteTime = sourceWriteTime;
+    header.sourceHash = sourceHash;
+    header.checksum = hashBytes(records);
+
+    records.insert(0, reinterpret_cast<const char*>(&header), sizeof(header)); // O snapshot completo: cabeçalho seguido dos registros.
+    return replaceFile(snapshotPath, records); // Publica o snapshot de forma atômica e durável.
+}
+
+/**
+******************************************************************************
+* @brief   : Carrega um snapshot binário e verifica se ele pode ser usado no lugar do arquivo INI.
+* @details : O snapshot é mapeado com um único mmap. São verificados o identificador, a versão, a ordem de bytes, o tamanho e o checksum dos registros. Em seguida, a origem é comparada: se o tamanho e a data de modificação coincidirem, o snapshot é aceito sem ler o INI; se só a data for diferente (por exemplo, após uma cópia), o hash do conteúdo decide. Quando o chamador já abriu a origem (como createParser), o seu conteúdo é recebido em sourceContent e a origem não é aberta novamente.
+******************************************************************************.
+* @param: snapshotPath - O caminho do snapshot binário.
+* @param: sourcePath - O caminho do arquivo INI de origem.
+* @param: sourceContent - O conteúdo da origem já mapeado pelo chamador, ou std::nullopt para que ela seja lida pelo caminho quando necessário.
+* @return: std::expected<std::unique_ptr<IConfigParser>, ErrorCode> - O parser do snapshot, ou FILE_OPEN_FAILED se ele não existir, INVALID_FORMAT se estiver corrompido ou em outra versão, ou STALE_SNAPSHOT se não corresponder mais à origem.
+******************************************************************************
+*/
+std::expected<std::unique_ptr<IConfigParser>, ErrorCode> loadBinarySnapshot(const std::string& snapshotPath, const std::string& sourcePath, std::optional<std::string_view> sourceContent)
+{
+    MappedFile file(snapshotPath); // Mapeia o snapshot em memória.
+    if (!file.isOpen()) // O snapshot é opcional; a ausência é informada ao chamador.
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+
+    BinarySnapshotHeader header; // Cópia do cabeçalho, para não depender do alinhamento da região.
+    if (file.size() < sizeof(header)) // O arquivo deve conter pelo menos o cabeçalho.
+    {
+        return std::unexpected(ErrorCode::INVALID_FORMAT);
+    }
+    std::memcpy(&header, file.view().data(), sizeof(header));
+
+    std::uint64_t expectedSize = sizeof(header) + std::uint64_t{header.tcpCount} * sizeof(BinaryTcpRecord) + std::uint64_t{header.uartCount} * sizeof(BinaryUartRecord); // Tamanho esperado a partir das quantidades de registros.
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != BINARY_SNAPSHOT_VERSION || header.headerSize != sizeof(header) || header.byteOrder != SNAPSHOT_BYTE_ORDER || expectedSize != file.size()) // Rejeita arquivos de outro formato, versão ou plataforma, e arquivos truncados.
+    {
+        return std::unexpected(ErrorCode::INVALID_FORMAT);
+    }
+    if (hashBytes(file.view().substr(sizeof(header))) != header.checksum) // Rejeita registros corrompidos.
+    {
+        return std::unexpected(ErrorCode::INVALID_FORMAT);
+    }
+
+    std::error_code error; // Erro da consulta ao tamanho da origem.
+    std::uintmax_t sourceSize = sourceContent ? sourceContent->size() : std::filesystem::file_size(sourcePath, error); // Tamanho atual da origem.
+    if (error || sourceSize != header.sourceSize) // Uma origem ausente ou de tamanho diferente torna o snapshot desatualizado.
+    {
+        return std::unexpected(ErrorCode::STALE_SNAPSHOT);
+    }
+    if (writeTimeOf(sourcePath) != header.sourceWriteTime) // Com a data de modificação diferente, o conteúdo da origem decide.
+    {
+        if (sourceContent) // Conteúdo já mapeado pelo chamador.
+        {
+            if (hashBytes(*sourceContent) != header.sourceHash)
+            {
+                return std::unexpected(ErrorCode::STALE_SNAPSHOT);
+            }
+        }
+        else
+        {
+            MappedFile source(sourcePath);
+            if (!source.isOpen() || hashBytes(source.view()) != header.sourceHash)
+            {
+                return std::unexpected(ErrorCode::STALE_SNAPSHOT);
+            }
+        }
+    }
+
+    return std::make_unique<BinarySnapshotParser>(std::move(file), sourcePath); // O snapshot é válido e corresponde à origem.
+}
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe BinarySnapshotParser.
+* @details : Os ponteiros para os registros são calculados diretamente sobre a região mapeada; nenhum registro é copiado. Os registros são indexados pelo nome da seção, de modo que cada consulta custa O(1) mesmo com milhares de instâncias.
+******************************************************************************.
+* @param: file - O snapshot já mapeado e verificado por loadBinarySnapshot.
+* @param: sourcePath - O caminho do arquivo INI de origem, aberto somente pelas consultas que o snapshot não responde.
+******************************************************************************
+*/
+BinarySnapshotParser::BinarySnapshotParser(MappedFile file, std::string sourcePath) : m_file(std::move(file)), m_sourcePath(std::move(sourcePath))
+{
+    BinarySnapshotHeader header; // Cópia do cabeçalho, já verificado por loadBinarySnapshot.
+    std::memcpy(&header, m_file.view().data(), sizeof(header));
+    m_sourceHash = header.sourceHash;
+    const char* records = m_file.view().data() + sizeof(header); // Início da área de registros.
+
+    m_tcpCount = header.tcpCount;
+    m_uartCount = header.uartCount;
+    m_tcpRecords = reinterpret_cast<const BinaryTcpRecord*>(records); // Os registros TCP vêm primeiro.
+    m_uartRecords = reinterpret_cast<const BinaryUartRecord*>(records + m_tcpCount * sizeof(BinaryTcpRecord)); // Os registros UART vêm em seguida.
+
+    m_tcpIndex.reserve(m_tcpCount); // Indexa os registros pelo nome da seção. Em caso de nomes repetidos, o primeiro registro prevalece.
+    m_sections.reserve(m_tcpCount + m_uartCount);
+    for (std::uint32_t i = 0; i < m_tcpCount; ++i)
+    {
+        m_tcpIndex.emplace(readText(m_tcpRecords[i].section), i);
+        m_sections.push_back(readText(m_tcpRecords[i].section));
+    }
+    m_uartIndex.reserve(m_uartCount);
+    for (std::uint32_t i = 0; i < m_uartCount; ++i)
+    {
+        m_uartIndex.emplace(readText(m_uartRecords[i].section), i);
+        m_sections.push_back(readText(m_uartRecords[i].section));
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a configuração TCP gravada no registro da seção [TCP].
+******************************************************************************.
+* @return: std::expected<TcpConfig, ErrorCode> - A configuração TCP, o código de erro gravado no snapshot, ou PARSE_ERROR se não houver registro para a seção.
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> BinarySnapshotParser::parseTcp()
+{
+    return parseTcpSection(ConfigSchema<TcpConfig>::section); // Lê o registro da seção [TCP].
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a configuração UART gravada no registro da seção [UART].
+******************************************************************************.
+* @return: std::expected<UartConfig, ErrorCode> - A configuração UART, o código de erro gravado no snapshot, ou PARSE_ERROR se não houver registro para a seção.
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> BinarySnapshotParser::parseUart()
+{
+    return parseUartSection(ConfigSchema<UartConfig>::section); // Lê o registro da seção [UART].
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna os nomes das seções que possuem um registro no snapshot.
+******************************************************************************.
+* @return: std::span<const std::string_view> - Os nomes das seções dos registros TCP seguidos dos nomes das seções dos registros UART, como visões da região mapeada. A lista é montada uma única vez, no construtor.
+******************************************************************************
+*/
+std::span<const std::string_view> BinarySnapshotParser::sectionNames() const
+{
+    return m_sections;
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a configuração TCP gravada no registro de uma seção específica.
+* @details : O registro é localizado pelo índice montado no construtor, sem percorrer os demais registros.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<TcpConfig, ErrorCode> - A configuração TCP, o código de erro gravado no snapshot, ou PARSE_ERROR se não houver registro para a seção.
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> BinarySnapshotParser::parseTcpSection(std::string_view section) const
+{
+    auto found = m_tcpIndex.find(section); // Procura o registro da seção.
+    if (found == m_tcpIndex.end()) // Não há registro para a seção.
+    {
+        return std::unexpected(ErrorCode::PARSE_ERROR);
+    }
+    const BinaryTcpRecord& record = m_tcpRecords[found->second];
+    if (record.status != 0) // Reproduz o erro obtido na geração do snapshot.
+    {
+        return std::unexpected(static_cast<ErrorCode>(record.status - 1));
+    }
+    return TcpConfig{std::string(readText(record.ip)), record.port, std::string(readText(record.protocol))}; // Monta a configuração diretamente a partir do registro.
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a configuração UART gravada no registro de uma seção específica, análogo ao método parseTcpSection.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<UartConfig, ErrorCode> - A configuração UART, o código de erro gravado no snapshot, ou PARSE_ERROR se não houver registro para a seção.
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> BinarySnapshotParser::parseUartSection(std::string_view section) const
+{
+    auto found = m_uartIndex.find(section); // Procura o registro da seção.
+    if (found == m_uartIndex.end()) // Não há registro para a seção.
+    {
+        return std::unexpected(ErrorCode::PARSE_ERROR);
+    }
+    const BinaryUartRecord& record = m_uartRecords[found->second];
+    if (record.status != 0) // Reproduz o erro obtido na geração do snapshot.
+    {
+        return std::unexpected(static_cast<ErrorCode>(record.status - 1));
+    }
+    return UartConfig{record.baudrate, record.dataBits, std::string(readText(record.parity)), record.stopBits}; // Monta a configuração diretamente a partir do registro.
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna o texto de um campo inteiro dos registros.
+* @details : Na primeira chamada, todos os campos inteiros são formatados de uma só vez, em posições de tamanho fixo: a porta de cada registro TCP, seguida de baudrate, data_bits e stop_bits de cada registro UART. A carga do snapshot continua sem nenhuma conversão para quem não usa findValue.
+******************************************************************************.
+* @param: slot - A posição do campo.
+* @return: std::string_view - O texto decimal do campo, válido enquanto o parser existir.
+******************************************************************************
+*/
+std::string_view BinarySnapshotParser::numberText(std::size_t slot) const
+{
+    std::call_once(m_numbersOnce, [this]
+    {
+        m_numbers.resize((m_tcpCount + UART_NUMBERS * std::size_t{m_uartCount}) * NUMBER_SLOT);
+        std::size_t next = 0; // Próxima posição a ser formatada.
+        auto format = [this, &next](std::int32_t value)
+        {
+            char* begin = m_numbers.data() + next++ * NUMBER_SLOT;
+            char* end = std::to_chars(begin, begin + NUMBER_SLOT - 1, value).ptr; // Sempre cabe: um int32 tem no máximo 11 caracteres.
+            begin[NUMBER_SLOT - 1] = static_cast<char>(end - begin);
+        };
+        for (std::uint32_t i = 0; i < m_tcpCount; ++i)
+        {
+            format(m_tcpRecords[i].port);
+        }
+        for (std::uint32_t i = 0; i < m_uartCount; ++i)
+        {
+            format(m_uartRecords[i].baudrate);
+            format(m_uartRecords[i].dataBits);
+            format(m_uartRecords[i].stopBits);
+        }
+    });
+    const char* begin = m_numbers.data() + slot * NUMBER_SLOT;
+    return std::string_view(begin, static_cast<unsigned char>(begin[NUMBER_SLOT - 1]));
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna o parser do arquivo INI de origem, abrindo-o na primeira chamada.
+* @details : A origem é interpretada por um LazyIniParser, que só indexa as seções consultadas. Ela só é usada se o seu conteúdo ainda corresponder ao hash gravado no snapshot; uma origem alterada depois da carga não é misturada aos registros (o próximo reload a carregará por inteiro).
+******************************************************************************.
+* @return: const IConfigParser* - O parser da origem, ou nullptr se ela não puder ser aberta, não corresponder mais ao snapshot ou se a memória se esgotar.
+******************************************************************************
+*/
+const IConfigParser* BinarySnapshotParser::sourceParser() const
+{
+    std::call_once(m_sourceOnce, [this]
+    {
+        MappedFile source(m_sourcePath);
+        if (!source.isOpen() || hashBytes(source.view()) != m_sourceHash)
+        {
+            return;
+        }
+        try
+        {
+            m_source = std::make_unique<LazyIniParser>(std::move(source), m_sourcePath);
+        }
+        catch (const std::bad_alloc&) // Sem memória, as consultas seguem sem a origem.
+        {
+        }
+    });
+    return m_source.get();
+}
+
+/**
+******************************************************************************
+* @brief   : Procura o valor textual de uma chave em uma seção.
+* @details : Os campos de um registro válido (ip, port e protocol de uma seção TCP; baudrate, data_bits, parity e stop_bits de uma seção UART) são respondidos pelo próprio snapshot, com os mesmos valores de parseTcpSection e parseUartSection. As demais chaves, e as seções cujo registro guarda um erro, são procuradas no arquivo INI de origem, com as regras do IniParser.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @return: std::optional<std::string_view> - O valor, válido enquanto o parser existir, ou std::nullopt se a chave não existir (ou se a origem não puder ser usada).
+******************************************************************************
+*/
+std::optional<std::string_view> BinarySnapshotParser::findValue(std::string_view section, std::string_view key) const
+{
+    if (auto found = m_tcpIndex.find(section); found != m_tcpIndex.end() && m_tcpRecords[found->second].status == 0)
+    {
+        const BinaryTcpRecord& record = m_tcpRecords[found->second];
+        if (key == "ip")
+        {
+            return readText(record.ip);
+        }
+        if (key == "port")
+        {
+            return numberText(found->second);
+        }
+        if (key == "protocol")
+        {
+            return readText(record.protocol);
+        }
+    }
+    else if (auto found = m_uartIndex.find(section); found != m_uartIndex.end() && m_uartRecords[found->second].status == 0)
+    {
+        const BinaryUartRecord& record = m_uartRecords[found->second];
+        std::size_t slot = m_tcpCount + UART_NUMBERS * std::size_t{found->second}; // Posição de baudrate; data_bits e stop_bits vêm em seguida.
+        if (key == "baudrate")
+        {
+            return numberText(slot);
+        }
+        if (key == "data_bits")
+        {
+            return numberText(slot + 1);
+        }
+        if (key == "parity")
+        {
+            return readText(record.parity);
+        }
+        if (key == "stop_bits")
+        {
+            return numberText(slot + 2);
+        }
+    }
+    if (const IConfigParser* source = sourceParser()) // Chave que o snapshot não guarda.
+    {
+        return source->findValue(section, key);
+    }
+    return std::nullopt;
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a posição de uma chave no arquivo INI de origem, usada para descrever erros.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @return: SourceLocation - A posição do valor da chave ou do cabeçalho da seção na origem, ou uma posição vazia se a origem não puder ser usada.
+******************************************************************************
+*/
+SourceLocation BinarySnapshotParser::locate(std::string_view section, std::string_view key) const
+{
+    if (const IConfigParser* source = sourceParser())
+    {
+        return source->locate(section, key);
+    }
+    return {};
+}
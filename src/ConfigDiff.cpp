@@ -0,0 +1,156 @@
+/*
+ * ConfigDiff.cpp
+ *
+ * Implementação da comparação entre dois snapshots de configuração, seção a seção e campo a campo.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "ConfigDiff.hpp"
+#include <algorithm>
+#include <compare>
+#include <utility>
+/*----------------------------------------------------------------------------*/
+
+/**
+******************************************************************************
+* @brief   : Compara os dois valores de uma seção presente nos dois snapshots.
+* @details : Se os hashes coincidem, a seção é considerada inalterada sem que os campos sejam lidos. Caso contrário, duas configurações válidas são comparadas campo a campo; uma mudança entre válida e inválida, ou entre códigos de erro diferentes, é registrada sem máscara de campos.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: before - O valor anterior.
+* @param: after - O valor novo.
+* @param: beforeHash - O hash de conteúdo do valor anterior.
+* @param: afterHash - O hash de conteúdo do valor novo.
+* @param: diff - O resultado, que recebe a mudança ou a contagem de seções inalteradas.
+* @param: changes - A lista de mudanças do tipo da seção.
+******************************************************************************
+*/
+template <typename T>
+static void compareSection(std::string_view section, const std::expected<T, ErrorCode>& before, const std::expected<T, ErrorCode>& after, std::uint64_t beforeHash, std::uint64_t afterHash, ConfigDiff& diff, std::vector<ConfigChange<T>>& changes)
+{
+    if (beforeHash == afterHash) // O conteúdo é o mesmo; os campos não são comparados.
+    {
+        ++diff.unchanged;
+        return;
+    }
+    std::uint64_t fields = before && after ? changedFields(*before, *after) : 0;
+    if (before && after && fields == 0) // Colisão de hash: os campos são iguais.
+    {
+        ++diff.unchanged;
+        return;
+    }
+    changes.push_back(ConfigChange<T>{section, ChangeKind::MODIFIED, &before, &after, fields});
+}
+
+/**
+******************************************************************************
+* @brief   : Compara as instâncias numeradas de um tipo de configuração.
+* @details : As duas listas estão ordenadas pelo número da instância (e pelo nome, em caso de zeros à esquerda), por isso são percorridas juntas uma única vez, como em uma intercalação. O custo é linear no número de seções, e os campos só são lidos nas seções com hashes diferentes.
+******************************************************************************.
+* @param: before - As instâncias do snapshot anterior.
+* @param: after - As instâncias do snapshot novo.
+* @param: diff - O resultado.
+* @param: changes - A lista de mudanças do tipo da configuração.
+******************************************************************************
+*/
+template <typename T>
+static void compareInstances(const std::pmr::vector<ConfigInstance<T>>& before, const std::pmr::vector<ConfigInstance<T>>& after, ConfigDiff& diff, std::vector<ConfigChange<T>>& changes)
+{
+    auto order = [](const ConfigInstance<T>& instance) // Chave de ordenação das listas.
+    {
+        return std::pair(instanceNumber(instance.section, ConfigSchema<T>::section).value_or(0), std::string_view(instance.section));
+    };
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < before.size() || j < after.size())
+    {
+        std::strong_ordering comparison = std::strong_ordering::equal; // Posição relativa das instâncias correntes das duas listas.
+        if (i == before.size())
+        {
+            comparison = std::strong_ordering::greater;
+        }
+        else if (j == after.size())
+        {
+            comparison = std::strong_ordering::less;
+        }
+        else if (before[i].section != after[j].section) // Nomes iguais (o caso comum) dispensam a conversão dos números.
+        {
+            comparison = order(before[i]) <=> order(after[j]);
+        }
+        if (comparison < 0) // A instância só existe no snapshot anterior.
+        {
+            changes.push_back(ConfigChange<T>{before[i].section, ChangeKind::REMOVED, &before[i].config, nullptr, 0});
+            ++i;
+        }
+        else if (comparison > 0) // A instância só existe no snapshot novo.
+        {
+            changes.push_back(ConfigChange<T>{after[j].section, ChangeKind::ADDED, nullptr, &after[j].config, 0});
+            ++j;
+        }
+        else
+        {
+            compareSection(std::string_view(after[j].section), before[i].config, after[j].config, before[i].hash, after[j].hash, diff, changes);
+            ++i;
+            ++j;
+        }
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Compara dois snapshots seção a seção.
+* @details : As seções [TCP] e [UART] existem em todo snapshot (válidas ou com o seu código de erro) e os seus hashes são calculados aqui; as instâncias numeradas usam o hash guardado na validação. Nenhum parser é consultado: a comparação usa somente os valores já validados dos snapshots.
+******************************************************************************.
+* @param: before - O snapshot anterior.
+* @param: after - O snapshot novo.
+* @return: ConfigDiff - As mudanças, com os dois snapshots.
+******************************************************************************
+*/
+ConfigDiff diffSnapshots(std::shared_ptr<const ConfigSnapshot> before, std::shared_ptr<const ConfigSnapshot> after)
+{
+    ConfigDiff diff;
+    diff.before = std::move(before);
+    diff.after = std::move(after);
+    if (!diff.before || !diff.after || diff.before == diff.after) // Um snapshot é sempre igual a si mesmo.
+    {
+        return diff;
+    }
+    const ConfigSnapshot& previous = *diff.before;
+    const ConfigSnapshot& current = *diff.after;
+    compareSection(ConfigSchema<TcpConfig>::section, previous.tcp, current.tcp, hashConfig(previous.tcp), hashConfig(current.tcp), diff, diff.tcp);
+    compareInstances(previous.tcpInstances, current.tcpInstances, diff, diff.tcp);
+    compareSection(ConfigSchema<UartConfig>::section, previous.uart, current.uart, hashConfig(previous.uart), hashConfig(current.uart), diff, diff.uart);
+    compareInstances(previous.uartInstances, current.uartInstances, diff, diff.uart);
+    return diff;
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a mudança de uma seção TCP.
+******************************************************************************.
+* @param: section - O nome da seção (por exemplo, "TCP" ou "TCP3").
+* @return: const ConfigChange<TcpConfig>* - A mudança, ou nullptr se a seção não mudou.
+******************************************************************************
+*/
+const ConfigChange<TcpConfig>* ConfigDiff::findTcp(std::string_view section) const
+{
+    auto found = std::find_if(tcp.begin(), tcp.end(), [section](const ConfigChange<TcpConfig>& change) { return change.section == section; });
+    return found == tcp.end() ? nullptr : &*found;
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a mudança de uma seção UART.
+******************************************************************************.
+* @param: section - O nome da seção (por exemplo, "UART" ou "UART3").
+* @return: const ConfigChange<UartConfig>* - A mudança, ou nullptr se a seção não mudou.
+******************************************************************************
+*/
+const ConfigChange<UartConfig>* ConfigDiff::findUart(std::string_view section) const
+{
+    auto found = std::find_if(uart.begin(), uart.end(), [section](const ConfigChange<UartConfig>& change) { return change.section == section; });
+    return found == uart.end() ? nullptr : &*found;
+}
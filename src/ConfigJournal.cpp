@@ -0,0 +1,977 @@
+/*
+ * ConfigJournal.cpp
+ *
+ * Implementação do journal de alterações das configurações (gravação, leitura e compactação) e do parser JournaledParser, que sobrepõe as alterações ao arquivo base.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "ConfigJournal.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include "BinarySnapshot.hpp"
+#include "ConfigSchema.hpp"
+#include "IniTokenizer.hpp"
+#include "MappedFile.hpp"
+#include "ParserFactory.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CONFIG_JOURNAL_USE_POSIX 1
+#else
+#include <fstream>
+#endif
+/*----------------------------------------------------------------------------*/
+
+static_assert(sizeof(ConfigJournalHeader) == 16, "O layout do cabeçalho faz parte do formato e não pode mudar sem incrementar a versão.");
+static_assert(sizeof(ConfigJournalRecordHeader) == 16, "O layout do registro faz parte do formato e não pode mudar sem incrementar a versão.");
+
+static constexpr char JOURNAL_MAGIC[4] = {'C', 'F', 'G', 'J'}; // Identificador do formato.
+static constexpr std::uint32_t JOURNAL_BYTE_ORDER = 0x01020304; // Marca de ordem de bytes.
+static constexpr std::size_t CHECKSUM_SIZE = sizeof(ConfigJournalRecordHeader::checksum); // Bytes do checksum, que não fazem parte da área que ele cobre.
+
+// Resultado da leitura de um journal.
+struct JournalScan
+{
+    std::uint64_t validSize = 0; // Bytes do cabeçalho e dos registros válidos (zero se o cabeçalho estiver incompleto).
+    std::uint64_t records = 0; // Registros válidos.
+};
+
+/**
+******************************************************************************
+* @brief   : Retorna o caminho do journal de um arquivo de configuração.
+******************************************************************************.
+* @param: configPath - O caminho do arquivo de configuração.
+* @return: std::string - O caminho do journal.
+******************************************************************************
+*/
+std::string journalPathFor(const std::string& configPath)
+{
+    return configPath + ".journal";
+}
+
+/**
+******************************************************************************
+* @brief   : Monta o cabeçalho do journal desta versão.
+******************************************************************************.
+* @return: ConfigJournalHeader - O cabeçalho.
+******************************************************************************
+*/
+static ConfigJournalHeader makeHeader()
+{
+    ConfigJournalHeader header{};
+    std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = CONFIG_JOURNAL_VERSION;
+    header.headerSize = sizeof(ConfigJournalHeader);
+    header.byteOrder = JOURNAL_BYTE_ORDER;
+    return header;
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica o cabeçalho de um journal e percorre os seus registros.
+* @details : A leitura termina no primeiro registro incompleto ou cujo checksum não confere: é o final de uma gravação interrompida, e nada depois dele foi confirmado.
+******************************************************************************.
+* @param: content - O conteúdo do journal.
+* @param: visit - Função chamada para cada registro válido, ou nullptr para apenas contá-los.
+* @return: std::expected<JournalScan, ErrorCode> - O tamanho e a quantidade dos registros válidos, ou INVALID_FORMAT se o arquivo não for um journal desta versão.
+******************************************************************************
+*/
+static std::expected<JournalScan, ErrorCode> scanJournal(std::string_view content, const std::function<void(const JournalRecord& record)>* visit)
+{
+    JournalScan scan;
+    if (content.size() < sizeof(ConfigJournalHeader)) // Cabeçalho incompleto: o journal foi interrompido na criação e é recriado.
+    {
+        return scan;
+    }
+    ConfigJournalHeader header; // Cópia alinhada do cabeçalho.
+    std::memcpy(&header, content.data(), sizeof(header));
+    if (std::memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0 || header.version != CONFIG_JOURNAL_VERSION || header.headerSize != sizeof(ConfigJournalHeader) || header.byteOrder != JOURNAL_BYTE_ORDER)
+    {
+        return std::unexpected(ErrorCode::INVALID_FORMAT);
+    }
+
+    std::size_t position = sizeof(ConfigJournalHeader); // Início do próximo registro.
+    while (content.size() - position >= sizeof(ConfigJournalRecordHeader))
+    {
+        ConfigJournalRecordHeader record; // Cópia alinhada do cabeçalho do registro.
+        std::memcpy(&record, content.data() + position, sizeof(record));
+        std::size_t payload = std::size_t{record.sectionSize} + record.keySize + record.valueSize; // Bytes dos textos.
+        if (payload > content.size() - position - sizeof(record)) // Registro incompleto.
+        {
+            break;
+        }
+        if (hashBytes(content.substr(position + CHECKSUM_SIZE, sizeof(record) - CHECKSUM_SIZE + payload)) != record.checksum) // Registro corrompido.
+        {
+            break;
+        }
+        if (visit)
+        {
+            const char* text = content.data() + position + sizeof(record); // Início dos textos.
+            (*visit)(JournalRecord{std::string_view(text, record.sectionSize), std::string_view(text + record.sectionSize, record.keySize), std::string_view(text + record.sectionSize + record.keySize, record.valueSize)});
+        }
+        position += sizeof(record) + payload;
+        ++scan.records;
+    }
+    scan.validSize = position;
+    return scan;
+}
+
+/**
+******************************************************************************
+* @brief   : Monta um registro do journal, com o seu checksum.
+******************************************************************************.
+* @param: buffer - Recebe o registro (o conteúdo anterior é descartado).
+* @param: record - A alteração.
+******************************************************************************
+*/
+static void encodeRecord(std::string& buffer, const JournalRecord& record)
+{
+    ConfigJournalRecordHeader header{};
+    header.sectionSize = static_cast<std::uint16_t>(record.section.size());
+    header.keySize = static_cast<std::uint16_t>(record.key.size());
+    header.valueSize = static_cast<std::uint32_t>(record.value.size());
+
+    buffer.clear();
+    buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    buffer.append(record.section);
+    buffer.append(record.key);
+    buffer.append(record.value);
+    header.checksum = hashBytes(std::string_view(buffer).substr(CHECKSUM_SIZE)); // Cobre os tamanhos e os textos.
+    std::memcpy(buffer.data(), &header.checksum, CHECKSUM_SIZE);
+}
+
+#if defined(CONFIG_JOURNAL_USE_POSIX)
+/**
+******************************************************************************
+* @brief   : Espera a gravação dos dados de um arquivo no armazenamento.
+******************************************************************************.
+* @param: fd - O descritor do arquivo.
+* @return: bool - Retorna true se a sincronização foi concluída.
+******************************************************************************
+*/
+static bool syncData(int fd)
+{
+#if defined(__APPLE__)
+    return ::fsync(fd) == 0;
+#else
+    return ::fdatasync(fd) == 0; // Os metadados que não afetam a leitura (como a data de modificação) não precisam ser esperados.
+#endif
+}
+#endif
+
+/**
+******************************************************************************
+* @brief   : Incorpora alterações ao texto de um arquivo INI.
+* @details : Cada linha de uma chave alterada tem somente o valor substituído; a indentação, os espaços em volta do '=', os comentários e as demais linhas são mantidos. Uma chave alterada que não aparece na sua seção é acrescentada depois da última chave do último bloco da seção, e uma seção que não existe é acrescentada no final do arquivo.
+******************************************************************************.
+* @param: text - O texto do arquivo base.
+* @param: edits - As alterações, com o valor mais recente de cada chave.
+* @return: std::string - O novo texto.
+******************************************************************************
+*/
+static std::string mergeEdits(std::string_view text, const IniIndex& edits)
+{
+    // Alterações de uma seção e ponto do arquivo onde as chaves que faltam são acrescentadas.
+    struct SectionEdits
+    {
+        std::vector<std::size_t> entries; // Posições das alterações da seção em edits.entries().
+        std::size_t insertAt = std::string_view::npos; // Posição seguinte à última chave (ou ao cabeçalho) do último bloco da seção, ou npos se ela não existir no arquivo.
+    };
+
+    std::span<const IniEntry> entries = edits.entries();
+    std::unordered_map<std::string_view, SectionEdits> sections; // Alterações por seção.
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        sections[entries[i].section].entries.push_back(i);
+    }
+    std::vector<bool> present(entries.size(), false); // Indica as alterações cuja chave já aparece no arquivo.
+
+    // Primeira passagem: localiza as chaves alteradas e o final de cada seção alterada.
+    auto enterSection = [&sections](std::string_view name) { auto found = sections.find(name); return found != sections.end() ? &found->second : nullptr; };
+    std::string_view name; // Nome da seção corrente.
+    SectionEdits* current = enterSection(name); // Alterações da seção corrente, ou nullptr se ela não tiver nenhuma.
+    for (std::size_t position = 0; position < text.size();)
+    {
+        std::size_t end = std::min(text.find('\n', position), text.size()); // Final da linha.
+        std::size_t next = end < text.size() ? end + 1 : end; // Início da próxima linha.
+        std::string_view first;
+        std::string_view second;
+        IniLineType type = parseIniLine(text.substr(position, end - position), first, second);
+        if (type == IniLineType::SECTION)
+        {
+            name = first;
+            current = enterSection(name);
+        }
+        if (current && type != IniLineType::IGNORED)
+        {
+            current->insertAt = next;
+            if (type == IniLineType::KEY_VALUE)
+            {
+                if (const IniEntry* entry = edits.findEntry(name, first))
+                {
+                    present[static_cast<std::size_t>(entry - entries.data())] = true;
+                }
+            }
+        }
+        position = next;
+    }
+
+    // Segunda passagem: copia o texto, substituindo os valores e acrescentando as chaves que faltam.
+    std::string merged;
+    merged.reserve(text.size() + text.size() / 8 + 64);
+    auto appendMissing = [&](const SectionEdits& section)
+    {
+        if (!merged.empty() && merged.back() != '\n')
+        {
+            merged.push_back('\n');
+        }
+        for (std::size_t i : section.entries)
+        {
+            if (!present[i])
+            {
+                merged.append(entries[i].key).append("=").append(entries[i].value).append("\n");
+            }
+        }
+    };
+    name = {};
+    current = enterSection(name);
+    for (std::size_t position = 0; position < text.size();)
+    {
+        std::size_t end = std::min(text.find('\n', position), text.size());
+        std::size_t next = end < text.size() ? end + 1 : end;
+        std::string_view line = text.substr(position, next - position); // A linha, com o '\n'.
+        std::string_view first;
+        std::string_view second;
+        IniLineType type = parseIniLine(text.substr(position, end - position), first, second);
+        if (type == IniLineType::SECTION)
+        {
+            name = first;
+            current = enterSection(name);
+        }
+        std::optional<std::string_view> value = current && type == IniLineType::KEY_VALUE ? edits.find(name, first) : std::nullopt;
+        if (value) // Substitui somente o valor; second é uma visão de dentro da linha.
+        {
+            std::size_t valueBegin = static_cast<std::size_t>(second.data() - line.data());
+            merged.append(line.substr(0, valueBegin)).append(*value).append(line.substr(valueBegin + second.size()));
+        }
+        else
+        {
+            merged.append(line);
+        }
+        if (current && current->insertAt == next)
+        {
+            appendMissing(*current);
+        }
+        position = next;
+    }
+
+    for (std::string_view edited : edits.sections()) // Seções que não existem no arquivo.
+    {
+        const SectionEdits& section = sections[edited];
+        if (section.insertAt == std::string_view::npos)
+        {
+            if (!merged.empty())
+            {
+                merged.append(merged.back() == '\n' ? "\n" : "\n\n");
+            }
+            merged.append("[").append(edited).append("]\n");
+            appendMissing(section);
+        }
+    }
+    return merged;
+}
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe ConfigJournal, usado por open.
+******************************************************************************.
+* @param: configPath - O caminho do arquivo de configuração base.
+* @param: compactionThreshold - A quantidade de registros que dispara uma compactação em segundo plano.
+******************************************************************************
+*/
+ConfigJournal::ConfigJournal(const std::string& configPath, std::size_t compactionThreshold)
+    : m_configPath(configPath), m_journalPath(journalPathFor(configPath)), m_compactionThreshold(compactionThreshold), m_compactAt(compactionThreshold)
+{
+}
+
+/**
+******************************************************************************
+* @brief   : Abre (ou cria) o journal de um arquivo de configuração.
+* @details : O journal existente é verificado por inteiro; um registro incompleto no final (de uma gravação interrompida) é descartado antes que novos registros sejam acrescentados depois dele. Se compactionThreshold não for zero, a thread de compactação é iniciada.
+******************************************************************************.
+* @param: configPath - O caminho do arquivo de configuração base.
+* @param: compactionThreshold - A quantidade de registros que dispara uma compactação em segundo plano (zero desliga a compactação automática).
+* @return: std::expected<std::unique_ptr<ConfigJournal>, ErrorCode> - O journal, INVALID_FORMAT se o arquivo existente não for um journal desta versão, FILE_OPEN_FAILED se ele não puder ser aberto para gravação, ou OUT_OF_MEMORY.
+******************************************************************************
+*/
+std::expected<std::unique_ptr<ConfigJournal>, ErrorCode> ConfigJournal::open(const std::string& configPath, std::size_t compactionThreshold)
+{
+    try
+    {
+        std::unique_ptr<ConfigJournal> journal(new ConfigJournal(configPath, compactionThreshold));
+        JournalScan scan; // Registros do journal existente.
+        {
+            MappedFile file(journal->m_journalPath);
+            if (file.isOpen())
+            {
+                std::expected<JournalScan, ErrorCode> scanned = scanJournal(file.view(), nullptr);
+                if (!scanned)
+                {
+                    return std::unexpected(scanned.error());
+                }
+                scan = *scanned;
+            }
+        }
+        std::lock_guard lock(journal->m_mutex);
+        std::expected<void, ErrorCode> opened = journal->openForAppend(scan.validSize);
+        if (!opened)
+        {
+            return std::unexpected(opened.error());
+        }
+        journal->m_records = scan.records;
+        if (compactionThreshold > 0)
+        {
+            journal->m_compactor = std::jthread([raw = journal.get()](std::stop_token stopToken) { raw->run(stopToken); });
+        }
+        return journal;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Destrutor da classe ConfigJournal.
+* @details : A thread de compactação é encerrada antes do fechamento do journal; uma compactação em andamento é concluída. Os registros confirmados continuam no journal e são reaplicados na próxima abertura.
+******************************************************************************
+*/
+ConfigJournal::~ConfigJournal()
+{
+    if (m_compactor.joinable())
+    {
+        m_compactor.request_stop();
+        m_compactor.join();
+    }
+#if defined(CONFIG_JOURNAL_USE_POSIX)
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+    }
+#endif
+}
+
+/**
+******************************************************************************
+* @brief   : Descarta o final inválido do journal e o abre para acréscimos.
+* @details : Deve ser chamado sob m_mutex. Se validSize for zero, o journal é criado (ou recriado) somente com o cabeçalho. Um journal criado agora tem também o diretório sincronizado, para que a primeira alteração confirmada não se perca com a entrada do arquivo em uma queda de energia.
+******************************************************************************.
+* @param: validSize - Bytes válidos do journal existente, ou zero.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou FILE_OPEN_FAILED.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigJournal::openForAppend(std::uint64_t validSize)
+{
+#if defined(CONFIG_JOURNAL_USE_POSIX)
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+    }
+    bool created = true; // Indica se o journal foi criado por esta abertura.
+    m_fd = ::open(m_journalPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_APPEND | O_CLOEXEC, 0644); // Todas as gravações vão para o final do arquivo.
+    if (m_fd < 0 && errno == EEXIST) // O journal já existe.
+    {
+        created = false;
+        m_fd = ::open(m_journalPath.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    }
+    if (m_fd < 0)
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    struct stat status{};
+    if (::fstat(m_fd, &status) != 0 || (static_cast<std::uint64_t>(status.st_size) != validSize && ::ftruncate(m_fd, static_cast<off_t>(validSize)) != 0)) // Descarta o registro incompleto.
+    {
+        ::close(m_fd);
+        m_fd = -1;
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+#else
+    std::error_code error;
+    if (std::filesystem::exists(m_journalPath, error) && std::filesystem::file_size(m_journalPath, error) != validSize)
+    {
+        std::filesystem::resize_file(m_journalPath, validSize, error);
+        if (error)
+        {
+            return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+        }
+    }
+#endif
+    m_size = validSize;
+    if (validSize == 0) // Journal novo: grava o cabeçalho.
+    {
+        ConfigJournalHeader header = makeHeader();
+        std::expected<void, ErrorCode> written = writeRecord(std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)));
+        if (!written)
+        {
+            return written;
+        }
+    }
+#if defined(CONFIG_JOURNAL_USE_POSIX)
+    if (created && !syncDirectory(m_journalPath)) // Guarda a entrada do journal no diretório antes da primeira alteração confirmada.
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+#endif
+    return {};
+}
+
+/**
+******************************************************************************
+* @brief   : Grava um bloco no final do journal e espera a sua chegada ao armazenamento.
+* @details : Deve ser chamado sob m_mutex. Se a gravação falhar no meio, o journal é truncado de volta ao tamanho anterior, de modo que um registro não confirmado nunca fica antes dos próximos.
+******************************************************************************.
+* @param: bytes - O registro (ou o cabeçalho) já montado.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou FILE_OPEN_FAILED.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigJournal::writeRecord(std::string_view bytes)
+{
+#if defined(CONFIG_JOURNAL_USE_POSIX)
+    if (m_fd < 0)
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    if (!writeAll(m_fd, bytes) || !syncData(m_fd))
+    {
+        ::ftruncate(m_fd, static_cast<off_t>(m_size));
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+#else
+    bool written = false;
+    {
+        std::ofstream output(m_journalPath, std::ios::binary | std::ios::app);
+        output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        written = static_cast<bool>(output.flush());
+    }
+    if (!written)
+    {
+        std::error_code error;
+        std::filesystem::resize_file(m_journalPath, m_size, error);
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+#endif
+    m_size += bytes.size();
+    return {};
+}
+
+/**
+******************************************************************************
+* @brief   : Lê os registros do journal, na ordem em que foram gravados.
+* @details : As gravações e a compactação esperam o final da leitura.
+******************************************************************************.
+* @param: visit - Função chamada para cada registro. As visões do registro só valem durante a chamada.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, FILE_OPEN_FAILED se o journal não puder ser lido, ou INVALID_FORMAT.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigJournal::replay(const std::function<void(const JournalRecord& record)>& visit) const
+{
+    std::lock_guard lock(m_mutex);
+    MappedFile file(m_journalPath);
+    if (!file.isOpen() || file.size() < m_size)
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    std::expected<JournalScan, ErrorCode> scan = scanJournal(file.view().substr(0, m_size), &visit);
+    if (!scan)
+    {
+        return std::unexpected(scan.error());
+    }
+    return {};
+}
+
+/**
+******************************************************************************
+* @brief   : Lê as alterações que um parser do arquivo base em uma geração anterior não contém.
+* @details : Um parser lido antes de uma compactação não contém as alterações que ela incorporou ao arquivo base, e elas já não estão no journal; elas são entregues primeiro, com o valor mais recente de cada chave, e os registros do journal em seguida. Para um parser da geração corrente, somente os registros do journal são entregues, de modo que uma mudança do arquivo base feita depois da compactação prevalece sobre as alterações incorporadas.
+******************************************************************************.
+* @param: generation - A geração do arquivo base lida antes da criação do parser (generation).
+* @param: visit - Função chamada para cada alteração. As visões do registro só valem durante a chamada.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, FILE_OPEN_FAILED se o journal não puder ser lido, ou INVALID_FORMAT.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigJournal::replaySince(std::uint64_t generation, const std::function<void(const JournalRecord& record)>& visit) const
+{
+    std::lock_guard lock(m_mutex); // A compactação guarda as alterações incorporadas e esvazia o journal sob este mutex, por isso nenhuma alteração fica de fora.
+    for (const CompactedEdit& edit : m_compacted)
+    {
+        if (edit.generation > generation)
+        {
+            visit(JournalRecord{edit.section, edit.key, edit.value});
+        }
+    }
+    MappedFile file(m_journalPath);
+    if (!file.isOpen() || file.size() < m_size)
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    std::expected<JournalScan, ErrorCode> scan = scanJournal(file.view().substr(0, m_size), &visit);
+    if (!scan)
+    {
+        return std::unexpected(scan.error());
+    }
+    return {};
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a quantidade de alterações que replaySince entregaria.
+******************************************************************************.
+* @param: generation - A geração do arquivo base lida antes da criação do parser.
+* @return: std::uint64_t - As alterações incorporadas depois da geração, somadas aos registros do journal.
+******************************************************************************
+*/
+std::uint64_t ConfigJournal::editsSince(std::uint64_t generation) const
+{
+    std::lock_guard lock(m_mutex);
+    std::uint64_t count = m_records;
+    for (const CompactedEdit& edit : m_compacted)
+    {
+        count += edit.generation > generation ? 1 : 0;
+    }
+    return count;
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a geração do arquivo base.
+* @details : A geração é incrementada depois que uma compactação substitui o arquivo base, junto com a remoção dos registros incorporados do journal. Um parser criado depois da leitura da geração contém, portanto, todas as alterações incorporadas até ela.
+******************************************************************************.
+* @return: std::uint64_t - A geração (zero antes da primeira compactação).
+******************************************************************************
+*/
+std::uint64_t ConfigJournal::generation() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_generation;
+}
+
+/**
+******************************************************************************
+* @brief   : Acrescenta uma alteração ao journal.
+* @details : O registro é gravado com uma única chamada de escrita e sincronizado com fdatasync antes do retorno; o custo de cada alteração é o de um registro, independentemente do tamanho do arquivo de configuração. Quando o journal atinge o limite de registros, a thread de compactação é acordada.
+******************************************************************************.
+* @param: record - A alteração.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, PARSE_ERROR se algum texto exceder os limites do formato, FILE_OPEN_FAILED se a gravação falhar, ou OUT_OF_MEMORY.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigJournal::append(const JournalRecord& record)
+{
+    if (record.section.size() > UINT16_MAX || record.key.size() > UINT16_MAX || record.value.size() > UINT32_MAX)
+    {
+        return std::unexpected(ErrorCode::PARSE_ERROR);
+    }
+    std::lock_guard lock(m_mutex);
+    try
+    {
+        encodeRecord(m_buffer, record);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+    }
+    std::expected<void, ErrorCode> written = writeRecord(m_buffer);
+    if (!written)
+    {
+        return written;
+    }
+    ++m_records;
+    if (m_compactionThreshold > 0 && m_records >= m_compactAt)
+    {
+        m_wake.notify_one();
+    }
+    return {};
+}
+
+/**
+******************************************************************************
+* @brief   : Incorpora ao arquivo base os registros gravados até o momento.
+* @details : Os registros acrescentados durante a compactação não são perdidos: eles permanecem no journal. Depois de uma compactação, bem-sucedida ou não, a próxima compactação automática só acontece depois de mais compactionThreshold registros.
+******************************************************************************.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, INVALID_FORMAT se o arquivo base não for INI, FILE_OPEN_FAILED se alguma leitura ou gravação falhar, ou OUT_OF_MEMORY.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigJournal::compact()
+{
+    std::lock_guard compactLock(m_compactMutex);
+    std::expected<void, ErrorCode> result = compactRecords();
+    std::lock_guard lock(m_mutex);
+    if (result)
+    {
+        m_compactionError.reset();
+    }
+    else
+    {
+        m_compactionError = result.error();
+    }
+    m_compactAt = m_records + std::max<std::size_t>(m_compactionThreshold, 1);
+    return result;
+}
+
+/**
+******************************************************************************
+* @brief   : Etapas da compactação.
+* @details : O journal é lido até o último registro confirmado, sem bloquear as gravações, e as alterações são incorporadas ao texto do arquivo base, que é substituído de forma atômica. Somente então, sob m_mutex, o journal é reescrito com os registros acrescentados nesse meio tempo. Se o processo for interrompido entre as duas substituições, os registros já incorporados são reaplicados na próxima carga, sem nenhum efeito.
+******************************************************************************.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou o código de erro.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigJournal::compactRecords()
+{
+    try
+    {
+        std::uint64_t end = 0; // Final dos registros incorporados nesta compactação.
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_records == 0)
+            {
+                return {};
+            }
+            end = m_size;
+        }
+
+        MappedFile journal(m_journalPath);
+        if (!journal.isOpen() || journal.size() < end)
+        {
+            return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+        }
+        IniIndex edits; // Valor mais recente de cada chave, como visões do journal mapeado.
+        std::function<void(const JournalRecord& record)> collect = [&edits](const JournalRecord& record) { edits.insert(record.section, record.key, record.value); };
+        std::expected<JournalScan, ErrorCode> scan = scanJournal(journal.view().substr(0, end), &collect);
+        if (!scan)
+        {
+            return std::unexpected(scan.error());
+        }
+
+        MappedFile base(m_configPath);
+        if (!base.isOpen())
+        {
+            return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+        }
+        if (detectConfigFormat(base.view()) != ConfigFormat::INI) // Somente o texto INI é reescrito.
+        {
+            return std::unexpected(ErrorCode::INVALID_FORMAT);
+        }
+        std::expected<void, ErrorCode> replaced = replaceFile(m_configPath, mergeEdits(base.view(), edits));
+        if (!replaced)
+        {
+            return replaced;
+        }
+
+        std::lock_guard lock(m_mutex); // As gravações esperam a troca do journal.
+        MappedFile current(m_journalPath); // Inclui os registros acrescentados durante a compactação.
+        if (!current.isOpen() || current.size() < m_size)
+        {
+            return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+        }
+        ConfigJournalHeader header = makeHeader();
+        std::string rewritten(reinterpret_cast<const char*>(&header), sizeof(header)); // Cabeçalho seguido dos registros não incorporados.
+        rewritten.append(current.view().substr(end, m_size - end));
+        recordCompacted(edits, m_generation + 1); // Antes da troca do journal, que não pode mais ser desfeita. Se ela falhar, os registros continuam no journal, e entregá-los também como incorporados não muda nada.
+        replaced = replaceFile(m_journalPath, rewritten);
+        if (!replaced)
+        {
+            return replaced;
+        }
+        m_records -= scan->records;
+        ++m_compactions;
+        ++m_generation;
+        return openForAppend(rewritten.size());
+    }
+    catch (const std::bad_alloc&)
+    {
+        return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Guarda as alterações incorporadas ao arquivo base.
+* @details : Deve ser chamado sob m_mutex. Os textos são copiados; uma chave já incorporada tem apenas o valor e a geração substituídos, de modo que a memória cresce com a quantidade de chaves alteradas, e não com a quantidade de compactações.
+******************************************************************************.
+* @param: edits - As alterações incorporadas, com o valor mais recente de cada chave.
+* @param: generation - A geração do arquivo base que passou a contê-las.
+******************************************************************************
+*/
+void ConfigJournal::recordCompacted(const IniIndex& edits, std::uint64_t generation)
+{
+    m_compactedByEntry.reserve(m_compactedByEntry.size() + edits.size());
+    m_compactedIndex.reserve(m_compactedIndex.size() + edits.size());
+    for (const IniEntry& entry : edits.entries())
+    {
+        if (const IniEntry* found = m_compactedIndex.findEntry(entry.section, entry.key))
+        {
+            CompactedEdit* edit = m_compactedByEntry[static_cast<std::size_t>(found - m_compactedIndex.entries().data())];
+            edit->value.assign(entry.value);
+            edit->generation = generation;
+            m_compactedIndex.insert(edit->section, edit->key, edit->value);
+            continue;
+        }
+        CompactedEdit& edit = m_compacted.emplace_back(CompactedEdit{std::string(entry.section), std::string(entry.key), std::string(entry.value), generation});
+        m_compactedByEntry.push_back(&edit);
+        m_compactedIndex.insert(edit.section, edit.key, edit.value);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Laço da thread de compactação.
+******************************************************************************.
+* @param: stopToken - Sinal de encerramento, emitido pelo destrutor.
+******************************************************************************
+*/
+void ConfigJournal::run(std::stop_token stopToken)
+{
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            if (!m_wake.wait(lock, stopToken, [this] { return m_records >= m_compactAt; }))
+            {
+                return; // Encerramento pedido.
+            }
+        }
+        compact(); // O erro fica registrado em stats().
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna o estado do journal.
+******************************************************************************.
+* @return: JournalStats - Os registros e o tamanho do journal e o resultado das compactações.
+******************************************************************************
+*/
+JournalStats ConfigJournal::stats() const
+{
+    std::lock_guard lock(m_mutex);
+    return JournalStats{m_records, m_size, m_compactions, m_compactionError};
+}
+
+/**
+******************************************************************************
+* @brief   : Consulta a configuração de uma seção no parser base.
+******************************************************************************.
+* @param: base - O parser base.
+* @param: section - O nome da seção.
+* @return: std::expected<T, ErrorCode> - A configuração da seção, ou o código de erro do parser base.
+******************************************************************************
+*/
+template <typename T>
+static std::expected<T, ErrorCode> baseConfig(const IConfigParser& base, std::string_view section)
+{
+    if constexpr (std::is_same_v<T, TcpConfig>)
+    {
+        return base.parseTcpSection(section);
+    }
+    else
+    {
+        return base.parseUartSection(section);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe JournaledParser.
+******************************************************************************.
+* @param: base - O parser base.
+* @param: resource - O recurso de memória das alterações.
+******************************************************************************
+*/
+JournaledParser::JournaledParser(std::shared_ptr<const IConfigParser> base, std::pmr::memory_resource* resource)
+    : m_base(std::move(base)), m_storage(resource), m_storageByEntry(resource), m_edits(resource), m_sectionNames(resource)
+{
+}
+
+/**
+******************************************************************************
+* @brief   : Sobrepõe uma alteração ao parser base.
+* @details : Os textos são copiados. Uma chave já alterada tem apenas o valor substituído, de modo que a memória do parser cresce com a quantidade de chaves alteradas, e não com a quantidade de alterações reaplicadas.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @param: value - O novo valor.
+******************************************************************************
+*/
+void JournaledParser::apply(std::string_view section, std::string_view key, std::string_view value)
+{
+    if (const IniEntry* entry = m_edits.findEntry(section, key))
+    {
+        Edit* edit = m_storageByEntry[static_cast<std::size_t>(entry - m_edits.entries().data())];
+        edit->value.assign(value);
+        m_edits.insert(edit->section, edit->key, edit->value);
+        return;
+    }
+    std::pmr::memory_resource* resource = m_storage.get_allocator().resource();
+    Edit& edit = m_storage.emplace_back(Edit{std::pmr::string(section, resource), std::pmr::string(key, resource), std::pmr::string(value, resource)});
+    m_storageByEntry.push_back(&edit);
+    std::size_t sectionCount = m_edits.sections().size(); // Seções alteradas antes desta alteração.
+    m_edits.insert(edit.section, edit.key, edit.value);
+    if (m_edits.sections().size() > sectionCount) // Primeira alteração da seção: ela pode não existir no parser base.
+    {
+        std::span<const std::string_view> baseSections = m_base->sectionNames();
+        if (std::ranges::find(baseSections, std::string_view(edit.section)) == baseSections.end())
+        {
+            if (m_sectionNames.empty())
+            {
+                m_sectionNames.assign(baseSections.begin(), baseSections.end());
+            }
+            m_sectionNames.push_back(edit.section);
+        }
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Sobrepõe todas as alterações de outro parser.
+******************************************************************************.
+* @param: other - O parser de onde vêm as alterações.
+******************************************************************************
+*/
+void JournaledParser::applyEdits(const JournaledParser& other)
+{
+    m_storageByEntry.reserve(m_storageByEntry.size() + other.m_edits.size());
+    m_edits.reserve(m_edits.size() + other.m_edits.size());
+    for (const IniEntry& entry : other.m_edits.entries())
+    {
+        apply(entry.section, entry.key, entry.value);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Sobrepõe as alterações de uma seção à configuração do parser base.
+* @details : Uma seção sem alterações é entregue como está. Se a configuração do parser base for válida, cada campo alterado é substituído por updateField, com a conversão e o validador do esquema, sem consultar o texto das demais chaves (o parser base pode nem ter texto, como o snapshot binário). Se ela for inválida, a seção é montada por bindConfig, com os valores alterados e, para as demais chaves, os valores do parser base; uma alteração pode, assim, corrigir um campo inválido.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<T, ErrorCode> - A configuração com as alterações, ou PARSE_ERROR se algum campo estiver faltando ou for inválido.
+******************************************************************************
+*/
+template <typename T>
+std::expected<T, ErrorCode> JournaledParser::parseSection(std::string_view section) const
+{
+    std::expected<T, ErrorCode> config = baseConfig<T>(*m_base, section); // Configuração do parser base.
+    if (m_edits.size() == 0)
+    {
+        return config;
+    }
+    bool edited = false; // Indica se algum campo da seção foi alterado.
+    bool valid = true; // Indica se todos os valores alterados foram aceitos.
+    auto overlay = [&](std::string_view key)
+    {
+        std::optional<std::string_view> value = m_edits.find(section, key);
+        if (value)
+        {
+            edited = true;
+            valid = valid && (!config || updateField(*config, key, *value).has_value());
+        }
+    };
+    std::apply([&](const auto&... descriptors) { (overlay(descriptors.key), ...); }, ConfigSchema<T>::fields);
+    if (!edited || (!config && config.error() != ErrorCode::PARSE_ERROR)) // Sem alterações, ou erro da carga do parser base (por exemplo, OUT_OF_MEMORY).
+    {
+        return config;
+    }
+    if (config)
+    {
+        return valid ? config : std::unexpected(ErrorCode::PARSE_ERROR);
+    }
+    return bindConfig<T>([this, section](std::string_view key) { return findValue(section, key); });
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a configuração da seção [TCP], com as alterações.
+******************************************************************************.
+* @return: std::expected<TcpConfig, ErrorCode> - A configuração TCP, ou o código de erro.
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> JournaledParser::parseTcp()
+{
+    return parseSection<TcpConfig>(ConfigSchema<TcpConfig>::section);
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a configuração da seção [UART], com as alterações.
+******************************************************************************.
+* @return: std::expected<UartConfig, ErrorCode> - A configuração UART, ou o código de erro.
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> JournaledParser::parseUart()
+{
+    return parseSection<UartConfig>(ConfigSchema<UartConfig>::section);
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna os nomes das seções, com as que só existem nas alterações.
+******************************************************************************.
+* @return: std::span<const std::string_view> - Os nomes das seções.
+******************************************************************************
+*/
+std::span<const std::string_view> JournaledParser::sectionNames() const
+{
+    return m_sectionNames.empty() ? m_base->sectionNames() : std::span<const std::string_view>(m_sectionNames);
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a configuração TCP de uma seção específica, com as alterações.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<TcpConfig, ErrorCode> - A configuração TCP, ou o código de erro.
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> JournaledParser::parseTcpSection(std::string_view section) const
+{
+    return parseSection<TcpConfig>(section);
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a configuração UART de uma seção específica, com as alterações.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<UartConfig, ErrorCode> - A configuração UART, ou o código de erro.
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> JournaledParser::parseUartSection(std::string_view section) const
+{
+    return parseSection<UartConfig>(section);
+}
+
+/**
+******************************************************************************
+* @brief   : Procura o valor de uma chave, dando preferência às alterações.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @return: std::optional<std::string_view> - O valor alterado, o valor do parser base, ou std::nullopt.
+******************************************************************************
+*/
+std::optional<std::string_view> JournaledParser::findValue(std::string_view section, std::string_view key) const
+{
+    std::optional<std::string_view> value = m_edits.find(section, key);
+    return value ? value : m_base->findValue(section, key);
+}
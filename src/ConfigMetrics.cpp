@@ -0,0 +1,170 @@
+/*
+ * ConfigMetrics.cpp
+ *
+ * Implementação da instrumentação da carga e das consultas de configuração: o flag global da coleta, a leitura dos contadores e a exportação das medidas em JSON.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "ConfigMetrics.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+/*----------------------------------------------------------------------------*/
+
+#ifndef CONFIG_MANAGER_NO_METRICS
+std::atomic<bool> g_configMetricsEnabled{false};
+#endif
+
+/**
+******************************************************************************
+* @brief   : Retorna os valores correntes dos contadores.
+* @details : Cada contador é lido de forma independente; com getters sendo chamados ao mesmo tempo, a soma pode misturar instantes próximos, o que não afeta o uso em monitoramento.
+******************************************************************************.
+* @return: AccessMetrics - As contagens de chamadas.
+******************************************************************************
+*/
+AccessMetrics AccessCounters::read() const
+{
+    AccessMetrics metrics;
+    metrics.tcpConfig = tcpConfig.value.load(std::memory_order_relaxed);
+    metrics.uartConfig = uartConfig.value.load(std::memory_order_relaxed);
+    metrics.allTcpConfigs = allTcpConfigs.value.load(std::memory_order_relaxed);
+    metrics.allUartConfigs = allUartConfigs.value.load(std::memory_order_relaxed);
+    metrics.snapshot = snapshot.value.load(std::memory_order_relaxed);
+    metrics.byName = byName.value.load(std::memory_order_relaxed);
+    metrics.byHandle = byHandle.value.load(std::memory_order_relaxed);
+    return metrics;
+}
+
+/**
+******************************************************************************
+* @brief   : Grava um texto como uma string JSON, com aspas e caracteres de escape.
+******************************************************************************.
+* @param: output - O destino.
+* @param: text - O texto (por exemplo, um caminho de arquivo).
+******************************************************************************
+*/
+void writeJsonString(std::ostream& output, std::string_view text)
+{
+    output << '"';
+    for (char character : text)
+    {
+        switch (character)
+        {
+        case '"':
+            output << "\\\"";
+            break;
+        case '\\':
+            output << "\\\\";
+            break;
+        case '\n':
+            output << "\\n";
+            break;
+        case '\t':
+            output << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(character) < 0x20) // Demais caracteres de controle.
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(character));
+                output << escaped;
+            }
+            else
+            {
+                output << character;
+            }
+        }
+    }
+    output << '"';
+}
+
+/**
+******************************************************************************
+* @brief   : Formata as medidas como um objeto JSON.
+* @details : O formato é estável e plano o bastante para ser lido por coletores de monitoramento: "load" traz os tempos de cada fase (em nanossegundos), os bytes, as linhas e o pico de memória; "last_error" traz o código, o arquivo, a seção, a chave, a linha e a coluna do primeiro erro da última carga (ou null); "access" traz a contagem de chamadas de cada acessor e a fração das leituras de chaves avulsas feitas por identificador.
+******************************************************************************.
+* @param: metrics - As medidas.
+* @return: std::string - O objeto JSON, terminado por '\n'.
+******************************************************************************
+*/
+std::string formatMetricsJson(const ConfigMetrics& metrics)
+{
+    std::ostringstream output;
+    const LoadMetrics& load = metrics.lastLoad;
+    output << "{\n  \"enabled\": " << (metrics.enabled ? "true" : "false")
+           << ",\n  \"loads\": " << metrics.loads
+           << ",\n  \"rejected_loads\": " << metrics.rejectedLoads
+           << ",\n  \"load\": {\"io_ns\": " << load.ioNs
+           << ", \"tokenize_ns\": " << load.tokenizeNs
+           << ", \"validation_ns\": " << load.validationNs
+           << ", \"binding_ns\": " << load.bindingNs
+           << ", \"bytes\": " << load.bytes
+           << ", \"lines\": " << load.lines
+           << ", \"peak_memory_bytes\": " << load.peakMemoryBytes << "}"
+           << ",\n  \"last_error\": ";
+    if (metrics.lastError)
+    {
+        const ErrorReport& error = *metrics.lastError;
+        output << "{\"code\": ";
+        writeJsonString(output, errorCodeToString(error.code));
+        output << ", \"file\": ";
+        writeJsonString(output, error.location.file);
+        output << ", \"section\": ";
+        writeJsonString(output, error.section);
+        output << ", \"key\": ";
+        writeJsonString(output, error.key);
+        output << ", \"line\": " << error.location.line << ", \"column\": " << error.location.column << "}";
+    }
+    else
+    {
+        output << "null";
+    }
+    const AccessMetrics& access = metrics.access;
+    output << ",\n  \"access\": {\"get_tcp_config\": " << access.tcpConfig
+           << ", \"get_uart_config\": " << access.uartConfig
+           << ", \"get_all_tcp_configs\": " << access.allTcpConfigs
+           << ", \"get_all_uart_configs\": " << access.allUartConfigs
+           << ", \"get_snapshot\": " << access.snapshot
+           << ", \"get_by_name\": " << access.byName
+           << ", \"get_by_handle\": " << access.byHandle
+           << ", \"handle_read_ratio\": " << access.handleReadRatio() << "}\n}\n";
+    return output.str();
+}
+
+/**
+******************************************************************************
+* @brief   : Grava as medidas em um arquivo JSON.
+* @details : O conteúdo é gravado em um arquivo temporário ao lado do destino e publicado com uma renomeação, como os snapshots binários, de modo que um coletor que lê o arquivo periodicamente nunca vê um conteúdo pela metade.
+******************************************************************************.
+* @param: metrics - As medidas.
+* @param: filePath - O caminho do arquivo.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou FILE_OPEN_FAILED se o arquivo não puder ser gravado.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> writeMetricsFile(const ConfigMetrics& metrics, const std::string& filePath)
+{
+    std::string temporaryPath = filePath + ".tmp"; // Arquivo temporário, renomeado somente depois de completo.
+    {
+        std::ofstream output(temporaryPath, std::ios::trunc);
+        output << formatMetricsJson(metrics);
+        if (!output.flush())
+        {
+            std::remove(temporaryPath.c_str());
+            return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+        }
+    }
+    std::error_code error; // Erro da renomeação.
+    std::filesystem::rename(temporaryPath, filePath, error); // Publica o arquivo de forma atômica.
+    if (error)
+    {
+        std::remove(temporaryPath.c_str());
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    return {};
+}
@@ -0,0 +1,201 @@
+/*
+ * ConfigWatcher.cpp
+ *
+ * Implementação da classe ConfigWatcher, responsável pelo modo opcional de recarga automática (hot reload) da configuração.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "ConfigWatcher.hpp"
+#include <chrono>
+#include <filesystem>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+/*----------------------------------------------------------------------------*/
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe ConfigWatcher, usado por start. Não observa o arquivo.
+******************************************************************************.
+* @param: manager - O ConfigurationManager que recebe as novas configurações. Deve viver mais que o ConfigWatcher.
+* @param: filePath - O caminho do arquivo de configuração a ser observado.
+* @param: factory - Função que cria um parser a partir do caminho do arquivo (por exemplo, createParser).
+******************************************************************************
+*/
+ConfigWatcher::ConfigWatcher(ConfigurationManager& manager, std::string filePath, ParserFactory factory)
+    : m_manager(manager), m_filePath(std::move(filePath)), m_factory(std::move(factory))
+{
+}
+
+/**
+******************************************************************************
+* @brief   : Registra a observação do arquivo e inicia a thread de fundo.
+* @details : A observação é registrada antes do retorno, na thread do chamador; uma alteração feita logo depois de start não é perdida enquanto a thread de fundo inicia.
+******************************************************************************.
+* @param: manager - O ConfigurationManager que recebe as novas configurações. Deve viver mais que o ConfigWatcher.
+* @param: filePath - O caminho do arquivo de configuração a ser observado.
+* @param: factory - Função que cria um parser a partir do caminho do arquivo (por exemplo, createParser).
+* @return: std::expected<std::unique_ptr<ConfigWatcher>, ErrorCode> - O ConfigWatcher, FILE_OPEN_FAILED se o arquivo não puder ser observado, ou OUT_OF_MEMORY.
+******************************************************************************
+*/
+std::expected<std::unique_ptr<ConfigWatcher>, ErrorCode> ConfigWatcher::start(ConfigurationManager& manager, std::string filePath, ParserFactory factory)
+{
+    try
+    {
+        std::unique_ptr<ConfigWatcher> watcher(new ConfigWatcher(manager, std::move(filePath), std::move(factory)));
+        std::expected<void, ErrorCode> watched = watcher->watch(); // Registra a observação antes de iniciar a thread.
+        if (!watched)
+        {
+            return std::unexpected(watched.error());
+        }
+        watcher->m_thread = std::jthread([raw = watcher.get()](std::stop_token stopToken) { raw->run(stopToken); }); // Inicia a thread de fundo somente depois que todos os membros foram inicializados.
+        return watcher;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Destrutor da classe ConfigWatcher, que solicita a parada da thread de fundo, espera o seu término e libera a observação.
+******************************************************************************
+*/
+ConfigWatcher::~ConfigWatcher()
+{
+    m_thread.request_stop(); // Solicita a parada; a thread verifica o pedido pelo menos a cada 250 ms.
+    if (m_thread.joinable()) // Espera a thread terminar antes de destruir os demais membros.
+    {
+        m_thread.join();
+    }
+#if defined(__linux__)
+    if (m_fd >= 0) // Libera a instância do inotify.
+    {
+        ::close(m_fd);
+    }
+#endif
+}
+
+/**
+******************************************************************************
+* @brief   : Registra a observação do arquivo.
+* @details : No Linux, o diretório do arquivo é observado com inotify, o que também detecta substituições por renomeação (editores e gravações atômicas). Nas demais plataformas, guarda a data de modificação atual, com a qual a thread de fundo compara as consultas seguintes.
+******************************************************************************.
+* @return: std::expected<void, ErrorCode> - Vazio se a observação foi registrada, ou FILE_OPEN_FAILED.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigWatcher::watch()
+{
+    std::filesystem::path path(m_filePath); // Caminho do arquivo observado.
+#if defined(__linux__)
+    std::filesystem::path directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path("."); // Diretório que contém o arquivo.
+    m_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC); // Cria a instância do inotify em modo não bloqueante.
+    if (m_fd < 0) // Sem inotify não há como observar o arquivo.
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    if (::inotify_add_watch(m_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) // Observa o fechamento após escrita e as renomeações no diretório.
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED); // O descritor é fechado pelo destrutor.
+    }
+#else
+    std::error_code error; // Um arquivo ausente é aceito: ele pode ser criado depois, como no Linux.
+    m_lastWrite = std::filesystem::last_write_time(path, error);
+    if (!std::filesystem::is_directory(path.has_parent_path() ? path.parent_path() : std::filesystem::path("."), error)) // Sem o diretório não há o que observar.
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+#endif
+    return {};
+}
+
+/**
+******************************************************************************
+* @brief   : Cria um parser para o arquivo observado e tenta publicar a nova configuração.
+* @details : Se o parser não puder ser criado ou se a nova configuração for inválida, o ConfigurationManager mantém o último snapshot válido e a recarga é contabilizada como rejeitada.
+******************************************************************************
+*/
+void ConfigWatcher::reload()
+{
+    std::uint64_t generation = m_manager.journalGeneration(); // Lida antes do arquivo: se uma compactação o reescrever nesse meio tempo, as alterações incorporadas por ela continuam sobrepostas.
+    auto parser = m_factory(m_filePath); // Cria o parser a partir do arquivo alterado.
+    if (parser && m_manager.reload(std::move(*parser), generation)) // Publica a nova configuração somente se o parser foi criado e a configuração é válida.
+    {
+        m_reloadCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    else // Caso contrário, o último snapshot válido continua sendo servido.
+    {
+        m_rejectedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Laço da thread de fundo, que espera alterações no arquivo e dispara as recargas.
+* @details : No Linux, os eventos do diretório registrado por watch são lidos do inotify. Apenas os eventos de fechamento após escrita e de renomeação para o nome do arquivo disparam uma recarga, evitando interpretar arquivos escritos pela metade; um transbordo da fila do inotify (IN_Q_OVERFLOW) também dispara uma recarga, pois os eventos perdidos podem ser do arquivo. Nas demais plataformas, a data de modificação do arquivo é consultada periodicamente.
+******************************************************************************.
+* @param: stopToken - Token usado para encerrar o laço.
+******************************************************************************
+*/
+void ConfigWatcher::run(std::stop_token stopToken)
+{
+#if defined(__linux__)
+    std::string fileName = std::filesystem::path(m_filePath).filename().string(); // Nome do arquivo, usado para filtrar os eventos do diretório.
+
+    alignas(inotify_event) char buffer[4096]; // Buffer para os eventos lidos do inotify.
+    while (!stopToken.stop_requested()) // Executa até que a parada seja solicitada.
+    {
+        pollfd descriptor{m_fd, POLLIN, 0}; // Espera eventos no descritor do inotify.
+        if (::poll(&descriptor, 1, 250) <= 0) // Acorda pelo menos a cada 250 ms para verificar o pedido de parada.
+        {
+            continue;
+        }
+
+        bool changed = false; // Indica se algum evento se refere ao arquivo observado.
+        ssize_t length; // Quantidade de bytes lidos do inotify.
+        while ((length = ::read(m_fd, buffer, sizeof(buffer))) > 0) // Consome todos os eventos pendentes, agrupando rajadas de escrita em uma única recarga.
+        {
+            for (char* cursor = buffer; cursor < buffer + length;) // Percorre os eventos lidos.
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(cursor);
+                if (event->mask & IN_Q_OVERFLOW) // A fila do inotify transbordou e eventos foram perdidos: um deles pode ser do arquivo observado.
+                {
+                    changed = true;
+                }
+                else if (event->len > 0 && fileName == event->name) // Considera apenas os eventos do arquivo observado.
+                {
+                    changed = true;
+                }
+                cursor += sizeof(inotify_event) + event->len; // Avança para o próximo evento.
+            }
+        }
+
+        if (changed) // Recarrega a configuração uma única vez por rajada de eventos.
+        {
+            reload();
+        }
+    }
+#else
+    std::filesystem::path path(m_filePath); // Caminho do arquivo observado.
+    std::error_code error; // Erros de consulta são ignorados: o arquivo pode estar sendo substituído.
+    while (!stopToken.stop_requested()) // Executa até que a parada seja solicitada.
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(250)); // Consulta o arquivo a cada 250 ms.
+        auto currentWrite = std::filesystem::last_write_time(path, error); // Data de modificação atual.
+        if (!error && currentWrite != m_lastWrite) // Recarrega quando a data de modificação mudar.
+        {
+            m_lastWrite = currentWrite;
+            reload();
+        }
+    }
+#endif
+}
@@ -9,36 +9,182 @@
 
 /* Includes ------------------------------------------------------------------*/
  #include "ConfigurationManager.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "ConfigSchema.hpp"
+#include "IniTokenizer.hpp"
 /*----------------------------------------------------------------------------*/
 
+/**
+******************************************************************************
+* @brief   : Interpreta e valida, em paralelo, todas as instâncias numeradas de uma configuração.
+* @details : As seções cujo nome é o prefixo do esquema seguido de dígitos são ordenadas pelo número da instância, e o vetor de resultados é alocado de uma só vez antes do laço paralelo. Cada iteração escreve somente na sua própria posição, de modo que o resultado não depende da quantidade de threads nem da ordem em que elas terminam.
+******************************************************************************.
+* @param: sections - Os nomes das seções do arquivo.
+* @param: pool - As threads usadas na validação.
+* @param: resource - O recurso de memória das listas e dos nomes das seções.
+* @param: parse - A função que interpreta e valida uma seção.
+* @return: std::pmr::vector<ConfigInstance<T>> - As instâncias, em ordem numérica crescente.
+******************************************************************************
+*/
+template <typename T, typename Parse>
+static std::pmr::vector<ConfigInstance<T>> parseInstances(std::span<const std::string_view> sections, ThreadPool& pool, std::pmr::memory_resource* resource, Parse parse)
+{
+    std::pmr::vector<std::pair<std::uint64_t, std::string_view>> numbered(resource); // Pares (número da instância, nome da seção).
+    for (std::string_view section : sections) // Seleciona as seções numeradas deste tipo de configuração.
+    {
+        if (auto number = instanceNumber(section, ConfigSchema<T>::section))
+        {
+            numbered.emplace_back(*number, section);
+        }
+    }
+    std::sort(numbered.begin(), numbered.end()); // Ordena pelo número da instância (e pelo nome, em caso de zeros à esquerda).
+
+    std::pmr::vector<ConfigInstance<T>> instances(resource); // Resultado alocado de uma só vez, antes do laço paralelo.
+    instances.reserve(numbered.size());
+    for (const auto& [number, section] : numbered) // Os nomes são copiados para o recurso de memória antes do laço, pela thread chamadora.
+    {
+        instances.push_back(ConfigInstance<T>{std::pmr::string(section, resource), std::unexpected(ErrorCode::UNKNOWN_ERROR)});
+    }
+    auto body = [&](std::size_t i) // Cada iteração interpreta e valida uma seção e grava o resultado na sua própria posição.
+    {
+        instances[i].config = parse(numbered[i].second);
+        instances[i].hash = hashConfig(instances[i].config);
+    };
+    pool.parallelFor(numbered.size(), std::ref(body)); // O std::function guarda apenas a referência, sem alocar.
+    return instances;
+}
+
 /**
 ******************************************************************************
 * @brief   : Implementação da classe ConfigurationManager, responsável por gerenciar a configuração do sistema, fornecendo uma interface para acessar os dados de configuração de forma segura e fácil de usar.
-* @details : A classe ConfigurationManager utiliza um parser (que implementa a interface IConfigParser) para ler os dados do arquivo de configuração e fornece métodos para acessar as configurações específicas, como TCP e UART. O construtor da classe recebe um ponteiro único para o parser, garantindo que o recurso seja gerenciado corretamente e evitando vazamentos de memória.
+* @details : A classe ConfigurationManager utiliza um parser (que implementa a interface IConfigParser) para ler os dados do arquivo de configuração uma única vez, memorizando os resultados em um snapshot imutável, e fornece métodos para acessar as configurações específicas, como TCP e UART. O construtor da classe recebe um ponteiro único para o parser, garantindo que o recurso seja gerenciado corretamente e evitando vazamentos de memória.
 ******************************************************************************.
 * @param: parser - Um ponteiro único para um objeto que implementa a interface IConfigParser, usado para ler os dados de configuração do arquivo.
+* @param: threadCount - A quantidade de threads usadas para validar as seções numeradas.
+* @param: resource - O recurso de memória dos snapshots.
 ******************************************************************************
 */
-ConfigurationManager::ConfigurationManager(std::unique_ptr<IConfigParser> parser)
+ConfigurationManager::ConfigurationManager(std::unique_ptr<IConfigParser> parser, unsigned threadCount, std::pmr::memory_resource* resource)
+    : m_resource(resource),
+      m_pool(threadCount), // Cria as threads de validação uma única vez; elas são reaproveitadas em cada reload.
+      m_bindings(resource),
+      m_snapshot(buildSnapshot(std::move(parser), m_pool, m_resource, {}, configMetricsEnabled() ? &m_loadMetrics.lastLoad : nullptr)), // Transfere a propriedade do parser para o snapshot e interpreta e valida as configurações uma única vez, memorizando os resultados e os erros.
+      m_subscriptions(resource)
 {
-    m_parser = std::move(parser); // Inicializa o membro m_parser com o parser fornecido, usando std::move para transferir a propriedade do parser para a classe ConfigurationManager. Isso garante que o parser seja gerenciado corretamente e evita cópias desnecessárias.
+    if (configMetricsEnabled()) // A primeira carga é sempre publicada, mesmo com configurações inválidas; o primeiro erro é registrado para diagnóstico.
+    {
+        std::shared_ptr<const ConfigSnapshot> snapshot = m_snapshot.load();
+        recordLoad(m_loadMetrics.lastLoad, firstFailure(*snapshot, true), false);
+    }
 }
 
 /**
 ******************************************************************************
-* @brief   : Método para obter a configuração TCP. Ele chama o método parseTcp do parser para ler os dados de configuração TCP do arquivo e retorna um std::expected contendo a configuração TCP ou um código de erro, permitindo que o chamador lide com falhas.
-* @details : O método get_tcp_config verifica se o parser foi inicializado corretamente antes de chamar o método parseTcp. Se o parser não estiver disponível, ele retorna um código de erro desconhecido. Caso contrário, ele delega a leitura da configuração TCP para o parser e retorna o resultado, que pode ser a configuração TCP ou um código de erro específico, dependendo do sucesso ou falha da operação.
+* @brief   : Retorna o snapshot usado quando o recurso de memória se esgota.
+* @details : O snapshot é estático e compartilhado por meio do construtor de aliasing do std::shared_ptr, sem bloco de controle; portanto, retorná-lo não exige nenhuma alocação.
 ******************************************************************************.
-* @return: std::expected<TcpConfig, ErrorCode> - Retorna um std::expected contendo a configuração TCP ou um código de erro.
+* @return: std::shared_ptr<const ConfigSnapshot> - Um snapshot com OUT_OF_MEMORY nas configurações TCP e UART e sem instâncias.
+******************************************************************************
+*/
+static std::shared_ptr<const ConfigSnapshot> outOfMemorySnapshot()
+{
+    static const ConfigSnapshot snapshot{std::unexpected(ErrorCode::OUT_OF_MEMORY), std::unexpected(ErrorCode::OUT_OF_MEMORY), {}, {}, nullptr, {}}; // Sem instâncias, sem parser e sem valores de chaves registradas.
+    return std::shared_ptr<const ConfigSnapshot>(std::shared_ptr<const void>(), &snapshot);
+}
+
+/**
+******************************************************************************
+* @brief   : Monta o snapshot imutável com as configurações validadas.
+* @details : Cada configuração é interpretada uma única vez pelo parser. Os erros também são memorizados, de modo que chamadas repetidas aos getters retornam sempre o mesmo resultado sem refazer o trabalho. As seções numeradas ([TCP0], [UART0], ...) são validadas em paralelo pelas threads do pool, e cada chave registrada com intern é convertida uma única vez. Se o parser não estiver disponível, todas as configurações recebem um código de erro desconhecido. O snapshot, o seu bloco de controle, o bloco de controle do parser, as listas de instâncias, os valores e os nomes das seções vêm do recurso de memória; se ele se esgotar, o resultado é o snapshot de OUT_OF_MEMORY (e o parser é destruído).
+******************************************************************************.
+* @param: parser - O parser usado para ler as configurações, ou nullptr. O snapshot passa a ser o seu dono.
+* @param: pool - As threads usadas para validar as seções numeradas.
+* @param: resource - O recurso de memória do snapshot.
+* @param: bindings - As chaves registradas com intern, na ordem dos identificadores.
+* @param: metrics - Recebe as medidas da carga (as do parser, mais a validação e a montagem), ou nullptr para não medir.
+* @return: std::shared_ptr<const ConfigSnapshot> - O snapshot com os resultados de cada configuração.
 ******************************************************************************
 */
-std::expected<TcpConfig, ErrorCode> ConfigurationManager::get_tcp_config() 
+std::shared_ptr<const ConfigSnapshot> ConfigurationManager::buildSnapshot(std::unique_ptr<IConfigParser> parser, ThreadPool& pool, std::pmr::memory_resource* resource, std::span<const KeyBinding> bindings, LoadMetrics* metrics)
 {
-    if (!m_parser) // Verifica se o parser foi inicializado corretamente antes de chamar o método parseTcp. Se o parser não estiver disponível, ele retorna um código de erro desconhecido.
+    std::pmr::polymorphic_allocator<> allocator(resource); // Alocador do snapshot e dos blocos de controle.
+    try // Os recursos de memória sinalizam o esgotamento com std::bad_alloc; ele é convertido em um código de erro memorizado no snapshot.
+    {
+        IConfigParser* source = parser.get(); // Parser consultado durante a montagem.
+        std::shared_ptr<const IConfigParser> owner; // Compartilha o parser entre os leitores do snapshot.
+        if (source)
+        {
+            owner = std::shared_ptr<const IConfigParser>(parser.release(), std::default_delete<IConfigParser>(), allocator); // Se a alocação do bloco de controle falhar, o parser é destruído.
+        }
+
+        if (!source) // Verifica se o parser foi inicializado corretamente. Se o parser não estiver disponível, as configurações recebem um código de erro desconhecido.
+        {
+            std::pmr::vector<KeyValue> values(resource);
+            for (const KeyBinding& binding : bindings)
+            {
+                values.push_back(binding.resolve(nullptr, binding.section, binding.key));
+            }
+            return std::allocate_shared<ConfigSnapshot>(allocator, ConfigSnapshot{std::unexpected(ErrorCode::UNKNOWN_ERROR), std::unexpected(ErrorCode::UNKNOWN_ERROR),
+                std::pmr::vector<ConfigInstance<TcpConfig>>(resource), std::pmr::vector<ConfigInstance<UartConfig>>(resource), nullptr, std::move(values)});
+        }
+        MetricsClock::time_point start; // Início da fase corrente, lido somente quando a carga é medida.
+        if (metrics)
+        {
+            *metrics = source->loadMetrics(); // Fases feitas pelo parser na sua construção.
+            start = MetricsClock::now();
+        }
+
+        std::expected<TcpConfig, ErrorCode> tcp = source->parseTcp(); // Interpreta e valida a configuração TCP uma única vez.
+        std::expected<UartConfig, ErrorCode> uart = source->parseUart(); // Interpreta e valida a configuração UART uma única vez.
+
+        std::span<const std::string_view> sections = source->sectionNames(); // Seções do arquivo, usadas para localizar as instâncias numeradas.
+        auto tcpInstances = parseInstances<TcpConfig>(sections, pool, resource, [source](std::string_view section) { return source->parseTcpSection(section); });
+        auto uartInstances = parseInstances<UartConfig>(sections, pool, resource, [source](std::string_view section) { return source->parseUartSection(section); });
+        if (metrics)
+        {
+            metrics->validationNs = metricsElapsedNs(start);
+            start = MetricsClock::now();
+        }
+
+        std::pmr::vector<KeyValue> values(resource); // Valores das chaves registradas, convertidos uma única vez.
+        values.reserve(bindings.size());
+        for (const KeyBinding& binding : bindings)
+        {
+            values.push_back(binding.resolve(source, binding.section, binding.key));
+        }
+        std::shared_ptr<const ConfigSnapshot> snapshot = std::allocate_shared<ConfigSnapshot>(allocator, ConfigSnapshot{std::move(tcp), std::move(uart), std::move(tcpInstances), std::move(uartInstances), std::move(owner), std::move(values)}); // As listas são movidas junto com o seu recurso de memória.
+        if (metrics)
+        {
+            metrics->bindingNs = metricsElapsedNs(start);
+        }
+        return snapshot;
+    }
+    catch (const std::bad_alloc&)
     {
-        return std::unexpected(ErrorCode::UNKNOWN_ERROR); // Retorna um código de erro desconhecido se o parser não estiver disponível, garantindo que o método sempre retorne um std::expected válido, mesmo em casos de falha.
+        return outOfMemorySnapshot();
     }
-    return m_parser->parseTcp(); // Delegar a leitura da configuração TCP para o parser e retorna o resultado, que pode ser a configuração TCP ou um código de erro específico, dependendo do sucesso ou falha da operação.
+}
+
+/**
+******************************************************************************
+* @brief   : Método para obter a configuração TCP. Ele retorna o resultado memorizado no snapshot, que pode ser a configuração TCP ou um código de erro, permitindo que o chamador lide com falhas.
+* @details : O método get_tcp_config não consulta o parser: a configuração foi interpretada e validada uma única vez no construtor. O custo da chamada é apenas a cópia de uma estrutura pequena, sem nenhum lock, o que a torna adequada para laços de reconexão executados em várias threads. Para acesso sem nenhuma cópia, use get_snapshot.
+******************************************************************************.
+* @return: std::expected<TcpConfig, ErrorCode> - Retorna um std::expected contendo a configuração TCP ou um código de erro.
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> ConfigurationManager::get_tcp_config() const
+{
+    AccessCounters::count(m_counters.tcpConfig);
+    return m_snapshot.read([](const ConfigSnapshot& snapshot) { return snapshot.tcp; }); // Retorna o resultado memorizado (configuração ou erro) sem interpretar o arquivo novamente.
 }
 
 /**
@@ -49,11 +195,798 @@ std::expected<TcpConfig, ErrorCode> ConfigurationManager::get_tcp_config()
 * @return: std::expected<UartConfig, ErrorCode> - Retorna um std::expected contendo a configuração UART ou um código de erro.
 ******************************************************************************
 */
-std::expected<UartConfig, ErrorCode> ConfigurationManager::get_uart_config() 
+std::expected<UartConfig, ErrorCode> ConfigurationManager::get_uart_config() const
+{
+    AccessCounters::count(m_counters.uartConfig);
+    return m_snapshot.read([](const ConfigSnapshot& snapshot) { return snapshot.uart; }); // Retorna o resultado memorizado (configuração ou erro) sem interpretar o arquivo novamente.
+}
+
+/**
+******************************************************************************
+* @brief   : Método para obter todas as instâncias TCP declaradas em seções numeradas ([TCP0], [TCP1], ...).
+* @details : O vetor faz parte do snapshot imutável e é compartilhado sem nenhuma cópia: o std::shared_ptr retornado mantém o snapshot inteiro válido enquanto o chamador o utilizar. Cada instância traz o nome da sua seção e a configuração validada ou o seu código de erro, de modo que uma instância inválida não esconde as demais.
+******************************************************************************.
+* @return: std::shared_ptr<const std::pmr::vector<ConfigInstance<TcpConfig>>> - As instâncias TCP, em ordem numérica crescente.
+******************************************************************************
+*/
+std::shared_ptr<const std::pmr::vector<ConfigInstance<TcpConfig>>> ConfigurationManager::get_all_tcp_configs() const
+{
+    AccessCounters::count(m_counters.allTcpConfigs);
+    std::shared_ptr<const ConfigSnapshot> snapshot = m_snapshot.load(); // Snapshot corrente.
+    return std::shared_ptr<const std::pmr::vector<ConfigInstance<TcpConfig>>>(snapshot, &snapshot->tcpInstances); // Compartilha o vetor, mantendo o snapshot vivo (construtor de aliasing).
+}
+
+/**
+******************************************************************************
+* @brief   : Método para obter todas as instâncias UART declaradas em seções numeradas, análogo ao método get_all_tcp_configs.
+******************************************************************************.
+* @return: std::shared_ptr<const std::pmr::vector<ConfigInstance<UartConfig>>> - As instâncias UART, em ordem numérica crescente.
+******************************************************************************
+*/
+std::shared_ptr<const std::pmr::vector<ConfigInstance<UartConfig>>> ConfigurationManager::get_all_uart_configs() const
+{
+    AccessCounters::count(m_counters.allUartConfigs);
+    std::shared_ptr<const ConfigSnapshot> snapshot = m_snapshot.load(); // Snapshot corrente.
+    return std::shared_ptr<const std::pmr::vector<ConfigInstance<UartConfig>>>(snapshot, &snapshot->uartInstances); // Compartilha o vetor, mantendo o snapshot vivo (construtor de aliasing).
+}
+
+/**
+******************************************************************************
+* @brief   : Método para obter o snapshot completo das configurações, sem nenhuma cópia.
+* @details : O snapshot é imutável e compartilhado; o std::shared_ptr retornado o mantém válido enquanto o chamador o utilizar, mesmo que um reload publique outro snapshot nesse meio tempo. As configurações TCP e UART de um mesmo snapshot sempre vêm do mesmo arquivo.
+******************************************************************************.
+* @return: std::shared_ptr<const ConfigSnapshot> - O snapshot com as configurações TCP e UART (ou os seus códigos de erro).
+******************************************************************************
+*/
+std::shared_ptr<const ConfigSnapshot> ConfigurationManager::get_snapshot() const
+{
+    AccessCounters::count(m_counters.snapshot);
+    return m_snapshot.load(); // Compartilha o snapshot imutável com o chamador.
+}
+
+/**
+******************************************************************************
+* @brief   : Descreve uma configuração inválida: a sua seção, a primeira chave rejeitada pelo esquema e a posição dela no arquivo.
+* @details : A chave é encontrada repetindo bindConfig com uma consulta que registra cada chave pedida: como bindConfig para no primeiro campo ausente ou inválido, a última chave consultada é a rejeitada. O trabalho só é feito para descrever erros, com a instrumentação ligada.
+******************************************************************************.
+* @param: code - O código de erro da configuração.
+* @param: section - A seção da configuração.
+* @param: parser - O parser do snapshot, ou nullptr.
+* @return: ErrorReport - A descrição do erro.
+******************************************************************************
+*/
+template <typename T>
+static ErrorReport describeFailure(ErrorCode code, std::string_view section, const IConfigParser* parser)
+{
+    ErrorReport report{code, std::string(section), {}, {}};
+    if (!parser)
+    {
+        return report;
+    }
+    std::string_view failedKey; // Última chave consultada pelo esquema.
+    if (code == ErrorCode::PARSE_ERROR && !bindConfig<T>([&](std::string_view key) { failedKey = key; return parser->findValue(section, key); }))
+    {
+        report.key = failedKey;
+    }
+    report.location = parser->locate(section, report.key);
+    return report;
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a primeira configuração inválida de um snapshot, na ordem em que reload as verifica.
+* @details : As seções [TCP] e [UART] só são exigidas quando o arquivo não declara instâncias numeradas do mesmo tipo; em seguida, todas as instâncias devem ser válidas.
+******************************************************************************.
+* @param: snapshot - O snapshot a ser verificado.
+* @param: describe - Se true, a seção, a chave e a posição do erro também são preenchidas; caso contrário, somente o código (sem nenhuma alocação).
+* @return: std::optional<ErrorReport> - A primeira configuração inválida, ou std::nullopt se o snapshot puder ser publicado.
+******************************************************************************
+*/
+std::optional<ErrorReport> ConfigurationManager::firstFailure(const ConfigSnapshot& snapshot, bool describe)
+{
+    const IConfigParser* parser = snapshot.parser.get(); // Parser consultado para descrever o erro.
+    if (!snapshot.tcp && snapshot.tcpInstances.empty()) // A configuração TCP é inválida e não há instâncias numeradas.
+    {
+        return describe ? describeFailure<TcpConfig>(snapshot.tcp.error(), ConfigSchema<TcpConfig>::section, parser) : ErrorReport{snapshot.tcp.error(), {}, {}, {}};
+    }
+    if (!snapshot.uart && snapshot.uartInstances.empty()) // A configuração UART é inválida e não há instâncias numeradas.
+    {
+        return describe ? describeFailure<UartConfig>(snapshot.uart.error(), ConfigSchema<UartConfig>::section, parser) : ErrorReport{snapshot.uart.error(), {}, {}, {}};
+    }
+    for (const ConfigInstance<TcpConfig>& instance : snapshot.tcpInstances) // Qualquer instância TCP inválida.
+    {
+        if (!instance.config)
+        {
+            return describe ? describeFailure<TcpConfig>(instance.config.error(), instance.section, parser) : ErrorReport{instance.config.error(), {}, {}, {}};
+        }
+    }
+    for (const ConfigInstance<UartConfig>& instance : snapshot.uartInstances) // Qualquer instância UART inválida.
+    {
+        if (!instance.config)
+        {
+            return describe ? describeFailure<UartConfig>(instance.config.error(), instance.section, parser) : ErrorReport{instance.config.error(), {}, {}, {}};
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+******************************************************************************
+* @brief   : Guarda as medidas de uma carga.
+******************************************************************************.
+* @param: load - As medidas da carga.
+* @param: failure - A primeira configuração inválida da carga, ou std::nullopt.
+* @param: rejected - Indica se a carga foi rejeitada (um reload com configurações inválidas).
+******************************************************************************
+*/
+void ConfigurationManager::recordLoad(const LoadMetrics& load, std::optional<ErrorReport> failure, bool rejected)
+{
+    std::lock_guard lock(m_metricsMutex);
+    ++m_loadMetrics.loads;
+    m_loadMetrics.rejectedLoads += rejected ? 1 : 0;
+    m_loadMetrics.lastLoad = load;
+    m_loadMetrics.lastError = std::move(failure);
+}
+
+/**
+******************************************************************************
+* @brief   : Método para obter as medidas da instrumentação.
+* @details : As medidas das cargas são copiadas sob um mutex próprio, que nunca é adquirido pelos getters. As contagens de chamadas são lidas dos contadores atômicos.
+******************************************************************************.
+* @return: ConfigMetrics - As medidas da última carga medida e as contagens de chamadas desde a construção.
+******************************************************************************
+*/
+ConfigMetrics ConfigurationManager::metrics() const
+{
+    ConfigMetrics result;
+    {
+        std::lock_guard lock(m_metricsMutex);
+        result = m_loadMetrics;
+    }
+    result.enabled = configMetricsEnabled();
+    result.access = m_counters.read();
+    return result;
+}
+
+/**
+******************************************************************************
+* @brief   : Método para gravar as medidas da instrumentação em um arquivo JSON.
+******************************************************************************.
+* @param: filePath - O caminho do arquivo. Ele é substituído de forma atômica.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou FILE_OPEN_FAILED se o arquivo não puder ser gravado.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigurationManager::writeMetrics(const std::string& filePath) const
+{
+    return writeMetricsFile(metrics(), filePath);
+}
+
+/**
+******************************************************************************
+* @brief   : Método para substituir a configuração a partir de um novo parser.
+* @details : O novo snapshot é construído por completo antes de ser publicado. As seções [TCP] e [UART] só são exigidas quando o arquivo não declara instâncias numeradas do mesmo tipo. Se alguma configuração ou instância for inválida, o snapshot é descartado, o último snapshot válido continua sendo servido e o código de erro é retornado. Caso contrário, ele é publicado com uma troca atômica: as threads leitoras passam a ver o novo snapshot por inteiro, sem nunca observar uma configuração aplicada pela metade. Se houver assinaturas, o novo snapshot é comparado com o publicado (diffSnapshots) antes da publicação, e os callbacks das seções que mudaram são chamados depois dela, ainda sob m_reloadMutex, de modo que as notificações de reloads sucessivos chegam na ordem das publicações. Sem assinaturas, nada é comparado. As alterações feitas com set são sobrepostas ao novo parser por um JournaledParser: com o journal aberto, as feitas antes de openJournal, seguidas das que o arquivo lido pelo parser não contém (ConfigJournal::replaySince); sem o journal, todas as feitas com set. Assim, um parser lido antes de uma compactação concorrente continua recebendo as alterações que ela incorporou, e um parser lido depois dela não as recebe, de modo que uma mudança posterior do arquivo prevalece, como depois de um reinício.
+******************************************************************************.
+* @param: parser - O parser com a nova configuração.
+* @param: generation - A geração do arquivo base lida antes da criação do parser (journalGeneration), ou std::nullopt para a geração corrente.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou o código de erro da primeira configuração inválida.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigurationManager::reload(std::unique_ptr<IConfigParser> parser, std::optional<std::uint64_t> generation)
+{
+    std::lock_guard lock(m_reloadMutex); // Serializa os reloads; os getters não são afetados.
+
+    std::uint64_t since = 0; // Geração do arquivo lido pelo parser.
+    bool overlay = m_journaled != nullptr; // Indica se há alterações a sobrepor ao novo arquivo.
+    if (m_journal) // As alterações do journal são relidas dele, pois as incorporadas ao arquivo que o parser já leu não devem ser sobrepostas.
+    {
+        since = generation.value_or(m_journal->generation());
+        overlay = m_unjournaled || m_journal->editsSince(since) > 0;
+    }
+    if (overlay && parser)
+    {
+        try
+        {
+            auto journaled = std::make_unique<JournaledParser>(std::shared_ptr<const IConfigParser>(parser.release(), std::default_delete<IConfigParser>(), std::pmr::polymorphic_allocator<>(m_resource)), m_resource);
+            if (!m_journal)
+            {
+                journaled->applyEdits(*m_journaled);
+            }
+            else
+            {
+                if (m_unjournaled)
+                {
+                    journaled->applyEdits(*m_unjournaled);
+                }
+                std::expected<void, ErrorCode> replayed = m_journal->replaySince(since, [&journaled](const JournalRecord& record) { journaled->apply(record.section, record.key, record.value); });
+                if (!replayed)
+                {
+                    return replayed;
+                }
+            }
+            parser = std::move(journaled);
+        }
+        catch (const std::bad_alloc&)
+        {
+            return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+        }
+    }
+
+    bool measure = configMetricsEnabled(); // Decidido uma única vez por carga.
+    LoadMetrics load; // Medidas da carga, preenchidas somente com a instrumentação ligada.
+    std::shared_ptr<const ConfigSnapshot> snapshot = buildSnapshot(std::move(parser), m_pool, m_resource, m_bindings, measure ? &load : nullptr); // Interpreta e valida a nova configuração fora da visão dos leitores, resolvendo novamente as chaves registradas.
+    std::optional<ErrorReport> failure = firstFailure(*snapshot, measure); // Primeira configuração inválida, que impede a publicação.
+    if (measure)
+    {
+        recordLoad(load, failure, failure.has_value());
+    }
+    if (failure) // Rejeita o arquivo, mantendo o último snapshot válido.
+    {
+        return std::unexpected(failure->code);
+    }
+
+    std::expected<PendingPublication, ErrorCode> publication = preparePublication(snapshot); // Sem a comparação, os assinantes não seriam notificados; o arquivo é rejeitado.
+    if (!publication)
+    {
+        return std::unexpected(publication.error());
+    }
+    m_journaled = overlay ? std::static_pointer_cast<const JournaledParser>(snapshot->parser) : nullptr; // O novo parser carrega as alterações que ainda valem.
+    publish(std::move(snapshot), *publication);
+    return {};
+}
+
+/**
+******************************************************************************
+* @brief   : Prepara a publicação de um snapshot.
+* @details : As assinaturas são copiadas e, se houver alguma, o snapshot é comparado com o publicado (diffSnapshots). Tudo o que pode falhar acontece aqui, antes da troca; sem assinaturas, nada é comparado.
+******************************************************************************.
+* @param: snapshot - O snapshot a ser publicado.
+* @return: std::expected<PendingPublication, ErrorCode> - As assinaturas e as mudanças, ou OUT_OF_MEMORY se o recurso de memória se esgotou.
+******************************************************************************
+*/
+std::expected<ConfigurationManager::PendingPublication, ErrorCode> ConfigurationManager::preparePublication(const std::shared_ptr<const ConfigSnapshot>& snapshot)
+{
+    try
+    {
+        PendingPublication publication{std::pmr::vector<std::shared_ptr<const Subscription>>(m_resource), ConfigDiff{}};
+        {
+            std::lock_guard subscriptionLock(m_subscriptionMutex);
+            publication.subscriptions.assign(m_subscriptions.begin(), m_subscriptions.end());
+        }
+        if (!publication.subscriptions.empty())
+        {
+            publication.diff = diffSnapshots(m_snapshot.load(), snapshot); // O snapshot publicado só muda sob m_reloadMutex.
+        }
+        return publication;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Publica um snapshot e notifica os assinantes.
+* @details : Os callbacks das seções que mudaram são chamados depois da publicação, ainda sob m_reloadMutex, de modo que as notificações de publicações sucessivas chegam na ordem em que elas aconteceram.
+******************************************************************************.
+* @param: snapshot - O snapshot a ser publicado.
+* @param: publication - As assinaturas e as mudanças preparadas por preparePublication.
+******************************************************************************
+*/
+void ConfigurationManager::publish(std::shared_ptr<const ConfigSnapshot> snapshot, const PendingPublication& publication)
+{
+    m_snapshot.store(std::move(snapshot)); // Publica o novo snapshot, junto com o seu parser, com uma troca atômica. O parser anterior é destruído quando o último snapshot que o usa for liberado.
+    notify(publication.diff, publication.subscriptions);
+}
+
+/**
+******************************************************************************
+* @brief   : Chama o callback de cada assinatura cuja seção mudou.
+* @details : As mudanças e as assinaturas são poucas em comparação com as seções do arquivo, por isso a busca é feita por comparação direta dos nomes.
+******************************************************************************.
+* @param: diff - As mudanças do reload.
+* @param: subscriptions - As assinaturas ativas quando o reload começou a publicação.
+******************************************************************************
+*/
+void ConfigurationManager::notify(const ConfigDiff& diff, std::span<const std::shared_ptr<const Subscription>> subscriptions)
 {
-    if (!m_parser) // Verifica se o parser foi inicializado corretamente antes de chamar o método parseUart. Se o parser não estiver disponível, ele retorna um código de erro desconhecido.
+    for (const ConfigChange<TcpConfig>& change : diff.tcp)
     {
-        return std::unexpected(ErrorCode::UNKNOWN_ERROR); // Retorna um código de erro desconhecido se o parser não estiver disponível, garantindo que o método sempre retorne um std::expected válido, mesmo em casos de falha.
+        for (const std::shared_ptr<const Subscription>& subscription : subscriptions)
+        {
+            if (subscription->tcp && subscription->section == change.section)
+            {
+                subscription->tcp(change);
+            }
+        }
     }
-    return m_parser->parseUart(); // Delegar a leitura da configuração UART para o parser e retorna o resultado, que pode ser a configuração UART ou um código de erro específico, dependendo do sucesso ou falha da operação.
-}
\ No newline at end of file
+    for (const ConfigChange<UartConfig>& change : diff.uart)
+    {
+        for (const std::shared_ptr<const Subscription>& subscription : subscriptions)
+        {
+            if (subscription->uart && subscription->section == change.section)
+            {
+                subscription->uart(change);
+            }
+        }
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Registra uma assinatura das mudanças de uma seção.
+******************************************************************************.
+* @param: section - A seção assinada.
+* @param: tcp - O callback, se a seção for TCP.
+* @param: uart - O callback, se a seção for UART.
+* @return: std::expected<SubscriptionId, ErrorCode> - O identificador da assinatura, ou OUT_OF_MEMORY se o recurso de memória se esgotou (nesse caso, nada é registrado).
+******************************************************************************
+*/
+std::expected<SubscriptionId, ErrorCode> ConfigurationManager::addSubscription(std::string section, TcpChangeCallback tcp, UartChangeCallback uart)
+{
+    std::lock_guard lock(m_subscriptionMutex);
+    try
+    {
+        SubscriptionId id = m_nextSubscription;
+        m_subscriptions.push_back(std::allocate_shared<Subscription>(std::pmr::polymorphic_allocator<>(m_resource), Subscription{id, std::move(section), std::move(tcp), std::move(uart)}));
+        ++m_nextSubscription;
+        return id;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Método para ser notificado quando a seção [TCP] mudar em um reload.
+* @details : O callback é chamado pela thread que executa o reload (por exemplo, a thread do ConfigWatcher), depois da publicação do novo snapshot, somente se a configuração TCP mudou: um reload com o mesmo conteúdo não gera notificações. O callback recebe os valores anterior e novo e a máscara dos campos que mudaram. Ele pode chamar os getters, subscribe* e unsubscribe, mas não reload nem intern (que esperariam pelo próprio reload), e não deve lançar exceções.
+******************************************************************************.
+* @param: callback - A função chamada a cada mudança.
+* @return: std::expected<SubscriptionId, ErrorCode> - O identificador da assinatura, ou OUT_OF_MEMORY.
+******************************************************************************
+*/
+std::expected<SubscriptionId, ErrorCode> ConfigurationManager::subscribeTcp(TcpChangeCallback callback)
+{
+    return subscribeTcpSection(std::string(ConfigSchema<TcpConfig>::section), std::move(callback));
+}
+
+/**
+******************************************************************************
+* @brief   : Método para ser notificado quando a seção [UART] mudar em um reload, análogo ao método subscribeTcp.
+******************************************************************************.
+* @param: callback - A função chamada a cada mudança.
+* @return: std::expected<SubscriptionId, ErrorCode> - O identificador da assinatura, ou OUT_OF_MEMORY.
+******************************************************************************
+*/
+std::expected<SubscriptionId, ErrorCode> ConfigurationManager::subscribeUart(UartChangeCallback callback)
+{
+    return subscribeUartSection(std::string(ConfigSchema<UartConfig>::section), std::move(callback));
+}
+
+/**
+******************************************************************************
+* @brief   : Método para ser notificado quando uma seção TCP específica mudar em um reload.
+* @details : Vale para [TCP] e para as instâncias numeradas ([TCP0], [TCP1], ...). O acréscimo de uma instância chega com kind igual a ADDED e before nulo; a remoção, com REMOVED e after nulo. As mesmas regras de subscribeTcp se aplicam ao callback.
+******************************************************************************.
+* @param: section - O nome da seção (por exemplo, "TCP3").
+* @param: callback - A função chamada a cada mudança.
+* @return: std::expected<SubscriptionId, ErrorCode> - O identificador da assinatura, ou OUT_OF_MEMORY.
+******************************************************************************
+*/
+std::expected<SubscriptionId, ErrorCode> ConfigurationManager::subscribeTcpSection(std::string section, TcpChangeCallback callback)
+{
+    return addSubscription(std::move(section), std::move(callback), nullptr);
+}
+
+/**
+******************************************************************************
+* @brief   : Método para ser notificado quando uma seção UART específica mudar em um reload, análogo ao método subscribeTcpSection.
+******************************************************************************.
+* @param: section - O nome da seção (por exemplo, "UART3").
+* @param: callback - A função chamada a cada mudança.
+* @return: std::expected<SubscriptionId, ErrorCode> - O identificador da assinatura, ou OUT_OF_MEMORY.
+******************************************************************************
+*/
+std::expected<SubscriptionId, ErrorCode> ConfigurationManager::subscribeUartSection(std::string section, UartChangeCallback callback)
+{
+    return addSubscription(std::move(section), nullptr, std::move(callback));
+}
+
+/**
+******************************************************************************
+* @brief   : Método para cancelar uma assinatura.
+* @details : Depois do retorno, o callback não é chamado por nenhum reload que comece a publicação em seguida. Um reload que já copiou a lista de assinaturas ainda pode chamá-lo uma última vez.
+******************************************************************************.
+* @param: id - O identificador retornado pela assinatura.
+* @return: bool - Retorna true se a assinatura foi cancelada, ou false se ela não existia.
+******************************************************************************
+*/
+bool ConfigurationManager::unsubscribe(SubscriptionId id)
+{
+    std::lock_guard lock(m_subscriptionMutex);
+    auto found = std::find_if(m_subscriptions.begin(), m_subscriptions.end(), [id](const std::shared_ptr<const Subscription>& subscription) { return subscription->id == id; });
+    if (found == m_subscriptions.end())
+    {
+        return false;
+    }
+    m_subscriptions.erase(found);
+    return true;
+}
+
+/**
+******************************************************************************
+* @brief   : Copia uma lista de instâncias para o recurso de memória indicado.
+* @details : A cópia de um std::pmr::vector não propaga o recurso para os nomes das seções (ConfigInstance não é um tipo ciente de alocadores), por isso cada nome é copiado explicitamente.
+******************************************************************************.
+* @param: instances - As instâncias a copiar.
+* @param: resource - O recurso de memória da cópia.
+* @return: std::pmr::vector<ConfigInstance<T>> - A cópia.
+******************************************************************************
+*/
+template <typename T>
+static std::pmr::vector<ConfigInstance<T>> copyInstances(const std::pmr::vector<ConfigInstance<T>>& instances, std::pmr::memory_resource* resource)
+{
+    std::pmr::vector<ConfigInstance<T>> copy(resource);
+    copy.reserve(instances.size());
+    for (const ConfigInstance<T>& instance : instances)
+    {
+        copy.push_back(ConfigInstance<T>{std::pmr::string(instance.section, resource), instance.config, instance.hash});
+    }
+    return copy;
+}
+
+/**
+******************************************************************************
+* @brief   : Registra uma chave e publica um snapshot com o seu valor.
+* @details : Se a chave já estiver registrada com o mesmo tipo, o registro existente é reaproveitado. Caso contrário, o snapshot corrente é copiado, com o valor da nova chave convertido a partir do seu parser, e publicado com uma troca atômica; as configurações não são interpretadas novamente. Os reloads seguintes resolvem a chave junto com as demais.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @param: resolve - A conversão para o tipo pedido.
+* @return: std::expected<std::uint32_t, ErrorCode> - A posição do valor em ConfigSnapshot::values, ou OUT_OF_MEMORY se o recurso de memória se esgotou (nesse caso, nada é registrado).
+******************************************************************************
+*/
+std::expected<std::uint32_t, ErrorCode> ConfigurationManager::internKey(std::string_view section, std::string_view key, KeyResolver resolve)
+{
+    std::lock_guard lock(m_reloadMutex); // Serializa o registro com os reloads, que também leem m_bindings e publicam snapshots.
+
+    for (std::size_t i = 0; i < m_bindings.size(); ++i) // O registro é feito poucas vezes, por isso a busca linear basta.
+    {
+        if (m_bindings[i].resolve == resolve && m_bindings[i].section == section && m_bindings[i].key == key)
+        {
+            return static_cast<std::uint32_t>(i);
+        }
+    }
+
+    std::size_t slot = m_bindings.size(); // Posição da nova chave.
+    try
+    {
+        m_bindings.push_back(KeyBinding{std::pmr::string(section, m_resource), std::pmr::string(key, m_resource), resolve});
+
+        std::shared_ptr<const ConfigSnapshot> current = m_snapshot.load(); // Snapshot copiado; só muda sob m_reloadMutex.
+        std::pmr::vector<KeyValue> values(current->values.begin(), current->values.end(), m_resource);
+        values.reserve(m_bindings.size());
+        for (std::size_t i = values.size(); i < m_bindings.size(); ++i) // O snapshot de OUT_OF_MEMORY não guarda nenhum valor; as chaves que faltam são resolvidas aqui.
+        {
+            values.push_back(m_bindings[i].resolve(current->parser.get(), m_bindings[i].section, m_bindings[i].key));
+        }
+        m_snapshot.store(std::allocate_shared<ConfigSnapshot>(std::pmr::polymorphic_allocator<>(m_resource), ConfigSnapshot{current->tcp, current->uart,
+            copyInstances(current->tcpInstances, m_resource), copyInstances(current->uartInstances, m_resource), current->parser, std::move(values)}));
+    }
+    catch (const std::bad_alloc&)
+    {
+        if (m_bindings.size() > slot) // Desfaz o registro; o snapshot corrente continua sendo servido.
+        {
+            m_bindings.pop_back();
+        }
+        return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+    }
+    return static_cast<std::uint32_t>(slot);
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a configuração de uma seção, pelo tipo.
+******************************************************************************.
+* @param: parser - O parser consultado.
+* @param: section - O nome da seção.
+* @return: std::expected<T, ErrorCode> - A configuração da seção, ou o código de erro.
+******************************************************************************
+*/
+template <typename T>
+static std::expected<T, ErrorCode> parseConfigSection(const IConfigParser& parser, std::string_view section)
+{
+    if constexpr (std::is_same_v<T, TcpConfig>)
+    {
+        return parser.parseTcpSection(section);
+    }
+    else
+    {
+        return parser.parseUartSection(section);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Substitui (ou acrescenta, na ordem numérica) uma instância em uma lista de instâncias.
+******************************************************************************.
+* @param: instances - A lista, em ordem numérica crescente.
+* @param: section - O nome da seção da instância.
+* @param: config - A nova configuração.
+* @param: resource - O recurso de memória do nome da seção.
+******************************************************************************
+*/
+template <typename T>
+static void storeInstance(std::pmr::vector<ConfigInstance<T>>& instances, std::string_view section, const T& config, std::pmr::memory_resource* resource)
+{
+    auto orderOf = [](std::string_view name) { return std::pair(instanceNumber(name, ConfigSchema<T>::section).value_or(0), name); }; // Mesma ordem de parseInstances.
+    auto position = std::lower_bound(instances.begin(), instances.end(), orderOf(section), [&orderOf](const ConfigInstance<T>& instance, const auto& order) { return orderOf(instance.section) < order; });
+    std::expected<T, ErrorCode> value(config);
+    if (position != instances.end() && position->section == section)
+    {
+        position->config = std::move(value);
+        position->hash = hashConfig(position->config);
+        return;
+    }
+    std::uint64_t hash = hashConfig(value);
+    instances.insert(position, ConfigInstance<T>{std::pmr::string(section, resource), std::move(value), hash});
+}
+
+/**
+******************************************************************************
+* @brief   : Abre o journal do arquivo de configuração e reaplica as alterações gravadas nele.
+* @details : Os registros são sobrepostos, em ordem, ao parser do snapshot corrente por um JournaledParser; cada chave guarda somente o valor mais recente, de modo que reaplicar muitas alterações da mesma chave custa uma busca e uma cópia por registro. O snapshot resultante é montado e verificado como em reload, e só é publicado se todas as configurações forem válidas. As alterações feitas com set antes da abertura continuam sobrepostas, sob as do journal, mas não são gravadas nele.
+******************************************************************************.
+* @param: configPath - O caminho do arquivo de configuração base (o journal fica em journalPathFor(configPath)).
+* @param: compactionThreshold - A quantidade de registros que dispara uma compactação em segundo plano (zero desliga a compactação automática).
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, o erro da abertura do journal, o erro da primeira configuração inválida, ou UNKNOWN_ERROR se o journal já estiver aberto ou o snapshot corrente não tiver parser.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigurationManager::openJournal(const std::string& configPath, std::size_t compactionThreshold)
+{
+    std::lock_guard lock(m_reloadMutex);
+    std::shared_ptr<const ConfigSnapshot> current = m_snapshot.load(); // Snapshot sobre o qual o journal é reaplicado; só muda sob m_reloadMutex.
+    if (m_journal || !current->parser)
+    {
+        return std::unexpected(ErrorCode::UNKNOWN_ERROR);
+    }
+    std::expected<std::unique_ptr<ConfigJournal>, ErrorCode> journal = ConfigJournal::open(configPath, compactionThreshold);
+    if (!journal)
+    {
+        return std::unexpected(journal.error());
+    }
+
+    bool measure = configMetricsEnabled(); // Decidido uma única vez por carga.
+    LoadMetrics load; // Medidas da carga, preenchidas somente com a instrumentação ligada.
+    std::unique_ptr<JournaledParser> parser; // Alterações do journal sobrepostas ao parser corrente.
+    try
+    {
+        parser = std::make_unique<JournaledParser>(m_journaled ? m_journaled->base() : current->parser, m_resource);
+        if (m_journaled) // Alterações anteriores à abertura, sob as do journal, na mesma ordem em que reload as sobrepõe.
+        {
+            parser->applyEdits(*m_journaled);
+        }
+        std::expected<void, ErrorCode> replayed = (*journal)->replay([&parser](const JournalRecord& record) { parser->apply(record.section, record.key, record.value); });
+        if (!replayed)
+        {
+            return replayed;
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+    }
+    if (parser->editCount() == 0) // Journal vazio: o snapshot corrente continua valendo.
+    {
+        m_journal = std::move(*journal);
+        return {};
+    }
+
+    std::shared_ptr<const ConfigSnapshot> snapshot = buildSnapshot(std::move(parser), m_pool, m_resource, m_bindings, measure ? &load : nullptr);
+    std::optional<ErrorReport> failure = firstFailure(*snapshot, measure); // Primeira configuração inválida, que impede a publicação.
+    if (measure)
+    {
+        recordLoad(load, failure, failure.has_value());
+    }
+    if (failure)
+    {
+        return std::unexpected(failure->code);
+    }
+    std::expected<PendingPublication, ErrorCode> publication = preparePublication(snapshot);
+    if (!publication)
+    {
+        return std::unexpected(publication.error());
+    }
+    m_unjournaled = m_journaled;
+    m_journaled = std::static_pointer_cast<const JournaledParser>(snapshot->parser);
+    m_journal = std::move(*journal);
+    publish(std::move(snapshot), *publication);
+    return {};
+}
+
+/**
+******************************************************************************
+* @brief   : Valida, grava no journal e publica a alteração de um campo.
+* @details : A alteração é sobreposta, junto com as anteriores, ao parser base, e a seção é interpretada novamente com as mesmas regras da carga; somente uma configuração válida segue adiante. O novo snapshot é uma cópia do publicado com a configuração da seção substituída e com as chaves registradas resolvidas no novo parser. Tudo o que pode falhar por falta de memória acontece antes da gravação no journal, e a publicação acontece somente depois que o registro chega ao armazenamento: uma alteração confirmada ao chamador nunca se perde, e uma alteração recusada nunca é gravada.
+******************************************************************************.
+* @param: section - O nome da seção ([TCP], [UART] ou uma instância numerada).
+* @param: key - O nome da chave, que deve pertencer ao esquema de T.
+* @param: value - O novo valor textual.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, PARSE_ERROR, FILE_OPEN_FAILED, OUT_OF_MEMORY, ou UNKNOWN_ERROR se o snapshot corrente não tiver parser.
+******************************************************************************
+*/
+template <typename T>
+std::expected<void, ErrorCode> ConfigurationManager::setField(std::string_view section, std::string_view key, std::string_view value)
+{
+    bool known = false; // Indica se a chave pertence ao esquema.
+    std::apply([&](const auto&... descriptors) { ((known = known || descriptors.key == key), ...); }, ConfigSchema<T>::fields);
+    if (!known || value != trimIni(value) || value.find_first_of("\r\n") != std::string_view::npos) // O valor precisa sobreviver, sem mudanças, à releitura do arquivo INI.
+    {
+        return std::unexpected(ErrorCode::PARSE_ERROR);
+    }
+
+    std::lock_guard lock(m_reloadMutex); // Serializa as alterações com os reloads; os getters não são afetados.
+    std::shared_ptr<const ConfigSnapshot> current = m_snapshot.load(); // Snapshot copiado; só muda sob m_reloadMutex.
+    if (!current->parser)
+    {
+        return std::unexpected(ErrorCode::UNKNOWN_ERROR);
+    }
+    try
+    {
+        std::pmr::polymorphic_allocator<> allocator(m_resource);
+        std::shared_ptr<JournaledParser> parser = std::allocate_shared<JournaledParser>(allocator, m_journaled ? m_journaled->base() : current->parser, m_resource);
+        if (m_journaled)
+        {
+            parser->applyEdits(*m_journaled);
+        }
+        parser->apply(section, key, value);
+        std::expected<T, ErrorCode> config = parseConfigSection<T>(*parser, section); // Mesmas regras e mesmos validadores da carga.
+        if (!config)
+        {
+            return std::unexpected(config.error());
+        }
+
+        ConfigSnapshot next{current->tcp, current->uart, copyInstances(current->tcpInstances, m_resource), copyInstances(current->uartInstances, m_resource), parser, std::pmr::vector<KeyValue>(m_resource)};
+        if (section == ConfigSchema<T>::section)
+        {
+            if constexpr (std::is_same_v<T, TcpConfig>)
+            {
+                next.tcp = *config;
+            }
+            else
+            {
+                next.uart = *config;
+            }
+        }
+        else if constexpr (std::is_same_v<T, TcpConfig>)
+        {
+            storeInstance(next.tcpInstances, section, *config, m_resource);
+        }
+        else
+        {
+            storeInstance(next.uartInstances, section, *config, m_resource);
+        }
+        next.values.reserve(m_bindings.size());
+        for (const KeyBinding& binding : m_bindings) // As visões dos valores devem apontar para o novo parser.
+        {
+            next.values.push_back(binding.resolve(parser.get(), binding.section, binding.key));
+        }
+        std::shared_ptr<const ConfigSnapshot> snapshot = std::allocate_shared<ConfigSnapshot>(allocator, std::move(next));
+        std::expected<PendingPublication, ErrorCode> publication = preparePublication(snapshot);
+        if (!publication)
+        {
+            return std::unexpected(publication.error());
+        }
+        if (m_journal)
+        {
+            std::expected<void, ErrorCode> appended = m_journal->append(JournalRecord{section, key, value});
+            if (!appended)
+            {
+                return appended;
+            }
+        }
+        m_journaled = std::move(parser);
+        publish(std::move(snapshot), *publication);
+        return {};
+    }
+    catch (const std::bad_alloc&)
+    {
+        return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Método para alterar um campo de uma configuração em tempo de execução.
+******************************************************************************.
+* @param: section - O nome da seção ([TCP], [UART] ou uma instância numerada, como "UART3").
+* @param: key - O nome da chave.
+* @param: value - O novo valor textual.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou o código de erro (PARSE_ERROR para uma seção fora dos esquemas).
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigurationManager::set(std::string_view section, std::string_view key, std::string_view value)
+{
+    if (section == ConfigSchema<TcpConfig>::section || instanceNumber(section, ConfigSchema<TcpConfig>::section))
+    {
+        return setField<TcpConfig>(section, key, value);
+    }
+    if (section == ConfigSchema<UartConfig>::section || instanceNumber(section, ConfigSchema<UartConfig>::section))
+    {
+        return setField<UartConfig>(section, key, value);
+    }
+    return std::unexpected(ErrorCode::PARSE_ERROR);
+}
+
+/**
+******************************************************************************
+* @brief   : Método para alterar um campo inteiro de uma configuração em tempo de execução.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @param: value - O novo valor.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou o código de erro.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigurationManager::set(std::string_view section, std::string_view key, int value)
+{
+    char text[16]; // Comporta qualquer int, com o sinal.
+    auto [end, error] = std::to_chars(text, text + sizeof(text), value);
+    (void)error;
+    return set(section, key, std::string_view(text, static_cast<std::size_t>(end - text)));
+}
+
+/**
+******************************************************************************
+* @brief   : Método para incorporar imediatamente o journal ao arquivo base.
+* @details : A compactação não detém m_reloadMutex: as alterações feitas durante ela são gravadas no journal e permanecem nele.
+******************************************************************************.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, o erro de ConfigJournal::compact, ou UNKNOWN_ERROR se o journal não estiver aberto.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> ConfigurationManager::compactJournal()
+{
+    ConfigJournal* journal = nullptr; // O journal, uma vez aberto, vive tanto quanto o gerenciador.
+    {
+        std::lock_guard lock(m_reloadMutex);
+        journal = m_journal.get();
+    }
+    if (!journal)
+    {
+        return std::unexpected(ErrorCode::UNKNOWN_ERROR);
+    }
+    return journal->compact();
+}
+
+/**
+******************************************************************************
+* @brief   : Método para obter a geração do arquivo base.
+* @details : Um parser criado depois da leitura da geração contém todas as alterações incorporadas ao arquivo até ela; entregue a reload junto com a geração, ele recebe as alterações incorporadas por compactações concluídas depois da leitura.
+******************************************************************************.
+* @return: std::uint64_t - A geração (ConfigJournal::generation), ou zero se o journal não estiver aberto.
+******************************************************************************
+*/
+std::uint64_t ConfigurationManager::journalGeneration() const
+{
+    std::lock_guard lock(m_reloadMutex);
+    return m_journal ? m_journal->generation() : 0;
+}
+
+/**
+******************************************************************************
+* @brief   : Método para obter o estado do journal.
+******************************************************************************.
+* @return: std::optional<JournalStats> - Os registros pendentes, o tamanho e as compactações do journal, ou std::nullopt se ele não estiver aberto.
+******************************************************************************
+*/
+std::optional<JournalStats> ConfigurationManager::journalStats() const
+{
+    std::lock_guard lock(m_reloadMutex);
+    if (!m_journal)
+    {
+        return std::nullopt;
+    }
+    return m_journal->stats();
+}
@@ -0,0 +1,192 @@
+/*
+ * IniIndex.cpp
+ *
+ * Implementação da classe IniIndex, um índice (seção, chave) -> valor com consultas em O(1), baseado em uma tabela hash de endereçamento aberto sobre um vetor contíguo de entradas.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "IniIndex.hpp"
+#include <bit>
+/*----------------------------------------------------------------------------*/
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe IniIndex.
+******************************************************************************.
+* @param: resource - O recurso de memória usado pelas entradas, pela tabela hash e pela lista de seções.
+******************************************************************************
+*/
+IniIndex::IniIndex(std::pmr::memory_resource* resource) : m_entries(resource), m_slots(resource), m_sections(resource), m_knownSections(resource)
+{
+}
+
+/**
+******************************************************************************
+* @brief   : Calcula o hash de um par (seção, chave).
+* @details : Usa o FNV-1a de 64 bits sobre os bytes da seção, um separador nulo e os bytes da chave. O separador garante que pares como ("AB", "C") e ("A", "BC") tenham hashes diferentes.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @return: std::uint64_t - O hash do par.
+******************************************************************************
+*/
+std::uint64_t IniIndex::hash(std::string_view section, std::string_view key)
+{
+    std::uint64_t value = 14695981039346656037ull; // Valor inicial (offset basis) do FNV-1a de 64 bits.
+    for (char c : section) // Mistura os bytes da seção.
+    {
+        value = (value ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    value *= 1099511628211ull; // Mistura o separador nulo entre a seção e a chave.
+    for (char c : key) // Mistura os bytes da chave.
+    {
+        value = (value ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    return value;
+}
+
+/**
+******************************************************************************
+* @brief   : Reserva espaço para a quantidade de entradas indicada.
+* @details : A tabela hash é mantida com no máximo 50% de ocupação, o que mantém as sequências de sondagem curtas.
+******************************************************************************.
+* @param: entryCount - A quantidade de entradas esperada.
+******************************************************************************
+*/
+void IniIndex::reserve(std::size_t entryCount)
+{
+    m_entries.reserve(entryCount); // Reserva o vetor de entradas de uma só vez.
+    std::size_t slotCount = std::bit_ceil(entryCount * 2 < 16 ? std::size_t{16} : entryCount * 2); // Calcula a menor potência de dois que mantém a ocupação abaixo de 50%.
+    if (slotCount > m_slots.size()) // Só reconstrói a tabela se ela precisar crescer.
+    {
+        rehash(slotCount);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Reconstrói a tabela hash com a quantidade de slots indicada.
+******************************************************************************.
+* @param: slotCount - A nova quantidade de slots, que deve ser uma potência de dois.
+******************************************************************************
+*/
+void IniIndex::rehash(std::size_t slotCount)
+{
+    m_slots.assign(slotCount, Slot{}); // Cria a nova tabela com todos os slots vazios.
+    std::size_t mask = slotCount - 1; // Máscara usada para reduzir o hash ao intervalo da tabela.
+
+    for (std::size_t i = 0; i < m_entries.size(); ++i) // Reinsere todas as entradas existentes na nova tabela.
+    {
+        std::uint64_t h = hash(m_entries[i].section, m_entries[i].key); // Recalcula o hash da entrada.
+        std::size_t position = static_cast<std::size_t>(h) & mask; // Posição inicial da sondagem.
+        while (m_slots[position].entry != 0) // Sondagem linear até encontrar um slot vazio. Não há duplicatas, então não é preciso comparar chaves.
+        {
+            position = (position + 1) & mask;
+        }
+        m_slots[position] = Slot{static_cast<std::uint32_t>(i + 1), static_cast<std::uint32_t>(h >> 32)}; // Ocupa o slot com a entrada e a parte alta do hash.
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Insere um par (seção, chave) ou sobrescreve o valor de um par já existente.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @param: value - O valor associado à chave.
+* @param: origin - A origem do valor, guardada junto com ele.
+******************************************************************************
+*/
+void IniIndex::insert(std::string_view section, std::string_view key, std::string_view value, std::uint32_t origin)
+{
+    if (m_sections.empty() || section != m_lastSection) // Registra a seção quando ela muda entre duas inserções (e, portanto, pode ser nova).
+    {
+        if (m_knownSections.insert(section).second) // Somente seções ainda não vistas entram na lista.
+        {
+            m_sections.push_back(section);
+        }
+        m_lastSection = section;
+    }
+
+    if ((m_entries.size() + 1) * 2 > m_slots.size()) // Dobra a tabela quando a ocupação ultrapassaria 50%.
+    {
+        rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+    }
+
+    std::uint64_t h = hash(section, key); // Hash do par a ser inserido.
+    std::uint32_t tag = static_cast<std::uint32_t>(h >> 32); // Parte alta do hash, guardada no slot.
+    std::size_t mask = m_slots.size() - 1; // Máscara usada para reduzir o hash ao intervalo da tabela.
+    std::size_t position = static_cast<std::size_t>(h) & mask; // Posição inicial da sondagem.
+
+    while (m_slots[position].entry != 0) // Percorre os slots ocupados procurando o mesmo par.
+    {
+        const Slot& slot = m_slots[position];
+        IniEntry& entry = m_entries[slot.entry - 1];
+        if (slot.tag == tag && entry.key == key && entry.section == section) // Se o par já existir, sobrescreve o valor e a origem (a última declaração prevalece).
+        {
+            entry.value = value;
+            entry.origin = origin;
+            return;
+        }
+        position = (position + 1) & mask;
+    }
+
+    m_entries.push_back(IniEntry{section, key, value, origin}); // Acrescenta a nova entrada ao vetor contíguo.
+    m_slots[position] = Slot{static_cast<std::uint32_t>(m_entries.size()), tag}; // Ocupa o slot vazio encontrado.
+}
+
+/**
+******************************************************************************
+* @brief   : Procura o valor de um par (seção, chave).
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @return: std::optional<std::string_view> - O valor associado ao par, ou std::nullopt se o par não existir.
+******************************************************************************
+*/
+std::optional<std::string_view> IniIndex::find(std::string_view section, std::string_view key) const
+{
+    if (const IniEntry* entry = findEntry(section, key)) // Localiza a entrada do par.
+    {
+        return entry->value;
+    }
+    return std::nullopt;
+}
+
+/**
+******************************************************************************
+* @brief   : Procura a entrada de um par (seção, chave).
+* @details : A consulta calcula um único hash e percorre apenas a sequência de sondagem do par, cujo tamanho médio é constante graças à ocupação máxima de 50%. As strings só são comparadas quando a parte alta do hash coincide.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @return: const IniEntry* - A entrada do par, ou nullptr se o par não existir. O ponteiro é invalidado por inserções posteriores.
+******************************************************************************
+*/
+const IniEntry* IniIndex::findEntry(std::string_view section, std::string_view key) const
+{
+    if (m_slots.empty()) // Um índice vazio não contém nenhum par.
+    {
+        return nullptr;
+    }
+
+    std::uint64_t h = hash(section, key); // Hash do par procurado.
+    std::uint32_t tag = static_cast<std::uint32_t>(h >> 32); // Parte alta do hash, comparada antes das strings.
+    std::size_t mask = m_slots.size() - 1; // Máscara usada para reduzir o hash ao intervalo da tabela.
+    std::size_t position = static_cast<std::size_t>(h) & mask; // Posição inicial da sondagem.
+
+    while (m_slots[position].entry != 0) // Percorre os slots ocupados até encontrar o par ou um slot vazio.
+    {
+        const Slot& slot = m_slots[position];
+        const IniEntry& entry = m_entries[slot.entry - 1];
+        if (slot.tag == tag && entry.key == key && entry.section == section) // Compara as strings somente quando a parte alta do hash coincide.
+        {
+            return &entry;
+        }
+        position = (position + 1) & mask;
+    }
+    return nullptr; // Um slot vazio encerra a sondagem: o par não existe.
+}
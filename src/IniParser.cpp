@@ -9,141 +9,220 @@
 
  /* Includes ------------------------------------------------------------------*/
 #include "IniParser.hpp"
-#include <fstream>
+#include "ConfigSchema.hpp"
+#include "IniScanner.hpp"
+#include "IniTokenizer.hpp"
+#include <new>
 #include <string>
-#include <iostream>
+#include <utility>
 /*----------------------------------------------------------------------------*/
 
 /**
 ******************************************************************************
 * @brief   : Implementação da classe IniParser, que é responsável por ler arquivos de configuração no formato INI e interpretar os dados para fornecer as configurações de TCP e UART. Esta classe implementa a interface IConfigParser.
-* @details : O construtor da classe IniParser recebe o caminho para o arquivo de configuração INI e é responsável por ler o arquivo e armazenar os dados em um mapa para uso posterior pelos métodos parseTcp e parseUart. 
+* @details : O construtor da classe IniParser recebe o caminho para o arquivo de configuração INI, mapeia o arquivo em memória uma única vez e o tokeniza no próprio buffer, construindo um índice (seção, chave) -> valor com std::string_view para uso posterior pelos métodos parseTcp e parseUart. Nenhuma string é alocada por linha.
 ******************************************************************************.
-* @param: filePath - O caminho para o arquivo de configuração INI. O construtor é responsável por ler o arquivo e armazenar os dados em um mapa para uso posterior pelos métodos parseTcp e parse Uart.
-* @return: std::expected<TcpConfig, ErrorCode> - Retorna um std::expected contendo a configuração TCP ou um código de erro, permitindo que o chamador lide com falhas.
+* @param: filePath - O caminho para o arquivo de configuração INI. O construtor é responsável por ler o arquivo e construir o índice para uso posterior pelos métodos parseTcp e parseUart.
+* @param: resource - O recurso de memória usado pelo caminho e pelo índice. Se ele se esgotar (por exemplo, uma arena estática pequena demais para o arquivo), o parser passa a retornar OUT_OF_MEMORY em todas as consultas.
+******************************************************************************
+*/
+IniParser::IniParser(const std::string& filePath, std::pmr::memory_resource* resource)
+    : m_memory(resource, configMetricsEnabled()), m_filePath(&m_memory), m_index(&m_memory)
+{
+    bool measure = configMetricsEnabled(); // Com a instrumentação desligada, nenhum relógio é lido.
+    MetricsClock::time_point start = measure ? MetricsClock::now() : MetricsClock::time_point{}; // Início da leitura do arquivo.
+    m_file = MappedFile(filePath); // Abre e mapeia o arquivo no corpo do construtor, para que a E/S seja medida separadamente.
+    if (measure)
+    {
+        m_metrics.ioNs = metricsElapsedNs(start);
+    }
+    buildIndex(filePath, measure);
+}
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe IniParser a partir de um arquivo já aberto.
+* @details : Usado pela função createParser, que abre o arquivo uma única vez para detectar o formato pelo conteúdo e entrega o mesmo bloco ao parser escolhido. O tempo de E/S fica em zero, pois a leitura foi feita por quem abriu o arquivo.
+******************************************************************************.
+* @param: file - O conteúdo do arquivo. O parser passa a ser o seu dono.
+* @param: filePath - O caminho do arquivo, usado para descrever erros.
+* @param: resource - O recurso de memória usado pelo caminho e pelo índice.
+******************************************************************************
+*/
+IniParser::IniParser(MappedFile file, const std::string& filePath, std::pmr::memory_resource* resource)
+    : m_memory(resource, configMetricsEnabled()), m_filePath(&m_memory), m_file(std::move(file)), m_index(&m_memory)
+{
+    buildIndex(filePath, configMetricsEnabled());
+}
+
+/**
+******************************************************************************
+* @brief   : Tokeniza o conteúdo de m_file e constrói o índice (seção, chave) -> valor.
+******************************************************************************.
+* @param: filePath - O caminho do arquivo, guardado para descrever erros.
+* @param: measure - Indica se as medidas da carga devem ser coletadas.
 ******************************************************************************
 */
-IniParser::IniParser(const std::string& filePath) : m_filePath(filePath) 
+void IniParser::buildIndex(const std::string& filePath, bool measure)
 {
-    std::ifstream file(m_filePath); //Tenta abrir o arquivo para leitura.
-    std::string line; // Variável para armazenar cada linha lida do arquivo.
+    MetricsClock::time_point start = measure ? MetricsClock::now() : MetricsClock::time_point{}; // Início da tokenização.
+    IniTokenizer tokenizer(m_file.view()); // Tokenizador que percorre o conteúdo mapeado sem copiá-lo. Se o arquivo não puder ser aberto, a visão é vazia e o índice permanece vazio.
+    IniToken token; // Par chave/valor extraído de cada linha, junto com a sua seção.
 
-    while (std::getline(file, line)) // Lê o arquivo linha por linha.
+    try // Os recursos de memória sinalizam o esgotamento com std::bad_alloc; ele é convertido em um código de erro, como os demais erros do parser.
     {
-        size_t delimiterPos = line.find('='); // Procura o delimitador '=' para separar a chave do valor.
-        if (delimiterPos != std::string::npos) // Se o delimitador for encontrado, extrai a chave e o valor e os armazena no mapa de configuração.
+        m_filePath = filePath;
+        m_index.reserve(estimateIniEntries(m_file.view())); // Dimensiona o índice de uma só vez pela contagem de '=' e de linhas, sem reconstruções da tabela durante a carga e sem reservar espaço para comentários.
+        while (tokenizer.next(token)) // Percorre todas as linhas que contêm o delimitador '='.
         {
-            std::string key = line.substr(0, delimiterPos); // Extrai a chave, que é a parte da linha antes do delimitador '='.
-            std::string value = line.substr(delimiterPos + 1); // Extrai o valor, que é a parte da linha após o delimitador '='.
-            
-            m_configData[key] = value; // Armazena a chave e o valor no mapa de configuração, permitindo que os métodos parseTcp e parseUart acessem os dados de configuração de forma eficiente.
+            m_index.insert(token.section, token.key, token.value); // Indexa o par (seção, chave) como visões do buffer, sem alocar strings. Uma chave repetida na mesma seção sobrescreve o valor anterior.
         }
     }
+    catch (const std::bad_alloc&)
+    {
+        m_loadError = ErrorCode::OUT_OF_MEMORY; // O índice está incompleto e não pode ser consultado.
+    }
+
+    if (measure)
+    {
+        m_metrics.tokenizeNs = metricsElapsedNs(start);
+        m_metrics.bytes = m_file.size();
+        m_metrics.lines = tokenizer.lineCount();
+        m_metrics.peakMemoryBytes = m_memory.peak();
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Procura o valor de uma chave em uma seção do arquivo.
+* @details : Se a chave não existir na seção indicada, ela é procurada na seção global (chaves declaradas antes de qualquer cabeçalho), mantendo a compatibilidade com arquivos sem cabeçalhos de seção. Cada consulta é uma busca direta no índice, em O(1).
+******************************************************************************.
+* @param: section - O nome da seção (por exemplo, "TCP").
+* @param: key - O nome da chave (por exemplo, "port").
+* @return: std::optional<std::string_view> - O valor encontrado, ou std::nullopt se a chave não existir (ou se a carga falhou).
+******************************************************************************
+*/
+std::optional<std::string_view> IniParser::findValue(std::string_view section, std::string_view key) const
+{
+    if (m_loadError) // Um índice incompleto não é consultado.
+    {
+        return std::nullopt;
+    }
+    if (auto value = m_index.find(section, key)) // Procura primeiro na seção indicada.
+    {
+        return value;
+    }
+    return m_index.find({}, key); // Se não encontrar, procura na seção global.
 }
 
 /**
 ******************************************************************************
 * @brief   : Implementação do método parseTcp da classe IniParser, que é responsável por ler e interpretar os dados de configuração TCP do arquivo. 
-* @details : Ele acessa o mapa de configuração preenchido pelo construtor, extrai os valores correspondentes às chaves "ip", "port" e "protocol", e preenche uma estrutura TcpConfig com esses valores. O método valida os dados (por exemplo, verifica se a porta é um número válido e se o protocolo é "TCP" ou "UDP") e retorna um std::expected contendo a configuração TCP ou um código de erro, permitindo que o chamador lide com falhas.
+* @details : Os campos "ip", "port" e "protocol" da seção [TCP] são preenchidos e validados pelo esquema declarado em ConfigSchema<TcpConfig> (IP não vazio, porta entre 0 e 65535 e protocolo "TCP" ou "UDP"), consultando cada chave diretamente no índice. O custo não depende da quantidade de chaves do arquivo.
 ******************************************************************************.
 * @return: std::expected<TcpConfig, ErrorCode> - Retorna um std::expected contendo a configuração TCP ou um código de erro, permitindo que o chamador lide com falhas.
 ******************************************************************************
 */
 std::expected<TcpConfig, ErrorCode> IniParser::parseTcp() 
 {
+    return parseTcpSection(ConfigSchema<TcpConfig>::section); // Interpreta a seção [TCP].
+}
 
-    int fieldsFound = 0; // Variável para contar o número de campos encontrados na configuração TCP. Isso é usado para validar se todos os campos necessários foram encontrados e preenchidos corretamente.
-    TcpConfig tcpConfig; // Estrutura para armazenar a configuração TCP. O método irá preencher esta estrutura com os valores lidos do mapa de configuração e retorná-la se a leitura for bem-sucedida. 
+/**
+******************************************************************************
+* @brief   : Implementação do método parseUart da classe IniParser, análogo ao método parseTcp.
+* @details : Os campos "baudrate", "data_bits", "parity" e "stop_bits" da seção [UART] são preenchidos e validados pelo esquema declarado em ConfigSchema<UartConfig> (números compostos apenas por dígitos e paridade não vazia).
+******************************************************************************.
+* @return: std::expected<UartConfig, ErrorCode> - Retorna um std::expected contendo a configuração UART ou um código de erro, permitindo que o chamador lide com falhas.
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> IniParser::parseUart() 
+{
+    return parseUartSection(ConfigSchema<UartConfig>::section); // Interpreta a seção [UART].
+}
 
-        for(const auto& [key, value] : m_configData) // Itera sobre o mapa de configuração para encontrar as chaves e valores correspondentes à configuração TCP. Ele verifica cada chave para determinar se ela corresponde a um campo de configuração TCP (ip, port, protocol) e valida os valores antes de preenchê-los na estrutura TcpConfig.
-        {
-           if (key == "ip") // Se a chave for "ip", armazena o valor na estrutura TcpConfig e incrementa o contador de campos encontrados.
-            { 
-                if(!value.empty()) // Verifica se o valor do IP não está vazio. Se for válido, armazena o valor na estrutura TcpConfig e incrementa o contador de campos encontrados.
-                {
-                    tcpConfig.ip = value; // Armazena o valor do endereço IP na estrutura TcpConfig.
-                    fieldsFound++; // Incrementa o contador de campos encontrados para indicar que o campo "ip" foi encontrado e preenchido corretamente.
-                }
-            }
-           else if(key == "port") // Se a chave for "port", verifica se o valor é um número válido e, se for, armazena o valor na estrutura TcpConfig e incrementa o contador de campos encontrados.
-           {
-                if(!value.empty() && value.find_first_not_of("0123456789") == std::string::npos) // Verifica se o valor da porta é um número válido (não vazio e composto apenas por dígitos). Se for válido, armazena o valor na estrutura TcpConfig e incrementa o contador de campos encontrados.
-                {
-                    tcpConfig.port = std::stoi(value); // Converte o valor da porta de string para inteiro e armazena na estrutura TcpConfig.
-                    fieldsFound++; // Incrementa o contador de campos encontrados para indicar que o campo "port" foi encontrado e preenchido corretamente.
-                }
-           }
-           else if(key == "protocol") // Se a chave for "protocol", verifica se o valor é "TCP" ou "UDP" e, se for válido, armazena o valor na estrutura TcpConfig e incrementa o contador de campos encontrados.
-           {
-                if(value == "TCP" || value == "UDP") // Verifica se o valor do protocolo é "TCP" ou "UDP". Se for válido, armazena o valor na estrutura TcpConfig e incrementa o contador de campos encontrados.
-                {
-                    tcpConfig.protocol = value; // Armazena o valor do protocolo na estrutura TcpConfig.
-                    fieldsFound++; // Incrementa o contador de campos encontrados para indicar que o campo "protocol" foi encontrado e preenchido corretamente.
-                }
-           }
-        }
+/**
+******************************************************************************
+* @brief   : Retorna os nomes de todas as seções do arquivo que contêm chaves.
+******************************************************************************.
+* @return: std::span<const std::string_view> - Os nomes das seções, na ordem em que aparecem no arquivo, como visões do buffer mapeado, ou uma lista vazia se a carga falhou.
+******************************************************************************
+*/
+std::span<const std::string_view> IniParser::sectionNames() const
+{
+    if (m_loadError) // Um índice incompleto não expõe as suas seções.
+    {
+        return {};
+    }
+    return m_index.sections(); // Seções registradas pelo índice durante a carga, sem cópia.
+}
 
-        if (fieldsFound != 3) // Verifica se todos os campos necessários para a configuração TCP foram encontrados e preenchidos corretamente.
-        {
-            return std::unexpected(ErrorCode::PARSE_ERROR); // Se algum campo estiver faltando ou for inválido, retorna um código de erro de parsing.
-        }
-        return tcpConfig; // Retorna a configuração TCP preenchida com os valores lidos do mapa de configuração. 
+/**
+******************************************************************************
+* @brief   : Lê e interpreta a configuração TCP de uma seção específica, como [TCP3].
+* @details : O índice não é alterado depois da carga, portanto este método pode ser chamado por várias threads ao mesmo tempo.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<TcpConfig, ErrorCode> - Retorna a configuração TCP da seção, ErrorCode::PARSE_ERROR, ou o erro da carga (OUT_OF_MEMORY).
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> IniParser::parseTcpSection(std::string_view section) const
+{
+    if (m_loadError) // A carga falhou; nenhuma seção pode ser interpretada.
+    {
+        return std::unexpected(*m_loadError);
     }
+    return bindConfig<TcpConfig>([this, section](std::string_view key) { return findValue(section, key); }); // Preenche e valida a estrutura TcpConfig a partir do seu esquema, consultando cada chave diretamente no índice.
+}
 
 /**
 ******************************************************************************
-* @brief   : Implementação do método parseUart da classe IniParser, análogo ao método parseTcp.
-* @details : Ele acessa o mapa de configuração preenchido pelo construtor, extrai os valores correspondentes às chaves "baudrate", "data_bits", "parity" e "stop_bits", e preenche uma estrutura UartConfig com esses valores. O método valida os dados (por exemplo, verifica se a baudrate e data_bits são números válidos e se a paridade é "None", "Even" ou "Odd") e retorna um std::expected contendo a configuração UART ou um código de erro, permitindo que o chamador lide com falhas.
+* @brief   : Lê e interpreta a configuração UART de uma seção específica, como [UART12], análogo ao método parseTcpSection.
 ******************************************************************************.
-* @return: std::expected<UartConfig, ErrorCode> - Retorna um std::expected contendo a configuração UART ou um código de erro, permitindo que o chamador lide com falhas.
+* @param: section - O nome da seção.
+* @return: std::expected<UartConfig, ErrorCode> - Retorna a configuração UART da seção, ErrorCode::PARSE_ERROR, ou o erro da carga (OUT_OF_MEMORY).
 ******************************************************************************
 */
-std::expected<UartConfig, ErrorCode> IniParser::parseUart() 
+std::expected<UartConfig, ErrorCode> IniParser::parseUartSection(std::string_view section) const
 {
-    int fieldsFound = 0; // Variável para contar o número de campos encontrados na configuração UART.
-    UartConfig uartConfig; // Estrutura para armazenar a configuração UART.
+    if (m_loadError) // A carga falhou; nenhuma seção pode ser interpretada.
+    {
+        return std::unexpected(*m_loadError);
+    }
+    return bindConfig<UartConfig>([this, section](std::string_view key) { return findValue(section, key); }); // Preenche e valida a estrutura UartConfig a partir do seu esquema.
+}
 
-    for(const auto& [key, value] : m_configData) // Itera sobre o mapa de configuração para encontrar as chaves e valores correspondentes à configuração UART.
+/**
+******************************************************************************
+* @brief   : Retorna a posição de uma chave no arquivo, para descrever erros.
+* @details : A posição é calculada a partir do endereço do valor (ou do nome da seção) dentro do arquivo mapeado, pois o índice guarda visões do próprio arquivo. Se a chave não existir, a posição é a do primeiro cabeçalho da seção.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave, ou vazio para localizar apenas a seção.
+* @return: SourceLocation - O caminho do arquivo, com linha e coluna 0 se nem a chave nem a seção forem encontradas (ou se a carga falhou).
+******************************************************************************
+*/
+SourceLocation IniParser::locate(std::string_view section, std::string_view key) const
+{
+    SourceLocation location;
+    if (!m_loadError)
     {
-        if (key == "baudrate") // Se a chave for "baudrate", verifica se o valor é um número válido.
-        {
-            if (!value.empty() && value.find_first_not_of("0123456789") == std::string::npos) // Verifica se o valor da baudrate é um número válido (não vazio e composto apenas por dígitos).
-            {
-                uartConfig.baudrate = std::stoi(value); // Converte o valor da baudrate de string para inteiro e armazena na estrutura UartConfig.
-                fieldsFound++; // Incrementa o contador de campos encontrados para indicar que o campo "baudrate" foi encontrado e preenchido corretamente.
-            }
-        } 
-        else if (key == "data_bits") // Se a chave for "data_bits", verifica se o valor é um número válido.
+        if (auto value = key.empty() ? std::nullopt : findValue(section, key))
         {
-            if (!value.empty() && value.find_first_not_of("0123456789") == std::string::npos) // Verifica se o valor de data_bits é um número válido (não vazio e composto apenas por dígitos).
-            {
-                uartConfig.data_bits = std::stoi(value); // Converte o valor de data_bits de string para inteiro e armazena na estrutura UartConfig.
-                fieldsFound++; // Incrementa o contador de campos encontrados para indicar que o campo "data_bits" foi encontrado e preenchido corretamente.
-            }
-        } 
-        else if (key == "parity") // Se a chave for "parity", verifica se o valor é "None", "Even" ou "Odd".
-        {
-            if (!value.empty()) // Verifica se o valor da paridade é "None", "Even" ou "Odd". Se for válido, armazena o valor na estrutura UartConfig e incrementa o contador de campos encontrados.
-            {
-                uartConfig.parity = value; // Armazena o valor da paridade na estrutura UartConfig.
-                fieldsFound++; // Incrementa o contador de campos encontrados para indicar que o campo "parity" foi encontrado e preenchido corretamente.
-            }
-        } 
-        else if (key == "stop_bits") // Se a chave for "stop_bits", verifica se o valor é um número válido.
+            location = iniPositionOf(m_file.view(), value->data());
+        }
+        else
         {
-            if (!value.empty() && value.find_first_not_of("0123456789") == std::string::npos) // Verifica se o valor de stop_bits é um número válido (não vazio e composto apenas por dígitos).
+            for (std::string_view name : m_index.sections()) // Os nomes das seções também são visões do arquivo.
             {
-                uartConfig.stop_bits = std::stoi(value); // Converte o valor de stop_bits de string para inteiro e armazena na estrutura UartConfig.
-                fieldsFound++; // Incrementa o contador de campos encontrados para indicar que o campo "stop_bits" foi encontrado e preenchido corretamente.
+                if (name == section)
+                {
+                    location = iniPositionOf(m_file.view(), name.data());
+                    break;
+                }
             }
         }
     }
-        
-    if (fieldsFound != 4) // Verifica se todos os campos necessários para a configuração UART foram encontrados e preenchidos corretamente.
-    {
-        return std::unexpected(ErrorCode::PARSE_ERROR); // Se algum campo estiver faltando ou for inválido, retorna um código de erro de parsing.
-    }
-
-    return uartConfig; // Retorna a configuração UART preenchida com os valores lidos do mapa de configuração.
+    location.file = m_filePath;
+    return location;
 }
-
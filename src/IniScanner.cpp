@@ -0,0 +1,235 @@
+/*
+ * IniScanner.cpp
+ *
+ * Implementação dos núcleos de varredura do IniTokenizer (escalar, SSE2 e AVX2) e da escolha do núcleo em tempo de execução.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "IniScanner.hpp"
+#include <bit>
+#include <cstring>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INI_SCANNER_X86 1 // Os núcleos vetoriais usam atributos de alvo do GCC/Clang, sem exigir flags de compilação globais.
+#include <immintrin.h>
+#endif
+/*----------------------------------------------------------------------------*/
+
+/**
+******************************************************************************
+* @brief   : Compara os 8 bytes de uma palavra com um caractere, sem instruções vetoriais (SWAR).
+* @details : Os bytes iguais ao caractere tornam-se zero após o XOR; a soma com 0x7F em cada byte liga o bit alto de todo byte não nulo sem propagar vai-um entre bytes, de modo que o resultado é exato. Os bits altos são então reunidos nos 8 bits baixos por uma multiplicação.
+******************************************************************************.
+* @param: word - Os 8 bytes, na ordem da memória (little-endian).
+* @param: pattern - O caractere repetido nos 8 bytes.
+* @return: std::uint64_t - Uma máscara de 8 bits em que o bit i indica que o byte i é igual ao caractere.
+******************************************************************************
+*/
+static std::uint64_t matchWord(std::uint64_t word, std::uint64_t pattern)
+{
+    constexpr std::uint64_t LOW_BITS = 0x7F7F7F7F7F7F7F7FULL; // Os 7 bits baixos de cada byte.
+    std::uint64_t difference = word ^ pattern; // Zero nos bytes iguais ao caractere.
+    std::uint64_t zeros = ~(((difference & LOW_BITS) + LOW_BITS) | difference | LOW_BITS); // 0x80 nos bytes nulos e 0 nos demais.
+    return ((zeros >> 7) * 0x0102040810204080ULL) >> 56;
+}
+
+/**
+******************************************************************************
+* @brief   : Núcleo escalar: examina o bloco 8 bytes por vez com aritmética de palavras (ou byte a byte em plataformas big-endian).
+******************************************************************************.
+* @param: block - O início do bloco de 64 bytes.
+* @return: IniBlockMasks - As máscaras de '\n' e '=' do bloco.
+******************************************************************************
+*/
+static IniBlockMasks scanBlockScalar(const char* block)
+{
+    IniBlockMasks masks{0, 0};
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        constexpr std::uint64_t NEWLINES = 0x0A0A0A0A0A0A0A0AULL; // '\n' nos 8 bytes.
+        constexpr std::uint64_t DELIMITERS = 0x3D3D3D3D3D3D3D3DULL; // '=' nos 8 bytes.
+        for (std::size_t i = 0; i < INI_SCAN_BLOCK; i += 8) // Cada palavra preenche 8 bits de cada máscara.
+        {
+            std::uint64_t word;
+            std::memcpy(&word, block + i, sizeof(word));
+            masks.newlines |= matchWord(word, NEWLINES) << i;
+            masks.delimiters |= matchWord(word, DELIMITERS) << i;
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < INI_SCAN_BLOCK; ++i)
+        {
+            masks.newlines |= std::uint64_t{block[i] == '\n'} << i;
+            masks.delimiters |= std::uint64_t{block[i] == '='} << i;
+        }
+    }
+    return masks;
+}
+
+#ifdef INI_SCANNER_X86
+/**
+******************************************************************************
+* @brief   : Núcleo SSE2: examina o bloco em quatro comparações de 16 bytes por caractere.
+******************************************************************************.
+* @param: block - O início do bloco de 64 bytes.
+* @return: IniBlockMasks - As máscaras de '\n' e '=' do bloco.
+******************************************************************************
+*/
+__attribute__((target("sse2"))) static IniBlockMasks scanBlockSse2(const char* block)
+{
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i delimiter = _mm_set1_epi8('=');
+    IniBlockMasks masks{0, 0};
+    for (int i = 0; i < 4; ++i) // Cada iteração preenche 16 bits de cada máscara.
+    {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+        masks.newlines |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)))} << (16 * i);
+        masks.delimiters |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, delimiter)))} << (16 * i);
+    }
+    return masks;
+}
+
+/**
+******************************************************************************
+* @brief   : Compara 32 bytes com um caractere e retorna a máscara da comparação.
+******************************************************************************.
+* @param: bytes - Os 32 bytes.
+* @param: character - O caractere, repetido nas 32 posições.
+* @return: std::uint64_t - A máscara de 32 bits da comparação, nos bits baixos.
+******************************************************************************
+*/
+__attribute__((target("avx2"))) static std::uint64_t matchAvx2(__m256i bytes, __m256i character)
+{
+    return std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, character)))};
+}
+
+/**
+******************************************************************************
+* @brief   : Núcleo AVX2: examina o bloco em duas comparações de 32 bytes por caractere.
+******************************************************************************.
+* @param: block - O início do bloco de 64 bytes.
+* @return: IniBlockMasks - As máscaras de '\n' e '=' do bloco.
+******************************************************************************
+*/
+__attribute__((target("avx2"))) static IniBlockMasks scanBlockAvx2(const char* block)
+{
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i delimiter = _mm256_set1_epi8('=');
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)); // Bytes 0 a 31.
+    __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32)); // Bytes 32 a 63.
+    return IniBlockMasks{matchAvx2(low, newline) | matchAvx2(high, newline) << 32, matchAvx2(low, delimiter) | matchAvx2(high, delimiter) << 32};
+}
+#endif
+
+/**
+******************************************************************************
+* @brief   : Retorna o nível mais largo suportado pelo processador em execução.
+******************************************************************************.
+* @return: IniScanLevel - AVX2 ou SSE2 em processadores x86 que os suportam, ou SCALAR nas demais plataformas.
+******************************************************************************
+*/
+IniScanLevel bestIniScanLevel()
+{
+#ifdef INI_SCANNER_X86
+    static const IniScanLevel level = [] // Detecta o processador uma única vez.
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return IniScanLevel::AVX2;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return IniScanLevel::SSE2;
+        }
+        return IniScanLevel::SCALAR;
+    }();
+    return level;
+#else
+    return IniScanLevel::SCALAR;
+#endif
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna o núcleo de um nível.
+******************************************************************************.
+* @param: level - O nível desejado.
+* @return: IniBlockScanner - O núcleo do nível, ou o do melhor nível suportado se o indicado não estiver disponível neste processador.
+******************************************************************************
+*/
+IniBlockScanner iniBlockScanner(IniScanLevel level)
+{
+    if (static_cast<int>(level) > static_cast<int>(bestIniScanLevel())) // Nunca executa instruções que o processador não suporta.
+    {
+        level = bestIniScanLevel();
+    }
+    switch (level)
+    {
+#ifdef INI_SCANNER_X86
+    case IniScanLevel::AVX2:
+        return scanBlockAvx2;
+    case IniScanLevel::SSE2:
+        return scanBlockSse2;
+#endif
+    default:
+        return scanBlockScalar;
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna o nome de um nível, usado em resultados de benchmark.
+******************************************************************************.
+* @param: level - O nível.
+* @return: const char* - "scalar", "sse2" ou "avx2".
+******************************************************************************
+*/
+const char* iniScanLevelName(IniScanLevel level)
+{
+    switch (level)
+    {
+    case IniScanLevel::AVX2:
+        return "avx2";
+    case IniScanLevel::SSE2:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Estima, sem alocar, a quantidade de pares chave/valor de um texto INI.
+* @details : Cada par ocupa uma linha com pelo menos um '=', por isso a quantidade de pares não passa do menor valor entre a quantidade de '=' e a quantidade de linhas. As duas contagens são feitas em uma única passagem, com o núcleo mais largo do processador; comentários e linhas sem '=' não contam, de modo que um arquivo com muitos comentários não superdimensiona o índice.
+******************************************************************************.
+* @param: text - O texto do arquivo.
+* @return: std::size_t - Um limite superior da quantidade de pares.
+******************************************************************************
+*/
+std::size_t estimateIniEntries(std::string_view text)
+{
+    IniBlockScanner scan = iniBlockScanner(bestIniScanLevel());
+    std::size_t delimiters = 0; // Quantidade de '='.
+    std::size_t lines = 1; // Quantidade de linhas (a última pode não terminar em '\n').
+    std::size_t position = 0;
+    for (; position + INI_SCAN_BLOCK <= text.size(); position += INI_SCAN_BLOCK) // Blocos completos, examinados no próprio buffer.
+    {
+        IniBlockMasks masks = scan(text.data() + position);
+        delimiters += static_cast<std::size_t>(std::popcount(masks.delimiters));
+        lines += static_cast<std::size_t>(std::popcount(masks.newlines));
+    }
+    if (position < text.size()) // O final do texto é copiado para um bloco completado com espaços, que o núcleo pode ler inteiro.
+    {
+        char block[INI_SCAN_BLOCK];
+        std::memset(block, ' ', sizeof(block));
+        std::memcpy(block, text.data() + position, text.size() - position);
+        IniBlockMasks masks = scan(block);
+        delimiters += static_cast<std::size_t>(std::popcount(masks.delimiters));
+        lines += static_cast<std::size_t>(std::popcount(masks.newlines));
+    }
+    return delimiters < lines ? delimiters : lines;
+}
@@ -0,0 +1,217 @@
+/*
+ * IniTokenizer.cpp
+ *
+ * Implementação da classe IniTokenizer, responsável por extrair os pares chave/valor, e a seção a que pertencem, de um arquivo INI carregado em memória sem copiar nenhum byte.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "IniTokenizer.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+/*----------------------------------------------------------------------------*/
+
+/**
+******************************************************************************
+* @brief   : Remove espaços e tabulações das extremidades de um trecho de texto.
+******************************************************************************.
+* @param: text - O trecho de texto a ser aparado.
+* @return: std::string_view - Uma visão do mesmo trecho, sem os espaços das extremidades.
+******************************************************************************
+*/
+std::string_view trimIni(std::string_view text)
+{
+    // Comparação direta com os dois caracteres: find_first_not_of(" \t") consulta o conjunto a cada caractere, o que dominava o custo de cada linha.
+    std::size_t first = 0; // Primeiro caractere que não é espaço.
+    while (first < text.size() && (text[first] == ' ' || text[first] == '\t'))
+    {
+        ++first;
+    }
+    std::size_t last = text.size(); // Posição seguinte ao último caractere que não é espaço.
+    while (last > first && (text[last - 1] == ' ' || text[last - 1] == '\t'))
+    {
+        --last;
+    }
+    return text.substr(first, last - first); // Vazio se o trecho só contém espaços.
+}
+
+/**
+******************************************************************************
+* @brief   : Classifica uma linha de um arquivo INI e extrai o seu conteúdo.
+* @details : Um '\r' final (de arquivos gerados no Windows) é descartado, assim como acontece na leitura em modo texto, e a linha é aparada nas extremidades. Linhas iniciadas por '[' e terminadas por ']' são cabeçalhos de seção; linhas iniciadas por ';' ou '#' são comentários. Nas demais, a chave é a parte antes do primeiro '=' e o valor é a parte após ele, ambos aparados e sem nenhuma alocação.
+******************************************************************************.
+* @param: line - A linha, sem o '\n' final.
+* @param: delimiter - A posição do primeiro '=' da linha, ou std::string_view::npos se não houver.
+* @param: first - Recebe o nome da seção (SECTION) ou a chave (KEY_VALUE).
+* @param: second - Recebe o valor (KEY_VALUE).
+* @return: IniLineType - O tipo da linha. Para IGNORED, first e second não são alterados.
+******************************************************************************
+*/
+IniLineType parseIniLine(std::string_view line, std::size_t delimiter, std::string_view& first, std::string_view& second)
+{
+    if (!line.empty() && line.back() == '\r') // Descarta o '\r' final de linhas terminadas em "\r\n".
+    {
+        line.remove_suffix(1);
+    }
+    std::string_view trimmed = trimIni(line); // Remove a indentação e os espaços finais da linha.
+
+    if (trimmed.empty() || trimmed.front() == ';' || trimmed.front() == '#') // Ignora linhas vazias e comentários.
+    {
+        return IniLineType::IGNORED;
+    }
+
+    if (trimmed.front() == '[') // Linhas iniciadas por '[' são cabeçalhos de seção.
+    {
+        if (trimmed.back() != ']') // Somente cabeçalhos bem formados alteram a seção corrente; os demais são ignorados.
+        {
+            return IniLineType::IGNORED;
+        }
+        first = trimIni(trimmed.substr(1, trimmed.size() - 2)); // O nome da seção é o conteúdo entre os colchetes.
+        return IniLineType::SECTION;
+    }
+
+    if (delimiter == std::string_view::npos) // Linhas sem o delimitador são ignoradas.
+    {
+        return IniLineType::IGNORED;
+    }
+    std::size_t offset = static_cast<std::size_t>(trimmed.data() - line.data()); // Espaços removidos do início; o '=' nunca está entre eles.
+    first = trimIni(trimmed.substr(0, delimiter - offset)); // A chave é a parte da linha antes do delimitador '='.
+    second = trimIni(trimmed.substr(delimiter - offset + 1)); // O valor é a parte da linha após o delimitador '='.
+    return IniLineType::KEY_VALUE;
+}
+
+/**
+******************************************************************************
+* @brief   : Classifica uma linha de um arquivo INI e extrai o seu conteúdo, localizando o primeiro '=' da linha.
+******************************************************************************.
+* @param: line - A linha, sem o '\n' final.
+* @param: first - Recebe o nome da seção (SECTION) ou a chave (KEY_VALUE).
+* @param: second - Recebe o valor (KEY_VALUE).
+* @return: IniLineType - O tipo da linha. Para IGNORED, first e second não são alterados.
+******************************************************************************
+*/
+IniLineType parseIniLine(std::string_view line, std::string_view& first, std::string_view& second)
+{
+    return parseIniLine(line, line.find('='), first, second);
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a linha e a coluna de uma posição do texto.
+* @details : As linhas anteriores são contadas a cada chamada; a função serve para descrever erros, não para o caminho de carga.
+******************************************************************************.
+* @param: text - O texto completo do arquivo.
+* @param: position - Um ponteiro para dentro do texto (por exemplo, o início de um valor do índice).
+* @return: SourceLocation - A linha e a coluna, a partir de 1, ou linha e coluna 0 se o ponteiro estiver fora do texto.
+******************************************************************************
+*/
+SourceLocation iniPositionOf(std::string_view text, const char* position)
+{
+    SourceLocation location;
+    if (position == nullptr || position < text.data() || position > text.data() + text.size())
+    {
+        return location;
+    }
+    std::string_view before = text.substr(0, static_cast<std::size_t>(position - text.data())); // Texto anterior à posição.
+    std::size_t lineStart = before.rfind('\n'); // Final da linha anterior.
+    location.line = static_cast<std::size_t>(std::count(before.begin(), before.end(), '\n')) + 1;
+    location.column = before.size() - (lineStart == std::string_view::npos ? 0 : lineStart + 1) + 1;
+    return location;
+}
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe IniTokenizer.
+******************************************************************************.
+* @param: text - O texto completo do arquivo INI. Ele não é copiado e deve permanecer válido enquanto o tokenizador e os tokens forem usados.
+* @param: level - O nível de instruções da varredura. Um nível não suportado pelo processador é substituído pelo melhor nível suportado.
+******************************************************************************
+*/
+IniTokenizer::IniTokenizer(std::string_view text, IniScanLevel level) : m_text(text), m_scanner(iniBlockScanner(level))
+{
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a posição do próximo caractere estrutural a partir de uma posição.
+* @details : As máscaras de cada bloco de 64 bytes são calculadas uma única vez pelo núcleo de varredura e reaproveitadas por todas as linhas do bloco. O último bloco, incompleto, é copiado para um bloco preenchido com zeros, para que o núcleo nunca leia além do final do texto.
+******************************************************************************.
+* @param: position - A posição a partir da qual procurar.
+* @param: includeDelimiters - Se true, procura '\n' ou '='; caso contrário, somente '\n'.
+* @return: std::size_t - A posição encontrada, ou o tamanho do texto se não houver.
+******************************************************************************
+*/
+std::size_t IniTokenizer::findStructural(std::size_t position, bool includeDelimiters)
+{
+    while (position < m_text.size())
+    {
+        std::size_t blockStart = position - position % INI_SCAN_BLOCK; // Início do bloco que contém a posição.
+        if (blockStart != m_blockStart) // Examina o bloco somente na primeira vez em que ele é alcançado.
+        {
+            if (m_text.size() - blockStart >= INI_SCAN_BLOCK)
+            {
+                m_masks = m_scanner(m_text.data() + blockStart);
+            }
+            else // Último bloco, incompleto.
+            {
+                char tail[INI_SCAN_BLOCK] = {};
+                std::memcpy(tail, m_text.data() + blockStart, m_text.size() - blockStart);
+                m_masks = m_scanner(tail);
+            }
+            m_blockStart = blockStart;
+        }
+
+        std::uint64_t bits = m_masks.newlines | (includeDelimiters ? m_masks.delimiters : 0); // Caracteres procurados no bloco.
+        bits &= ~std::uint64_t{0} << (position - blockStart); // Descarta os caracteres anteriores à posição.
+        if (bits != 0)
+        {
+            return blockStart + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+        position = blockStart + INI_SCAN_BLOCK; // Continua no bloco seguinte.
+    }
+    return m_text.size();
+}
+
+/**
+******************************************************************************
+* @brief   : Avança até o próximo par chave/valor do texto.
+* @details : Para cada linha, o primeiro '\n' ou '=' é localizado pelas máscaras do bloco; se for um '=', o final da linha é procurado a partir dele. Assim, cada byte é examinado uma única vez, e a linha é classificada pela função parseIniLine sem procurar o '=' novamente. Cabeçalhos de seção alteram a seção corrente; linhas ignoradas são puladas.
+******************************************************************************.
+* @param: token - Estrutura que recebe a seção, a chave e o valor encontrados.
+* @return: bool - Retorna true se um par chave/valor foi encontrado, ou false se o texto terminou.
+******************************************************************************
+*/
+bool IniTokenizer::next(IniToken& token)
+{
+    while (m_position < m_text.size()) // Percorre as linhas restantes até encontrar uma que contenha o delimitador '='.
+    {
+        std::size_t lineStart = m_position; // Início da linha atual.
+        std::size_t delimiter = std::string_view::npos; // Posição do primeiro '=' da linha, relativa ao seu início.
+        std::size_t lineEnd = findStructural(lineStart, true); // Primeiro '\n' ou '=' da linha. A última linha pode não terminar com '\n'.
+        if (lineEnd < m_text.size() && m_text[lineEnd] == '=') // A linha tem um delimitador; o final dela vem depois.
+        {
+            delimiter = lineEnd - lineStart;
+            lineEnd = findStructural(lineEnd + 1, false);
+        }
+
+        std::string_view line = m_text.substr(lineStart, lineEnd - lineStart); // Visão da linha atual, sem o '\n'.
+        m_position = lineEnd + 1; // Posiciona o cursor no início da próxima linha.
+        ++m_lines;
+
+        switch (parseIniLine(line, delimiter, token.key, token.value))
+        {
+        case IniLineType::SECTION: // O nome da seção foi gravado em token.key.
+            m_section = token.key;
+            break;
+        case IniLineType::KEY_VALUE: // Entrega o par com a seção corrente.
+            token.section = m_section;
+            return true;
+        case IniLineType::IGNORED:
+            break;
+        }
+    }
+    return false; // Não há mais pares chave/valor no texto.
+}
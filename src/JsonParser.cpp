@@ -0,0 +1,667 @@
+/*
+ * JsonParser.cpp
+ *
+ * Implementação da classe JsonParser, que lê arquivos de configuração no formato JSON sem construir uma árvore do documento.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "JsonParser.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <utility>
+#include "ConfigSchema.hpp"
+#include "IniTokenizer.hpp"
+/*----------------------------------------------------------------------------*/
+
+static constexpr int MAX_JSON_DEPTH = 64; // Maior profundidade aceita para objetos e listas aninhados, que limita a recursão de skipValue.
+
+// Estado da leitura de um documento: a posição corrente e os destinos dos valores.
+struct JsonReader
+{
+    const char* position; // Próximo byte a ser lido.
+    const char* end; // Final do documento.
+    IniIndex& index; // Índice que recebe os valores escalares.
+    std::pmr::list<std::pmr::string>& decoded; // Destino das strings com sequências de escape.
+};
+
+/**
+******************************************************************************
+* @brief   : Avança sobre os espaços em branco aceitos pelo JSON (espaço, tabulação, '\n' e '\r').
+******************************************************************************.
+* @param: reader - O estado da leitura.
+******************************************************************************
+*/
+static void skipWhitespace(JsonReader& reader)
+{
+    while (reader.position < reader.end && (*reader.position == ' ' || *reader.position == '\n' || *reader.position == '\r' || *reader.position == '\t'))
+    {
+        ++reader.position;
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Consome um caractere esperado, depois dos espaços em branco.
+******************************************************************************.
+* @param: reader - O estado da leitura.
+* @param: expected - O caractere esperado.
+* @return: bool - Retorna false se o próximo caractere for outro (a posição fica sobre ele).
+******************************************************************************
+*/
+static bool consume(JsonReader& reader, char expected)
+{
+    skipWhitespace(reader);
+    if (reader.position == reader.end || *reader.position != expected)
+    {
+        return false;
+    }
+    ++reader.position;
+    return true;
+}
+
+/**
+******************************************************************************
+* @brief   : Lê os quatro dígitos hexadecimais de uma sequência \uXXXX.
+******************************************************************************.
+* @param: digits - O texto a partir do primeiro dígito.
+* @param: value - Recebe o valor.
+* @return: bool - Retorna false se o texto não tiver quatro dígitos hexadecimais.
+******************************************************************************
+*/
+static bool readHex4(std::string_view digits, std::uint32_t& value)
+{
+    if (digits.size() < 4)
+    {
+        return false;
+    }
+    value = 0;
+    for (char c : digits.substr(0, 4))
+    {
+        std::uint32_t digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : 16;
+        if (digit == 16)
+        {
+            return false;
+        }
+        value = value * 16 + digit;
+    }
+    return true;
+}
+
+/**
+******************************************************************************
+* @brief   : Decodifica as sequências de escape de uma string JSON.
+* @details : As sequências \uXXXX são convertidas para UTF-8, inclusive os pares de substitutos (surrogates) que representam caracteres fora do plano básico.
+******************************************************************************.
+* @param: raw - O conteúdo da string entre as aspas, como está no arquivo.
+* @param: output - Recebe o texto decodificado.
+* @return: bool - Retorna false se alguma sequência de escape for inválida.
+******************************************************************************
+*/
+static bool decodeString(std::string_view raw, std::pmr::string& output)
+{
+    output.reserve(raw.size()); // O texto decodificado nunca é maior que o original.
+    for (std::size_t i = 0; i < raw.size(); ++i)
+    {
+        if (raw[i] != '\\')
+        {
+            output.push_back(raw[i]);
+            continue;
+        }
+        if (++i == raw.size())
+        {
+            return false;
+        }
+        switch (raw[i])
+        {
+        case '"': output.push_back('"'); break;
+        case '\\': output.push_back('\\'); break;
+        case '/': output.push_back('/'); break;
+        case 'b': output.push_back('\b'); break;
+        case 'f': output.push_back('\f'); break;
+        case 'n': output.push_back('\n'); break;
+        case 'r': output.push_back('\r'); break;
+        case 't': output.push_back('\t'); break;
+        case 'u':
+        {
+            std::uint32_t code = 0; // Ponto de código.
+            if (!readHex4(raw.substr(i + 1), code))
+            {
+                return false;
+            }
+            i += 4;
+            if (code >= 0xD800 && code <= 0xDBFF) // Primeiro substituto: o segundo deve vir em seguida.
+            {
+                std::uint32_t low = 0;
+                if (raw.substr(i + 1, 2) != "\\u" || !readHex4(raw.substr(i + 3), low) || low < 0xDC00 || low > 0xDFFF)
+                {
+                    return false;
+                }
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                i += 6;
+            }
+            else if (code >= 0xDC00 && code <= 0xDFFF) // Segundo substituto sem o primeiro.
+            {
+                return false;
+            }
+            if (code < 0x80) // Codifica o ponto de código em UTF-8.
+            {
+                output.push_back(static_cast<char>(code));
+            }
+            else if (code < 0x800)
+            {
+                output.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                output.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            else if (code < 0x10000)
+            {
+                output.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                output.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                output.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            else
+            {
+                output.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                output.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                output.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                output.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+******************************************************************************
+* @brief   : Lê uma string JSON.
+* @details : O final da string é localizado com memchr: a aspa seguinte encerra a string, a menos que uma barra invertida anterior a ela a escape. Caracteres de controle (abaixo de 0x20) devem vir escapados, como exige a gramática do JSON; um deles no texto da string a torna inválida, e a leitura para sobre ele, para que locate aponte o caractere. Uma string sem sequências de escape é devolvida como uma visão do próprio arquivo; as demais são decodificadas em uma cópia guardada pelo parser.
+******************************************************************************.
+* @param: reader - O estado da leitura, posicionado sobre a aspa inicial.
+* @param: text - Recebe o conteúdo da string.
+* @return: bool - Retorna false se a string não terminar, tiver um caractere de controle sem escape ou uma sequência de escape inválida.
+******************************************************************************
+*/
+static bool readString(JsonReader& reader, std::string_view& text)
+{
+    const char* start = ++reader.position; // Primeiro byte depois da aspa.
+    bool escaped = false; // Indica se a string tem sequências de escape.
+    for (;;)
+    {
+        const char* quote = static_cast<const char*>(std::memchr(reader.position, '"', static_cast<std::size_t>(reader.end - reader.position)));
+        if (!quote)
+        {
+            return false;
+        }
+        const char* backslash = static_cast<const char*>(std::memchr(reader.position, '\\', static_cast<std::size_t>(quote - reader.position)));
+        if (!backslash) // Nenhuma barra invertida antes da aspa: ela encerra a string.
+        {
+            reader.position = quote + 1;
+            text = std::string_view(start, static_cast<std::size_t>(quote - start));
+            break;
+        }
+        escaped = true;
+        if (backslash + 1 == reader.end)
+        {
+            return false;
+        }
+        reader.position = backslash + 2; // Pula a barra e o caractere escapado (que pode ser uma aspa).
+    }
+    const char* control = std::find_if(text.data(), text.data() + text.size(), [](char c) { return static_cast<unsigned char>(c) < 0x20; }); // Caractere de controle sem escape.
+    if (control != text.data() + text.size())
+    {
+        reader.position = control;
+        return false;
+    }
+    if (escaped)
+    {
+        reader.decoded.emplace_back();
+        if (!decodeString(text, reader.decoded.back()))
+        {
+            return false;
+        }
+        text = reader.decoded.back();
+    }
+    return true;
+}
+
+/**
+******************************************************************************
+* @brief   : Lê um número JSON, validando a gramática (sinal, parte inteira sem zeros à esquerda, fração e expoente opcionais).
+******************************************************************************.
+* @param: reader - O estado da leitura, posicionado sobre o primeiro caractere do número.
+* @param: text - Recebe o texto do número, como está no arquivo.
+* @return: bool - Retorna false se o número for mal formado.
+******************************************************************************
+*/
+static bool readNumber(JsonReader& reader, std::string_view& text)
+{
+    const char* start = reader.position;
+    auto digits = [&reader]() // Consome uma sequência de dígitos e retorna quantos foram consumidos.
+    {
+        const char* first = reader.position;
+        while (reader.position < reader.end && *reader.position >= '0' && *reader.position <= '9')
+        {
+            ++reader.position;
+        }
+        return reader.position - first;
+    };
+    if (reader.position < reader.end && *reader.position == '-')
+    {
+        ++reader.position;
+    }
+    const char* integer = reader.position; // Início da parte inteira.
+    std::ptrdiff_t count = digits();
+    if (count == 0 || (count > 1 && *integer == '0'))
+    {
+        return false;
+    }
+    if (reader.position < reader.end && *reader.position == '.')
+    {
+        ++reader.position;
+        if (digits() == 0)
+        {
+            return false;
+        }
+    }
+    if (reader.position < reader.end && (*reader.position == 'e' || *reader.position == 'E'))
+    {
+        ++reader.position;
+        if (reader.position < reader.end && (*reader.position == '+' || *reader.position == '-'))
+        {
+            ++reader.position;
+        }
+        if (digits() == 0)
+        {
+            return false;
+        }
+    }
+    text = std::string_view(start, static_cast<std::size_t>(reader.position - start));
+    return true;
+}
+
+/**
+******************************************************************************
+* @brief   : Lê um valor escalar (string, número, true, false ou null).
+******************************************************************************.
+* @param: reader - O estado da leitura, posicionado sobre o primeiro caractere do valor.
+* @param: text - Recebe o valor textual: o conteúdo da string, o texto do número ou "true"/"false". Para null, não é alterado.
+* @param: isNull - Recebe true se o valor for null.
+* @return: bool - Retorna false se o valor for mal formado ou não for escalar.
+******************************************************************************
+*/
+static bool readScalar(JsonReader& reader, std::string_view& text, bool& isNull)
+{
+    isNull = false;
+    if (reader.position == reader.end)
+    {
+        return false;
+    }
+    char first = *reader.position;
+    if (first == '"')
+    {
+        return readString(reader, text);
+    }
+    if (first == '-' || (first >= '0' && first <= '9'))
+    {
+        return readNumber(reader, text);
+    }
+    for (std::string_view literal : {std::string_view("true"), std::string_view("false"), std::string_view("null")})
+    {
+        if (static_cast<std::size_t>(reader.end - reader.position) >= literal.size() && std::string_view(reader.position, literal.size()) == literal)
+        {
+            text = std::string_view(reader.position, literal.size()); // Visão do próprio arquivo.
+            reader.position += literal.size();
+            isNull = literal == "null";
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool skipValue(JsonReader& reader, int depth);
+
+/**
+******************************************************************************
+* @brief   : Percorre os membros de um objeto, chamando uma função para cada um.
+******************************************************************************.
+* @param: reader - O estado da leitura, posicionado sobre a chave '{'.
+* @param: member - Função que recebe o nome do membro, com a leitura posicionada sobre o valor, e o consome. Retorna false se o valor for mal formado.
+* @return: bool - Retorna false se o objeto for mal formado.
+******************************************************************************
+*/
+template <typename Member>
+static bool readObject(JsonReader& reader, Member member)
+{
+    ++reader.position; // '{'
+    if (consume(reader, '}'))
+    {
+        return true;
+    }
+    do
+    {
+        std::string_view name; // Nome do membro.
+        skipWhitespace(reader);
+        if (reader.position == reader.end || *reader.position != '"' || !readString(reader, name) || !consume(reader, ':'))
+        {
+            return false;
+        }
+        skipWhitespace(reader);
+        if (reader.position == reader.end || !member(name))
+        {
+            return false;
+        }
+    } while (consume(reader, ','));
+    return consume(reader, '}');
+}
+
+/**
+******************************************************************************
+* @brief   : Valida e descarta um valor qualquer, inclusive objetos e listas aninhados.
+******************************************************************************.
+* @param: reader - O estado da leitura, posicionado sobre o primeiro caractere do valor.
+* @param: depth - A profundidade do valor no documento.
+* @return: bool - Retorna false se o valor for mal formado ou exceder MAX_JSON_DEPTH.
+******************************************************************************
+*/
+static bool skipValue(JsonReader& reader, int depth)
+{
+    if (depth > MAX_JSON_DEPTH || reader.position == reader.end)
+    {
+        return false;
+    }
+    if (*reader.position == '{')
+    {
+        return readObject(reader, [&reader, depth](std::string_view) { return skipValue(reader, depth + 1); });
+    }
+    if (*reader.position == '[')
+    {
+        ++reader.position;
+        if (consume(reader, ']'))
+        {
+            return true;
+        }
+        do
+        {
+            skipWhitespace(reader);
+            if (!skipValue(reader, depth + 1))
+            {
+                return false;
+            }
+        } while (consume(reader, ','));
+        return consume(reader, ']');
+    }
+    std::string_view text;
+    bool isNull = false;
+    return readScalar(reader, text, isNull);
+}
+
+/**
+******************************************************************************
+* @brief   : Lê um membro de uma seção: valores escalares são indexados; objetos e listas são validados e descartados.
+******************************************************************************.
+* @param: reader - O estado da leitura, posicionado sobre o valor.
+* @param: section - O nome da seção (vazio para os membros escalares do objeto principal).
+* @param: key - O nome do membro.
+* @param: depth - A profundidade do valor.
+* @return: bool - Retorna false se o valor for mal formado.
+******************************************************************************
+*/
+static bool readMember(JsonReader& reader, std::string_view section, std::string_view key, int depth)
+{
+    if (*reader.position == '{' || *reader.position == '[')
+    {
+        return skipValue(reader, depth);
+    }
+    std::string_view text;
+    bool isNull = false;
+    if (!readScalar(reader, text, isNull))
+    {
+        return false;
+    }
+    if (!isNull) // null equivale a uma chave ausente.
+    {
+        reader.index.insert(section, key, text);
+    }
+    return true;
+}
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe JsonParser, que mapeia o arquivo e constrói o índice.
+******************************************************************************.
+* @param: filePath - O caminho do arquivo JSON.
+* @param: resource - O recurso de memória do índice, do caminho e das strings decodificadas. Se ele se esgotar, o parser passa a retornar OUT_OF_MEMORY em todas as consultas.
+******************************************************************************
+*/
+JsonParser::JsonParser(const std::string& filePath, std::pmr::memory_resource* resource)
+    : m_memory(resource, configMetricsEnabled()), m_filePath(&m_memory), m_decoded(&m_memory), m_index(&m_memory)
+{
+    bool measure = configMetricsEnabled(); // Com a instrumentação desligada, nenhum relógio é lido.
+    MetricsClock::time_point start = measure ? MetricsClock::now() : MetricsClock::time_point{}; // Início da leitura do arquivo.
+    m_file = MappedFile(filePath);
+    if (measure)
+    {
+        m_metrics.ioNs = metricsElapsedNs(start);
+    }
+    buildIndex(filePath, measure);
+}
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe JsonParser a partir de um arquivo já aberto.
+******************************************************************************.
+* @param: file - O conteúdo do arquivo. O parser passa a ser o seu dono.
+* @param: filePath - O caminho do arquivo, usado para descrever erros.
+* @param: resource - O recurso de memória do índice, do caminho e das strings decodificadas.
+******************************************************************************
+*/
+JsonParser::JsonParser(MappedFile file, const std::string& filePath, std::pmr::memory_resource* resource)
+    : m_memory(resource, configMetricsEnabled()), m_filePath(&m_memory), m_file(std::move(file)), m_decoded(&m_memory), m_index(&m_memory)
+{
+    buildIndex(filePath, configMetricsEnabled());
+}
+
+/**
+******************************************************************************
+* @brief   : Percorre o documento uma única vez e constrói o índice (seção, chave) -> valor.
+* @details : O objeto principal é lido membro a membro: um membro cujo valor é um objeto abre uma seção com o seu nome, e os valores escalares dele são indexados; os membros escalares do objeto principal vão para a seção global; listas são descartadas. Um arquivo que não pode ser aberto resulta em um índice vazio, como no IniParser. Um documento mal formado (inclusive com bytes depois do objeto principal) é rejeitado por inteiro com INVALID_FORMAT, pois não é possível saber quais valores ele pretendia declarar.
+******************************************************************************.
+* @param: filePath - O caminho do arquivo, guardado para descrever erros.
+* @param: measure - Indica se as medidas da carga devem ser coletadas.
+******************************************************************************
+*/
+void JsonParser::buildIndex(const std::string& filePath, bool measure)
+{
+    MetricsClock::time_point start = measure ? MetricsClock::now() : MetricsClock::time_point{}; // Início da leitura do documento.
+    std::string_view text = m_file.view(); // Documento completo.
+    JsonReader reader{text.data(), text.data() + text.size(), m_index, m_decoded};
+    try // Os recursos de memória sinalizam o esgotamento com std::bad_alloc.
+    {
+        m_filePath = filePath;
+        m_index.reserve(static_cast<std::size_t>(std::count(text.begin(), text.end(), ':'))); // Cada membro tem um ':' fora das strings, por isso a contagem é um limite superior da quantidade de valores; espaços e indentação não reservam nada, ao contrário de uma estimativa por tamanho.
+        if (text.starts_with("\xEF\xBB\xBF")) // Marca de ordem de bytes do UTF-8.
+        {
+            reader.position += 3;
+        }
+        skipWhitespace(reader);
+        bool valid = reader.position == reader.end; // Um arquivo vazio (ou que não pôde ser aberto) não declara nenhum valor.
+        if (!valid && *reader.position == '{')
+        {
+            valid = readObject(reader, [&reader](std::string_view name)
+            {
+                if (*reader.position == '{') // Seção.
+                {
+                    return readObject(reader, [&reader, name](std::string_view key) { return readMember(reader, name, key, 2); });
+                }
+                return readMember(reader, {}, name, 1);
+            });
+            if (valid) // Em caso de falha, a leitura fica sobre o ponto inválido, para locate.
+            {
+                skipWhitespace(reader);
+                valid = reader.position == reader.end;
+            }
+        }
+        if (!valid)
+        {
+            m_loadError = ErrorCode::INVALID_FORMAT;
+            m_errorOffset = static_cast<std::size_t>(reader.position - text.data());
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        m_loadError = ErrorCode::OUT_OF_MEMORY; // O índice está incompleto e não pode ser consultado.
+    }
+
+    if (measure)
+    {
+        m_metrics.tokenizeNs = metricsElapsedNs(start);
+        m_metrics.bytes = text.size();
+        m_metrics.lines = static_cast<std::uint64_t>(std::count(text.begin(), text.end(), '\n')) + (!text.empty() && text.back() != '\n' ? 1 : 0);
+        m_metrics.peakMemoryBytes = m_memory.peak();
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Procura o valor de uma chave em uma seção do documento.
+* @details : Se a chave não existir no objeto indicado, ela é procurada entre os membros escalares do objeto principal, com a mesma regra da seção global do INI.
+******************************************************************************.
+* @param: section - O nome da seção (por exemplo, "TCP").
+* @param: key - O nome da chave (por exemplo, "port").
+* @return: std::optional<std::string_view> - O valor encontrado, ou std::nullopt se a chave não existir (ou se a carga falhou).
+******************************************************************************
+*/
+std::optional<std::string_view> JsonParser::findValue(std::string_view section, std::string_view key) const
+{
+    if (m_loadError)
+    {
+        return std::nullopt;
+    }
+    if (auto value = m_index.find(section, key))
+    {
+        return value;
+    }
+    return m_index.find({}, key);
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e valida a configuração TCP do objeto "TCP".
+******************************************************************************.
+* @return: std::expected<TcpConfig, ErrorCode> - A configuração TCP, PARSE_ERROR, ou o erro da carga (INVALID_FORMAT ou OUT_OF_MEMORY).
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> JsonParser::parseTcp()
+{
+    return parseTcpSection(ConfigSchema<TcpConfig>::section);
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e valida a configuração UART do objeto "UART".
+******************************************************************************.
+* @return: std::expected<UartConfig, ErrorCode> - A configuração UART, PARSE_ERROR, ou o erro da carga (INVALID_FORMAT ou OUT_OF_MEMORY).
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> JsonParser::parseUart()
+{
+    return parseUartSection(ConfigSchema<UartConfig>::section);
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna os nomes dos objetos do documento que contêm valores escalares.
+******************************************************************************.
+* @return: std::span<const std::string_view> - Os nomes, na ordem em que aparecem, ou uma lista vazia se a carga falhou.
+******************************************************************************
+*/
+std::span<const std::string_view> JsonParser::sectionNames() const
+{
+    if (m_loadError)
+    {
+        return {};
+    }
+    return m_index.sections();
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e valida a configuração TCP de um objeto específico, como "TCP3". Pode ser chamado por várias threads ao mesmo tempo.
+******************************************************************************.
+* @param: section - O nome do objeto.
+* @return: std::expected<TcpConfig, ErrorCode> - A configuração TCP, PARSE_ERROR, ou o erro da carga.
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> JsonParser::parseTcpSection(std::string_view section) const
+{
+    if (m_loadError)
+    {
+        return std::unexpected(*m_loadError);
+    }
+    return bindConfig<TcpConfig>([this, section](std::string_view key) { return findValue(section, key); });
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e valida a configuração UART de um objeto específico, como "UART12", análogo ao método parseTcpSection.
+******************************************************************************.
+* @param: section - O nome do objeto.
+* @return: std::expected<UartConfig, ErrorCode> - A configuração UART, PARSE_ERROR, ou o erro da carga.
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> JsonParser::parseUartSection(std::string_view section) const
+{
+    if (m_loadError)
+    {
+        return std::unexpected(*m_loadError);
+    }
+    return bindConfig<UartConfig>([this, section](std::string_view key) { return findValue(section, key); });
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a posição de uma chave no documento, para descrever erros.
+* @details : Para um documento mal formado, a posição é a do ponto em que ele deixou de ser válido, qualquer que seja a chave. Os valores e os nomes decodificados (com sequências de escape) não estão no arquivo, e a sua posição não é conhecida.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave, ou vazio para localizar apenas a seção.
+* @return: SourceLocation - O caminho do arquivo, com linha e coluna 0 se a posição não for conhecida.
+******************************************************************************
+*/
+SourceLocation JsonParser::locate(std::string_view section, std::string_view key) const
+{
+    SourceLocation location;
+    if (m_loadError == ErrorCode::INVALID_FORMAT)
+    {
+        location = iniPositionOf(m_file.view(), m_file.view().data() + m_errorOffset);
+    }
+    else if (!m_loadError)
+    {
+        if (auto value = key.empty() ? std::nullopt : findValue(section, key))
+        {
+            location = iniPositionOf(m_file.view(), value->data());
+        }
+        else
+        {
+            for (std::string_view name : m_index.sections())
+            {
+                if (name == section)
+                {
+                    location = iniPositionOf(m_file.view(), name.data());
+                    break;
+                }
+            }
+        }
+    }
+    location.file = m_filePath;
+    return location;
+}
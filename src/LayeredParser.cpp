@@ -0,0 +1,313 @@
+/*
+ * LayeredParser.cpp
+ *
+ * Implementação da classe LayeredParser, que carrega a configuração a partir de um arquivo INI base e dos fragmentos de um diretório no estilo conf.d.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "LayeredParser.hpp"
+#include "ConfigSchema.hpp"
+#include "IniTokenizer.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <filesystem>
+/*----------------------------------------------------------------------------*/
+
+/**
+******************************************************************************
+* @brief   : Lista os fragmentos de configuração de um diretório.
+******************************************************************************.
+* @param: directoryPath - O caminho do diretório.
+* @return: std::expected<std::vector<std::string>, ErrorCode> - Os caminhos dos arquivos regulares com a extensão .ini, em ordem alfabética do nome (que define a precedência), ou FILE_OPEN_FAILED se o diretório existir mas não puder ser lido. Um diretório inexistente resulta em uma lista vazia.
+******************************************************************************
+*/
+static std::expected<std::vector<std::string>, ErrorCode> listFragments(const std::string& directoryPath)
+{
+    std::vector<std::string> fragments; // Caminhos dos fragmentos encontrados.
+    std::error_code error; // Erros de consulta ao sistema de arquivos.
+    if (directoryPath.empty() || !std::filesystem::is_directory(directoryPath, error)) // O diretório de fragmentos é opcional.
+    {
+        return fragments;
+    }
+
+    std::filesystem::directory_iterator iterator(directoryPath, error); // Percorre as entradas do diretório.
+    if (error)
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    for (const std::filesystem::directory_entry& entry : iterator) // Seleciona os arquivos regulares .ini; os demais (por exemplo, arquivos temporários de editores) são ignorados.
+    {
+        if (entry.path().extension() == ".ini" && entry.is_regular_file(error))
+        {
+            fragments.push_back(entry.path().string());
+        }
+    }
+    std::sort(fragments.begin(), fragments.end(), [](const std::string& left, const std::string& right) // Ordena pelo nome do arquivo, como em um diretório conf.d (por exemplo, 10-site.ini antes de 20-device.ini).
+    {
+        return std::filesystem::path(left).filename() < std::filesystem::path(right).filename();
+    });
+    return fragments;
+}
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe LayeredParser, que carrega e combina todas as camadas.
+* @details : A carga tem duas fases. Na primeira, cada camada é mapeada em memória e tokenizada em uma thread do pool, gravando os seus pares em uma lista própria; nenhuma camada depende das outras, de modo que milhares de fragmentos não são lidos um após o outro. Na segunda, as listas são inseridas no índice na ordem das camadas, em uma única thread: como uma inserção sobrescreve o valor anterior, a última camada prevalece para cada par (seção, chave), independentemente da ordem em que as threads terminaram.
+******************************************************************************.
+* @param: basePath - O caminho do arquivo INI base (camada 0).
+* @param: directoryPath - O caminho do diretório de fragmentos.
+* @param: threadCount - A quantidade de threads usadas para ler e tokenizar as camadas.
+******************************************************************************
+*/
+LayeredParser::LayeredParser(const std::string& basePath, const std::string& directoryPath, unsigned threadCount)
+{
+    auto fragments = listFragments(directoryPath); // Fragmentos do diretório, em ordem de precedência.
+    if (!fragments)
+    {
+        m_loadError = fragments.error();
+        return;
+    }
+
+    m_layers.resize(fragments->size() + 1); // O arquivo base seguido dos fragmentos.
+    m_layers[0].path = basePath;
+    for (std::size_t i = 0; i < fragments->size(); ++i)
+    {
+        m_layers[i + 1].path = std::move((*fragments)[i]);
+    }
+
+    bool measure = configMetricsEnabled(); // Com a instrumentação desligada, nenhum relógio é lido.
+    MetricsClock::time_point start = measure ? MetricsClock::now() : MetricsClock::time_point{}; // Início da carga.
+    std::vector<std::vector<IniToken>> tokens(m_layers.size()); // Pares de cada camada, gravados por uma única thread cada.
+    std::vector<std::size_t> lines(m_layers.size()); // Linhas de cada camada.
+    ThreadPool pool(threadCount); // Threads usadas apenas durante a carga.
+    pool.parallelFor(m_layers.size(), [this, &tokens, &lines](std::size_t i) // Mapeia e tokeniza cada camada de forma independente.
+    {
+        m_layers[i].file = MappedFile(m_layers[i].path);
+        IniTokenizer tokenizer(m_layers[i].file.view()); // Tokenizador que percorre o conteúdo mapeado sem copiá-lo.
+        IniToken token; // Par chave/valor extraído de cada linha, junto com a sua seção.
+        while (tokenizer.next(token))
+        {
+            tokens[i].push_back(token);
+        }
+        lines[i] = tokenizer.lineCount();
+    });
+    if (measure) // As camadas são lidas e tokenizadas ao mesmo tempo; o tempo da fase paralela inteira é atribuído à E/S.
+    {
+        m_metrics.ioNs = metricsElapsedNs(start);
+        start = MetricsClock::now();
+        for (std::size_t i = 0; i < m_layers.size(); ++i)
+        {
+            m_metrics.bytes += m_layers[i].file.size();
+            m_metrics.lines += lines[i];
+        }
+    }
+
+    std::size_t totalTokens = 0; // Quantidade total de pares, usada para dimensionar o índice de uma só vez.
+    for (std::size_t i = 0; i < m_layers.size(); ++i)
+    {
+        if (!m_layers[i].file.isOpen()) // Uma camada ilegível invalida a combinação inteira.
+        {
+            m_loadError = ErrorCode::FILE_OPEN_FAILED;
+            return;
+        }
+        totalTokens += tokens[i].size();
+    }
+
+    m_index.reserve(totalTokens);
+    for (std::size_t i = 0; i < m_layers.size(); ++i) // Combina as camadas em ordem: a última inserção de cada par prevalece.
+    {
+        for (const IniToken& token : tokens[i])
+        {
+            m_index.insert(token.section, token.key, token.value, static_cast<std::uint32_t>(i));
+        }
+    }
+    if (measure)
+    {
+        m_metrics.tokenizeNs = metricsElapsedNs(start);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Procura a entrada de uma chave em uma seção, já combinada entre as camadas.
+* @details : Se a chave não existir na seção indicada, ela é procurada na seção global, da mesma forma que no IniParser.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @return: const IniEntry* - A entrada encontrada, ou nullptr se a chave não existir.
+******************************************************************************
+*/
+const IniEntry* LayeredParser::findEntry(std::string_view section, std::string_view key) const
+{
+    if (const IniEntry* entry = m_index.findEntry(section, key)) // Procura primeiro na seção indicada.
+    {
+        return entry;
+    }
+    return m_index.findEntry({}, key); // Se não encontrar, procura na seção global.
+}
+
+/**
+******************************************************************************
+* @brief   : Procura o valor de uma chave em uma seção, já combinado entre as camadas.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @return: std::optional<std::string_view> - O valor da última camada que declarou a chave, ou std::nullopt se a chave não existir (ou se alguma camada não pôde ser lida).
+******************************************************************************
+*/
+std::optional<std::string_view> LayeredParser::findValue(std::string_view section, std::string_view key) const
+{
+    if (m_loadError) // Uma combinação incompleta não é consultada.
+    {
+        return std::nullopt;
+    }
+    if (const IniEntry* entry = findEntry(section, key))
+    {
+        return entry->value;
+    }
+    return std::nullopt;
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna o caminho do arquivo de onde veio o valor de uma chave.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave.
+* @return: std::optional<std::string_view> - O caminho da última camada que declarou a chave, ou std::nullopt se a chave não existir.
+******************************************************************************
+*/
+std::optional<std::string_view> LayeredParser::originOf(std::string_view section, std::string_view key) const
+{
+    if (const IniEntry* entry = findEntry(section, key))
+    {
+        return m_layers[entry->origin].path;
+    }
+    return std::nullopt;
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e interpreta a configuração TCP resultante da combinação das camadas.
+******************************************************************************.
+* @return: std::expected<TcpConfig, ErrorCode> - A configuração TCP, ou o código de erro da carga ou da validação.
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> LayeredParser::parseTcp()
+{
+    return parseTcpSection(ConfigSchema<TcpConfig>::section); // Interpreta a seção [TCP].
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e interpreta a configuração UART resultante da combinação das camadas.
+******************************************************************************.
+* @return: std::expected<UartConfig, ErrorCode> - A configuração UART, ou o código de erro da carga ou da validação.
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> LayeredParser::parseUart()
+{
+    return parseUartSection(ConfigSchema<UartConfig>::section); // Interpreta a seção [UART].
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna os nomes das seções de todas as camadas.
+******************************************************************************.
+* @return: std::span<const std::string_view> - Os nomes das seções, na ordem em que aparecem pela primeira vez (do arquivo base para os fragmentos).
+******************************************************************************
+*/
+std::span<const std::string_view> LayeredParser::sectionNames() const
+{
+    return m_index.sections(); // Seções registradas pelo índice durante a combinação.
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e interpreta a configuração TCP de uma seção específica, já combinada entre as camadas.
+* @details : Cada campo vem da última camada que o declarou; uma sobrescrita pode, portanto, alterar apenas a porta e manter o IP do arquivo base. O índice não é alterado depois da carga, de modo que este método pode ser chamado por várias threads ao mesmo tempo.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<TcpConfig, ErrorCode> - A configuração TCP, ou o código de erro da carga ou da validação.
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> LayeredParser::parseTcpSection(std::string_view section) const
+{
+    if (m_loadError) // Uma carga incompleta nunca produz configurações.
+    {
+        return std::unexpected(*m_loadError);
+    }
+    return bindConfig<TcpConfig>([this, section](std::string_view key) { return findValue(section, key); }); // Preenche e valida a estrutura TcpConfig a partir do seu esquema.
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e interpreta a configuração UART de uma seção específica, análogo ao método parseTcpSection.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<UartConfig, ErrorCode> - A configuração UART, ou o código de erro da carga ou da validação.
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> LayeredParser::parseUartSection(std::string_view section) const
+{
+    if (m_loadError) // Uma carga incompleta nunca produz configurações.
+    {
+        return std::unexpected(*m_loadError);
+    }
+    return bindConfig<UartConfig>([this, section](std::string_view key) { return findValue(section, key); }); // Preenche e valida a estrutura UartConfig a partir do seu esquema.
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a posição de uma chave, na camada de onde veio o seu valor, para descrever erros.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave, ou vazio para localizar apenas a seção.
+* @return: SourceLocation - O caminho da camada, a linha e a coluna. Se a carga falhou, o caminho é o da primeira camada ilegível, com linha 0; se nem a chave nem a seção forem encontradas, a linha é 0 e o caminho é o do arquivo base.
+******************************************************************************
+*/
+SourceLocation LayeredParser::locate(std::string_view section, std::string_view key) const
+{
+    SourceLocation location;
+    const char* position = nullptr; // Início do valor ou do nome da seção, dentro de alguma camada.
+    if (!m_loadError)
+    {
+        if (const IniEntry* entry = key.empty() ? nullptr : findEntry(section, key))
+        {
+            position = entry->value.data();
+        }
+        else
+        {
+            for (std::string_view name : m_index.sections())
+            {
+                if (name == section)
+                {
+                    position = name.data();
+                    break;
+                }
+            }
+        }
+    }
+    for (const ConfigLayer& layer : m_layers) // Procura a camada que contém a posição ou, se a carga falhou, a primeira camada ilegível.
+    {
+        if (m_loadError && !layer.file.isOpen())
+        {
+            location.file = layer.path;
+            return location;
+        }
+        location = iniPositionOf(layer.file.view(), position);
+        if (location.line != 0)
+        {
+            location.file = layer.path;
+            return location;
+        }
+    }
+    if (!m_layers.empty())
+    {
+        location.file = m_layers.front().path;
+    }
+    return location;
+}
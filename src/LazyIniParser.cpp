@@ -0,0 +1,443 @@
+/*
+ * LazyIniParser.cpp
+ *
+ * Implementação da classe LazyIniParser, que localiza as seções de um arquivo INI na carga e tokeniza cada uma delas somente na primeira consulta.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "LazyIniParser.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+#include "ConfigSchema.hpp"
+#include "IniTokenizer.hpp"
+/*----------------------------------------------------------------------------*/
+
+/**
+******************************************************************************
+* @brief   : Retorna a posição do final de uma linha.
+******************************************************************************.
+* @param: text - O texto completo do arquivo.
+* @param: position - Uma posição dentro da linha.
+* @return: std::size_t - A posição do '\n' que encerra a linha, ou o tamanho do texto se ela for a última.
+******************************************************************************
+*/
+static std::size_t lineEndOf(std::string_view text, std::size_t position)
+{
+    const void* found = std::memchr(text.data() + position, '\n', text.size() - position);
+    return found ? static_cast<std::size_t>(static_cast<const char*>(found) - text.data()) : text.size();
+}
+
+/**
+******************************************************************************
+* @brief   : Procura a próxima linha que pode ser um cabeçalho de seção.
+* @details : Em vez de percorrer o texto linha a linha, procura apenas o caractere '[' com memchr. Um '[' só inicia um cabeçalho se for precedido, na sua linha, somente por espaços e tabulações; os que aparecem em valores e comentários são descartados examinando apenas os bytes anteriores a ele. Como parseIniLine nunca trata uma linha iniciada por '[' como um par chave/valor, as linhas encontradas aqui são exatamente as que delimitam as seções.
+******************************************************************************.
+* @param: text - O texto completo do arquivo.
+* @param: position - A posição a partir da qual procurar.
+* @return: std::size_t - A posição do início da linha candidata, ou std::string_view::npos se não houver.
+******************************************************************************
+*/
+static std::size_t findHeaderLine(std::string_view text, std::size_t position)
+{
+    while (position < text.size())
+    {
+        const void* found = std::memchr(text.data() + position, '[', text.size() - position);
+        if (!found)
+        {
+            break;
+        }
+        std::size_t bracket = static_cast<std::size_t>(static_cast<const char*>(found) - text.data()); // Posição do '['.
+        std::size_t lineStart = bracket; // Recua sobre a indentação da linha.
+        while (lineStart > 0 && (text[lineStart - 1] == ' ' || text[lineStart - 1] == '\t'))
+        {
+            --lineStart;
+        }
+        if (lineStart == 0 || text[lineStart - 1] == '\n') // Somente espaços antes do '['.
+        {
+            return lineStart;
+        }
+        position = bracket + 1;
+    }
+    return std::string_view::npos;
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica se o corpo de uma seção contém algum par chave/valor.
+* @details : As linhas são examinadas até a primeira que contém uma chave, que normalmente é a primeira do corpo; somente seções com muitos comentários ou linhas vazias no início custam mais que uma linha.
+******************************************************************************.
+* @param: body - O corpo da seção.
+* @return: bool - Retorna true se alguma linha do corpo for um par chave/valor.
+******************************************************************************
+*/
+static bool containsKey(std::string_view body)
+{
+    std::size_t position = 0;
+    while (position < body.size())
+    {
+        std::size_t lineEnd = lineEndOf(body, position);
+        std::string_view first;
+        std::string_view second;
+        if (parseIniLine(body.substr(position, lineEnd - position), first, second) == IniLineType::KEY_VALUE)
+        {
+            return true;
+        }
+        position = lineEnd + 1;
+    }
+    return false;
+}
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe LazyIniParser.
+* @details : Mapeia o arquivo e localiza as seções. Nenhuma linha de chave é tokenizada; o custo da carga é uma varredura do arquivo com memchr e uma entrada na tabela de seções por cabeçalho.
+******************************************************************************.
+* @param: filePath - O caminho do arquivo INI. Se ele não puder ser aberto, o parser se comporta como o de um arquivo vazio.
+* @param: resource - O recurso de memória da tabela de seções e dos índices. Se ele se esgotar durante a carga, o parser passa a retornar OUT_OF_MEMORY em todas as consultas.
+******************************************************************************
+*/
+LazyIniParser::LazyIniParser(const std::string& filePath, std::pmr::memory_resource* resource)
+    : m_memory(resource, configMetricsEnabled()), m_filePath(&m_memory), m_ranges(&m_memory), m_sections(&m_memory), m_sectionNames(&m_memory), m_parsed(&m_memory)
+{
+    bool measure = configMetricsEnabled(); // Com a instrumentação desligada, nenhum relógio é lido.
+    MetricsClock::time_point start = measure ? MetricsClock::now() : MetricsClock::time_point{}; // Início da leitura do arquivo.
+    m_file = MappedFile(filePath);
+    if (measure)
+    {
+        m_metrics.ioNs = metricsElapsedNs(start);
+    }
+    buildSectionTable(filePath, measure);
+}
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe LazyIniParser a partir de um arquivo já aberto.
+******************************************************************************.
+* @param: file - O conteúdo do arquivo. O parser passa a ser o seu dono.
+* @param: filePath - O caminho do arquivo, usado para descrever erros.
+* @param: resource - O recurso de memória da tabela de seções e dos índices.
+******************************************************************************
+*/
+LazyIniParser::LazyIniParser(MappedFile file, const std::string& filePath, std::pmr::memory_resource* resource)
+    : m_memory(resource, configMetricsEnabled()), m_filePath(&m_memory), m_file(std::move(file)), m_ranges(&m_memory), m_sections(&m_memory), m_sectionNames(&m_memory), m_parsed(&m_memory)
+{
+    buildSectionTable(filePath, configMetricsEnabled());
+}
+
+/**
+******************************************************************************
+* @brief   : Localiza os cabeçalhos das seções e registra o corpo de cada uma.
+* @details : As chaves anteriores ao primeiro cabeçalho formam a seção global. Cabeçalhos malformados não encerram a seção corrente, assim como no IniTokenizer.
+******************************************************************************.
+* @param: filePath - O caminho do arquivo, guardado para descrever erros.
+* @param: measure - Indica se as medidas da carga devem ser coletadas.
+******************************************************************************
+*/
+void LazyIniParser::buildSectionTable(const std::string& filePath, bool measure)
+{
+    MetricsClock::time_point start = measure ? MetricsClock::now() : MetricsClock::time_point{}; // Início da localização das seções.
+    std::string_view text = m_file.view(); // Vazio se o arquivo não pôde ser aberto.
+    try // Os recursos de memória sinalizam o esgotamento com std::bad_alloc.
+    {
+        m_filePath = filePath;
+        std::string_view current; // Seção corrente (a global, antes do primeiro cabeçalho).
+        std::size_t bodyStart = 0; // Início do corpo da seção corrente.
+        std::size_t position = 0; // Posição a partir da qual o próximo cabeçalho é procurado.
+        while (true)
+        {
+            std::size_t lineStart = findHeaderLine(text, position);
+            if (lineStart == std::string_view::npos)
+            {
+                addRange(current, bodyStart, text.size());
+                break;
+            }
+            std::size_t lineEnd = lineEndOf(text, lineStart);
+            std::string_view name;
+            std::string_view unused;
+            if (parseIniLine(text.substr(lineStart, lineEnd - lineStart), name, unused) == IniLineType::SECTION)
+            {
+                addRange(current, bodyStart, lineStart);
+                current = name;
+                bodyStart = std::min(lineEnd + 1, text.size());
+            }
+            position = lineEnd + 1;
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        m_loadError = ErrorCode::OUT_OF_MEMORY; // A tabela está incompleta e não pode ser consultada.
+    }
+
+    if (measure)
+    {
+        m_metrics.tokenizeNs = metricsElapsedNs(start);
+        m_metrics.bytes = text.size();
+        m_metrics.lines = static_cast<std::uint64_t>(std::count(text.begin(), text.end(), '\n')) + (!text.empty() && text.back() != '\n' ? 1 : 0);
+        m_metrics.peakMemoryBytes = m_memory.peak();
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Registra o corpo de uma seção.
+* @details : Corpos sem nenhuma chave não são registrados, de modo que sectionNames lista as mesmas seções que o IniParser. Os trechos de uma seção repetida são encadeados na ordem do arquivo, para que a última declaração de uma chave prevaleça.
+******************************************************************************.
+* @param: name - O nome da seção.
+* @param: begin - O início do corpo.
+* @param: end - O final do corpo.
+******************************************************************************
+*/
+void LazyIniParser::addRange(std::string_view name, std::size_t begin, std::size_t end)
+{
+    if (begin >= end || !containsKey(m_file.view().substr(begin, end - begin)))
+    {
+        return;
+    }
+    std::uint32_t range = static_cast<std::uint32_t>(m_ranges.size()); // Posição do novo trecho.
+    m_ranges.push_back(SectionRange{begin, end, NO_RANGE});
+    auto [found, inserted] = m_sections.try_emplace(name);
+    Section& section = found->second;
+    if (inserted) // Primeira aparição da seção com chaves.
+    {
+        section.name = name;
+        section.firstRange = range;
+        m_sectionNames.push_back(name);
+    }
+    else
+    {
+        m_ranges[section.lastRange].next = range;
+    }
+    section.lastRange = range;
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna o índice de uma seção, construindo-o na primeira consulta.
+* @details : O caso comum (seção já indexada) é uma leitura atômica com semântica de aquisição, sem lock. Na primeira consulta, o mutex garante que a seção seja tokenizada uma única vez, mesmo que várias threads a consultem ao mesmo tempo; o índice só é publicado depois de completo.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<const IniIndex*, ErrorCode> - O índice da seção, nullptr se ela não contiver chaves, ou OUT_OF_MEMORY se o recurso de memória se esgotou (a indexação é tentada novamente na próxima consulta).
+******************************************************************************
+*/
+std::expected<const IniIndex*, ErrorCode> LazyIniParser::sectionIndex(std::string_view section) const
+{
+    auto found = m_sections.find(section);
+    if (found == m_sections.end())
+    {
+        return nullptr;
+    }
+    const Section& entry = found->second;
+    if (const IniIndex* index = entry.index.load(std::memory_order_acquire))
+    {
+        return index;
+    }
+
+    std::lock_guard<std::mutex> lock(m_parseMutex);
+    if (const IniIndex* index = entry.index.load(std::memory_order_relaxed)) // Indexada por outra thread enquanto esta esperava.
+    {
+        return index;
+    }
+    try
+    {
+        IniIndex& index = m_parsed.emplace_back(&m_memory);
+        try
+        {
+            std::string_view text = m_file.view();
+            for (std::uint32_t range = entry.firstRange; range != NO_RANGE; range = m_ranges[range].next)
+            {
+                IniTokenizer tokenizer(text.substr(m_ranges[range].begin, m_ranges[range].end - m_ranges[range].begin)); // O trecho não contém cabeçalhos válidos.
+                IniToken token;
+                while (tokenizer.next(token))
+                {
+                    index.insert(entry.name, token.key, token.value);
+                }
+            }
+        }
+        catch (const std::bad_alloc&)
+        {
+            m_parsed.pop_back(); // Descarta o índice incompleto.
+            throw;
+        }
+        entry.index.store(&index, std::memory_order_release);
+        return &index;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Procura o valor de uma chave em uma seção do arquivo.
+* @details : A seção é indexada na primeira consulta; se a chave não existir nela, a seção global é consultada (e indexada) da mesma forma.
+******************************************************************************.
+* @param: section - O nome da seção (por exemplo, "TCP").
+* @param: key - O nome da chave (por exemplo, "port").
+* @return: std::optional<std::string_view> - O valor encontrado, ou std::nullopt se a chave não existir (ou se a carga ou a indexação falhou).
+******************************************************************************
+*/
+std::optional<std::string_view> LazyIniParser::findValue(std::string_view section, std::string_view key) const
+{
+    if (m_loadError)
+    {
+        return std::nullopt;
+    }
+    auto index = sectionIndex(section);
+    if (!index)
+    {
+        return std::nullopt;
+    }
+    if (*index)
+    {
+        if (auto value = (*index)->find(section, key))
+        {
+            return value;
+        }
+    }
+    auto global = sectionIndex({});
+    return global && *global ? (*global)->find({}, key) : std::nullopt;
+}
+
+/**
+******************************************************************************
+* @brief   : Indexa uma seção e a seção global e preenche uma configuração pelo seu esquema.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<T, ErrorCode> - A configuração, PARSE_ERROR, ou o erro da carga ou da indexação (OUT_OF_MEMORY).
+******************************************************************************
+*/
+template <typename T>
+std::expected<T, ErrorCode> LazyIniParser::parseSection(std::string_view section) const
+{
+    if (m_loadError) // A carga falhou; nenhuma seção pode ser interpretada.
+    {
+        return std::unexpected(*m_loadError);
+    }
+    auto index = sectionIndex(section); // Indexados antes do preenchimento, para que um esgotamento de memória seja informado como tal.
+    auto global = sectionIndex({});
+    if (!index || !global)
+    {
+        return std::unexpected(ErrorCode::OUT_OF_MEMORY);
+    }
+    return bindConfig<T>([section, local = *index, fallback = *global](std::string_view key) -> std::optional<std::string_view>
+    {
+        if (auto value = local ? local->find(section, key) : std::nullopt)
+        {
+            return value;
+        }
+        return fallback ? fallback->find({}, key) : std::nullopt;
+    });
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e valida a configuração TCP da seção [TCP].
+******************************************************************************.
+* @return: std::expected<TcpConfig, ErrorCode> - A configuração TCP ou um código de erro.
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> LazyIniParser::parseTcp()
+{
+    return parseTcpSection(ConfigSchema<TcpConfig>::section);
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e valida a configuração UART da seção [UART].
+******************************************************************************.
+* @return: std::expected<UartConfig, ErrorCode> - A configuração UART ou um código de erro.
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> LazyIniParser::parseUart()
+{
+    return parseUartSection(ConfigSchema<UartConfig>::section);
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna os nomes das seções que contêm chaves.
+******************************************************************************.
+* @return: std::span<const std::string_view> - Os nomes, na ordem em que aparecem no arquivo, ou uma lista vazia se a carga falhou.
+******************************************************************************
+*/
+std::span<const std::string_view> LazyIniParser::sectionNames() const
+{
+    if (m_loadError)
+    {
+        return {};
+    }
+    return m_sectionNames;
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e valida a configuração TCP de uma seção específica, como [TCP3].
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<TcpConfig, ErrorCode> - A configuração TCP da seção, PARSE_ERROR, ou OUT_OF_MEMORY.
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> LazyIniParser::parseTcpSection(std::string_view section) const
+{
+    return parseSection<TcpConfig>(section);
+}
+
+/**
+******************************************************************************
+* @brief   : Lê e valida a configuração UART de uma seção específica, como [UART12].
+******************************************************************************.
+* @param: section - O nome da seção.
+* @return: std::expected<UartConfig, ErrorCode> - A configuração UART da seção, PARSE_ERROR, ou OUT_OF_MEMORY.
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> LazyIniParser::parseUartSection(std::string_view section) const
+{
+    return parseSection<UartConfig>(section);
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a posição de uma chave no arquivo, para descrever erros.
+* @details : Como no IniParser, a posição é calculada a partir do endereço do valor, ou do nome da seção, dentro do arquivo mapeado.
+******************************************************************************.
+* @param: section - O nome da seção.
+* @param: key - O nome da chave, ou vazio para localizar apenas a seção.
+* @return: SourceLocation - O caminho do arquivo, com linha e coluna 0 se nem a chave nem a seção forem encontradas (ou se a carga falhou).
+******************************************************************************
+*/
+SourceLocation LazyIniParser::locate(std::string_view section, std::string_view key) const
+{
+    SourceLocation location;
+    if (!m_loadError)
+    {
+        if (auto value = key.empty() ? std::nullopt : findValue(section, key))
+        {
+            location = iniPositionOf(m_file.view(), value->data());
+        }
+        else if (auto found = m_sections.find(section); found != m_sections.end())
+        {
+            location = iniPositionOf(m_file.view(), found->second.name.data());
+        }
+    }
+    location.file = m_filePath;
+    return location;
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a quantidade de seções já indexadas.
+******************************************************************************.
+* @return: std::size_t - As seções tokenizadas até o momento, inclusive a global.
+******************************************************************************
+*/
+std::size_t LazyIniParser::parsedSectionCount() const
+{
+    std::lock_guard<std::mutex> lock(m_parseMutex);
+    return m_parsed.size();
+}
@@ -0,0 +1,248 @@
+/*
+ * MappedFile.cpp
+ *
+ * Implementação da classe MappedFile, responsável por disponibilizar o conteúdo completo de um arquivo como um único bloco contíguo de memória somente leitura.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "MappedFile.hpp"
+#include <cerrno>
+#include <filesystem>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_USE_MMAP 1
+#else
+#include <fstream>
+#endif
+/*----------------------------------------------------------------------------*/
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe MappedFile, que abre o arquivo e disponibiliza o seu conteúdo em memória.
+* @details : Em sistemas POSIX o arquivo é mapeado com mmap, sem nenhuma cópia para o heap; o descritor é fechado logo após o mapeamento, pois a região permanece válida. Nas demais plataformas o arquivo é lido de uma só vez para um buffer próprio, com uma única alocação do tamanho exato do arquivo.
+******************************************************************************.
+* @param: filePath - O caminho para o arquivo a ser aberto.
+******************************************************************************
+*/
+MappedFile::MappedFile(const std::string& filePath)
+{
+#if defined(MAPPED_FILE_USE_MMAP)
+    int fd = ::open(filePath.c_str(), O_RDONLY); // Abre o arquivo somente para leitura.
+    if (fd < 0) // Se o arquivo não puder ser aberto (não existe ou falta permissão), o MappedFile permanece fechado.
+    {
+        return;
+    }
+
+    struct stat info; // Estrutura que recebe as informações do arquivo, incluindo o seu tamanho.
+    if (::fstat(fd, &info) != 0) // Se não for possível consultar o tamanho, o arquivo é tratado como não aberto.
+    {
+        ::close(fd);
+        return;
+    }
+
+    m_size = static_cast<std::size_t>(info.st_size); // Armazena o tamanho do arquivo.
+    if (m_size > 0) // O mmap não aceita regiões de tamanho zero, então arquivos vazios não são mapeados.
+    {
+        void* region = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0); // Mapeia o arquivo inteiro como somente leitura.
+        if (region == MAP_FAILED) // Se o mapeamento falhar, o arquivo é tratado como não aberto.
+        {
+            ::close(fd);
+            m_size = 0;
+            return;
+        }
+        ::madvise(region, m_size, MADV_SEQUENTIAL); // Informa ao kernel que o conteúdo será percorrido sequencialmente, favorecendo a leitura antecipada.
+        m_data = static_cast<const char*>(region); // Aponta para o início da região mapeada.
+        m_isMapped = true; // Marca que a região precisa ser liberada com munmap.
+    }
+    ::close(fd); // O descritor não é mais necessário após o mapeamento.
+    m_isOpen = true; // Marca o arquivo como aberto com sucesso.
+#else
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate); // Abre o arquivo em modo binário, posicionado no final para obter o tamanho.
+    if (!file.is_open()) // Se o arquivo não puder ser aberto, o MappedFile permanece fechado.
+    {
+        return;
+    }
+
+    m_buffer.resize(static_cast<std::size_t>(file.tellg())); // Reserva o buffer com o tamanho exato do arquivo, em uma única alocação.
+    file.seekg(0); // Volta para o início do arquivo.
+    file.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size())); // Lê o arquivo inteiro de uma só vez.
+    m_data = m_buffer.data(); // Aponta para o início do buffer próprio.
+    m_size = m_buffer.size(); // Armazena o tamanho do conteúdo.
+    m_isOpen = true; // Marca o arquivo como aberto com sucesso.
+#endif
+}
+
+/**
+******************************************************************************
+* @brief   : Destrutor da classe MappedFile, que libera a região mapeada ou o buffer próprio.
+******************************************************************************
+*/
+MappedFile::~MappedFile()
+{
+    release(); // Libera os recursos associados ao arquivo.
+}
+
+/**
+******************************************************************************
+* @brief   : Construtor de movimentação, que transfere a posse do conteúdo de outro MappedFile.
+* @details : Quando o conteúdo está em um buffer próprio, o ponteiro m_data é recalculado após a movimentação, pois o buffer pode ter mudado de endereço (por exemplo, em strings curtas).
+******************************************************************************.
+* @param: other - O MappedFile de origem, que fica vazio e fechado após a movimentação.
+******************************************************************************
+*/
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other); // Reaproveita a lógica da atribuição por movimentação.
+}
+
+/**
+******************************************************************************
+* @brief   : Atribuição por movimentação, análoga ao construtor de movimentação.
+******************************************************************************.
+* @param: other - O MappedFile de origem, que fica vazio e fechado após a movimentação.
+* @return: MappedFile& - Referência para este objeto.
+******************************************************************************
+*/
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) // Evita a auto-atribuição.
+    {
+        release(); // Libera o conteúdo atual antes de assumir o novo.
+        m_isMapped = std::exchange(other.m_isMapped, false); // Transfere a posse da região mapeada.
+        m_isOpen = std::exchange(other.m_isOpen, false); // Transfere o estado de abertura.
+        m_size = std::exchange(other.m_size, 0); // Transfere o tamanho do conteúdo.
+        m_buffer = std::move(other.m_buffer); // Transfere o buffer próprio, se existir.
+        m_data = m_isMapped ? std::exchange(other.m_data, nullptr) : m_buffer.data(); // Recalcula o ponteiro quando o conteúdo está no buffer próprio.
+        other.m_data = nullptr; // Deixa a origem vazia.
+    }
+    return *this;
+}
+
+/**
+******************************************************************************
+* @brief   : Libera a região mapeada ou o buffer próprio e volta ao estado vazio.
+******************************************************************************
+*/
+void MappedFile::release()
+{
+#if defined(MAPPED_FILE_USE_MMAP)
+    if (m_isMapped) // Somente regiões criadas com mmap precisam ser liberadas com munmap.
+    {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_buffer.clear(); // Libera o conteúdo do buffer próprio.
+    m_data = nullptr; // Volta ao estado vazio.
+    m_size = 0;
+    m_isOpen = false;
+    m_isMapped = false;
+}
+
+#if defined(MAPPED_FILE_USE_MMAP)
+/**
+******************************************************************************
+* @brief   : Grava um bloco inteiro em um descritor, repetindo as gravações parciais.
+******************************************************************************.
+* @param: fd - O descritor.
+* @param: bytes - Os bytes a serem gravados.
+* @return: bool - Retorna true se todos os bytes foram gravados.
+******************************************************************************
+*/
+bool writeAll(int fd, std::string_view bytes)
+{
+    while (!bytes.empty())
+    {
+        ssize_t written = ::write(fd, bytes.data(), bytes.size());
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        bytes.remove_prefix(static_cast<std::size_t>(written));
+    }
+    return true;
+}
+#endif
+
+/**
+******************************************************************************
+* @brief   : Sincroniza com o armazenamento o diretório que contém um arquivo.
+* @details : A criação e a renomeação de um arquivo alteram o diretório, e não o arquivo; sem esta sincronização, um arquivo novo (ou o nome novo) pode desaparecer em uma queda de energia, mesmo com o conteúdo já sincronizado.
+******************************************************************************.
+* @param: filePath - O caminho do arquivo.
+* @return: bool - Retorna true se a sincronização foi concluída (sempre, nas plataformas sem POSIX).
+******************************************************************************
+*/
+bool syncDirectory(const std::string& filePath)
+{
+#if defined(MAPPED_FILE_USE_MMAP)
+    std::string directory = std::filesystem::path(filePath).parent_path().string(); // Diretório que guarda a entrada do arquivo.
+    int directoryFd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (directoryFd < 0)
+    {
+        return false;
+    }
+    bool synced = ::fsync(directoryFd) == 0;
+    ::close(directoryFd);
+    return synced;
+#else
+    (void)filePath;
+    return true;
+#endif
+}
+
+/**
+******************************************************************************
+* @brief   : Substitui um arquivo de forma atômica e durável.
+* @details : O conteúdo é gravado em um arquivo temporário, sincronizado com o armazenamento e renomeado sobre o destino; em sistemas POSIX, o diretório também é sincronizado, para que a renomeação sobreviva a uma queda de energia. Um leitor sempre vê o arquivo anterior ou o novo, inteiro.
+******************************************************************************.
+* @param: filePath - O arquivo a ser substituído.
+* @param: content - O novo conteúdo.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou FILE_OPEN_FAILED (nesse caso, o arquivo não muda).
+******************************************************************************
+*/
+std::expected<void, ErrorCode> replaceFile(const std::string& filePath, std::string_view content)
+{
+    std::string temporaryPath = filePath + ".tmp"; // Arquivo temporário, renomeado somente depois de completo.
+#if defined(MAPPED_FILE_USE_MMAP)
+    struct stat original{}; // Permissões do arquivo substituído, preservadas no novo.
+    mode_t mode = ::stat(filePath.c_str(), &original) == 0 ? (original.st_mode & 07777) : 0644;
+    int fd = ::open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode);
+    if (fd < 0)
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    bool written = writeAll(fd, content) && ::fsync(fd) == 0;
+    written = ::close(fd) == 0 && written;
+#else
+    bool written = false;
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        output.write(content.data(), static_cast<std::streamsize>(content.size()));
+        written = static_cast<bool>(output.flush());
+    }
+#endif
+    std::error_code error; // Erro da renomeação.
+    if (written)
+    {
+        std::filesystem::rename(temporaryPath, filePath, error); // Publica o arquivo de forma atômica.
+    }
+    if (!written || error)
+    {
+        std::filesystem::remove(temporaryPath, error);
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED);
+    }
+    syncDirectory(filePath); // Guarda a renomeação. O arquivo novo já está publicado, por isso uma falha aqui não é revertida.
+    return {};
+}
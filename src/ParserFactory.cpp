@@ -0,0 +1,125 @@
+/*
+ * ParserFactory.cpp
+ *
+ * Implementação da função Factory createParser, responsável por escolher e instanciar o parser adequado para um arquivo de configuração.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ParserFactory.hpp"
+#include <cstddef>
+#include <utility>
+#include "BinarySnapshot.hpp"
+#include "IniParser.hpp"
+#include "JsonParser.hpp"
+#include "LayeredParser.hpp"
+#include "LazyIniParser.hpp"
+#include "MappedFile.hpp"
+/*----------------------------------------------------------------------------*/
+
+/**
+******************************************************************************
+* @brief   : Retorna o caminho do snapshot binário associado a um arquivo de configuração.
+******************************************************************************.
+* @param: filePath - O caminho para o arquivo de configuração.
+* @return: std::string - O caminho do snapshot (por exemplo, "config.ini.snap").
+******************************************************************************
+*/
+std::string snapshotPathFor(const std::string& filePath)
+{
+    return filePath + ".snap"; // O snapshot fica ao lado do arquivo de origem.
+}
+
+static constexpr std::size_t SNIFF_LENGTH = 512; // Bytes examinados por detectConfigFormat à procura de conteúdo binário.
+
+/**
+******************************************************************************
+* @brief   : Detecta o formato de um arquivo de configuração pelo seu conteúdo.
+* @details : Depois da marca de ordem de bytes do UTF-8 (se houver) e dos espaços em branco, um '{' indica um documento JSON: um arquivo INI nunca começa com '{'. Qualquer outro texto é tratado como INI, inclusive um arquivo vazio. Se o início do arquivo tiver bytes nulos ou outros caracteres de controle que não aparecem em texto (por exemplo, um snapshot binário passado no lugar do INI), o formato é desconhecido.
+******************************************************************************.
+* @param: content - O conteúdo do arquivo (somente os primeiros bytes são examinados).
+* @return: ConfigFormat - O formato detectado.
+******************************************************************************
+*/
+ConfigFormat detectConfigFormat(std::string_view content)
+{
+    if (content.starts_with("\xEF\xBB\xBF")) // Marca de ordem de bytes do UTF-8.
+    {
+        content.remove_prefix(3);
+    }
+    for (char c : content.substr(0, SNIFF_LENGTH)) // Texto de configuração não tem caracteres de controle além de tabulação e quebras de linha.
+    {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if ((byte < 0x20 && c != '\t' && c != '\n' && c != '\r') || byte == 0x7F)
+        {
+            return ConfigFormat::UNKNOWN;
+        }
+    }
+    std::size_t first = content.find_first_not_of(" \t\r\n"); // Primeiro caractere significativo.
+    if (first != std::string_view::npos && content[first] == '{')
+    {
+        return ConfigFormat::JSON;
+    }
+    return ConfigFormat::INI;
+}
+
+/**
+******************************************************************************
+* @brief   : Função para criar o parser de configuração. Ela abre o arquivo uma única vez e escolhe o parser pelo conteúdo.
+* @details : O arquivo é mapeado em memória uma única vez e o formato é detectado por detectConfigFormat, independentemente da extensão. O mesmo bloco mapeado é entregue ao parser escolhido (JsonParser ou IniParser), que não abre o arquivo novamente. Para um INI, se existir um snapshot binário atualizado ao lado do arquivo, ele é usado no lugar do texto; caso contrário, o modo de carga escolhe entre o IniParser e o LazyIniParser. A função retorna um std::expected contendo o parser ou um código de erro, permitindo que o chamador lide com falhas de forma elegante.
+******************************************************************************.
+* @param: filePath - O caminho para o arquivo de configuração.
+* @param: mode - O modo de carga de um arquivo INI (ignorado para JSON).
+* @return: std::expected<std::unique_ptr<IConfigParser>, ErrorCode> - Retorna um std::expected contendo um ponteiro único para o parser, FILE_OPEN_FAILED se o arquivo não puder ser aberto, ou INVALID_FORMAT se o conteúdo não for texto.
+******************************************************************************
+*/
+std::expected<std::unique_ptr<IConfigParser>, ErrorCode> createParser(const std::string& filePath, IniLoadMode mode)
+{
+    MappedFile file(filePath); // Única abertura do arquivo.
+    if (!file.isOpen()) // Verifica se o arquivo foi aberto com sucesso
+    {
+        return std::unexpected(ErrorCode::FILE_OPEN_FAILED); // Retorna um erro se o arquivo não puder ser aberto (não existe ou falta permissão)
+    }
+
+    switch (detectConfigFormat(file.view()))
+    {
+    case ConfigFormat::JSON:
+        return std::make_unique<JsonParser>(std::move(file), filePath);
+    case ConfigFormat::INI:
+        if (auto snapshot = loadBinarySnapshot(snapshotPathFor(filePath), filePath, file.view())) // Se existir um snapshot binário atualizado ao lado do arquivo, ele é carregado com um único mmap, sem interpretar o texto; o INI já mapeado é usado na verificação, sem ser aberto de novo. Um snapshot ausente, corrompido ou desatualizado é ignorado e o INI é usado.
+        {
+            return std::move(*snapshot);
+        }
+        if (mode == IniLoadMode::LAZY)
+        {
+            return std::make_unique<LazyIniParser>(std::move(file), filePath);
+        }
+        return std::make_unique<IniParser>(std::move(file), filePath);
+    case ConfigFormat::UNKNOWN:
+        break;
+    }
+    return std::unexpected(ErrorCode::INVALID_FORMAT); // Conteúdo binário, que nenhum parser aceita.
+}
+
+/**
+******************************************************************************
+* @brief   : Função para criar o parser de uma configuração em camadas: um arquivo INI base e um diretório de fragmentos no estilo conf.d.
+* @details : O arquivo base é obrigatório; o diretório é opcional. Os arquivos são abertos somente pelo LayeredParser, e o erro da sua carga é retornado. Os fragmentos *.ini do diretório são aplicados em ordem alfabética do nome, e a última camada prevalece para cada par (seção, chave). O snapshot binário não é usado, pois ele descreve um único arquivo.
+******************************************************************************.
+* @param: basePath - O caminho do arquivo INI base.
+* @param: directoryPath - O caminho do diretório de fragmentos.
+* @param: threadCount - A quantidade de threads usadas para ler e tokenizar os arquivos.
+* @return: std::expected<std::unique_ptr<IConfigParser>, ErrorCode> - Retorna um std::expected contendo um ponteiro único para o parser, ou FILE_OPEN_FAILED se o arquivo base ou algum fragmento não puder ser lido.
+******************************************************************************
+*/
+std::expected<std::unique_ptr<IConfigParser>, ErrorCode> createLayeredParser(const std::string& basePath, const std::string& directoryPath, unsigned threadCount)
+{
+    auto parser = std::make_unique<LayeredParser>(basePath, directoryPath, threadCount); // Cada camada é aberta uma única vez, pelo próprio parser.
+    if (std::optional<ErrorCode> error = parser->loadError()) // Um arquivo base ausente (ou qualquer camada ilegível) é informado ao chamador, em vez de um parser que só retorna erros.
+    {
+        return std::unexpected(*error);
+    }
+    return parser;
+}
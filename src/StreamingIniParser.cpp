@@ -0,0 +1,280 @@
+/*
+ * StreamingIniParser.cpp
+ *
+ * Implementação da classe StreamingIniParser, um parser INI incremental com memória limitada, que consome o arquivo em blocos de bytes.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "StreamingIniParser.hpp"
+#include <algorithm>
+#include <cstring>
+#include "IniTokenizer.hpp"
+/*----------------------------------------------------------------------------*/
+
+static constexpr std::size_t MIN_LINE_LENGTH = 16; // Menor buffer de linha aceito, suficiente para qualquer chave dos esquemas.
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe StreamingIniParser.
+* @details : Toda a memória usada pelo parser é alocada aqui, em um único bloco: o buffer da linha corrente e um espaço de maxLineLength bytes para cada chave dos esquemas, na sua seção e na seção global. Nenhuma alocação é feita durante feed e finish, independentemente do tamanho do arquivo.
+******************************************************************************.
+* @param: maxLineLength - O comprimento máximo de uma linha relevante (cabeçalho de seção ou chave dos esquemas), em bytes. Valores menores que 16 são arredondados para 16.
+******************************************************************************
+*/
+StreamingIniParser::StreamingIniParser(std::size_t maxLineLength)
+    : m_lineCapacity(std::max(maxLineLength, MIN_LINE_LENGTH)),
+      m_storage(std::make_unique_for_overwrite<char[]>((1 + SLOT_COUNT) * m_lineCapacity))
+{
+    std::size_t next = 0; // Próximo espaço a ser preenchido.
+    auto addSlots = [this, &next](Scope schema, const auto&... descriptors) // Cria os dois espaços (seção e global) de cada chave de um esquema.
+    {
+        ((m_slots[next++] = Slot{descriptors.key, schema, false}, m_slots[next++] = Slot{descriptors.key, schema, true}), ...);
+    };
+    std::apply([&](const auto&... descriptors) { addSlots(Scope::TCP, descriptors...); }, ConfigSchema<TcpConfig>::fields);
+    std::apply([&](const auto&... descriptors) { addSlots(Scope::UART, descriptors...); }, ConfigSchema<UartConfig>::fields);
+
+    for (std::size_t i = 0; i < SLOT_COUNT; ++i) // O buffer de linha ocupa o início do bloco; os espaços vêm em seguida.
+    {
+        m_slots[i].data = m_storage.get() + (i + 1) * m_lineCapacity;
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Consome um bloco de bytes.
+* @details : Os bytes são acumulados no buffer da linha corrente até o próximo '\n', quando a linha é interpretada. Uma linha pode ser dividida entre quantos blocos forem necessários. Linhas maiores que o buffer são descartadas se forem irrelevantes (comentários e chaves fora dos esquemas); um cabeçalho de seção ou uma chave dos esquemas que não caiba no buffer é um erro, pois descartá-lo mudaria o resultado.
+******************************************************************************.
+* @param: chunk - O bloco de bytes, de qualquer tamanho.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou INVALID_FORMAT se uma linha relevante não couber no buffer (também para todos os blocos seguintes).
+******************************************************************************
+*/
+std::expected<void, ErrorCode> StreamingIniParser::feed(std::span<const std::byte> chunk)
+{
+    if (m_error) // Depois de um erro, o fluxo não é mais interpretado.
+    {
+        return std::unexpected(*m_error);
+    }
+
+    const char* data = reinterpret_cast<const char*>(chunk.data()); // Bytes ainda não consumidos do bloco.
+    std::size_t remaining = chunk.size(); // Quantidade de bytes ainda não consumidos.
+    while (remaining > 0)
+    {
+        const char* newline = static_cast<const char*>(std::memchr(data, '\n', remaining)); // Final da linha corrente, se estiver neste bloco.
+        std::size_t length = newline ? static_cast<std::size_t>(newline - data) : remaining; // Bytes da linha corrente neste bloco.
+
+        std::size_t space = m_lineCapacity - m_lineLength; // Espaço livre no buffer de linha.
+        std::size_t copied = std::min(length, space); // Bytes que cabem no buffer; o excedente é descartado.
+        std::memcpy(m_storage.get() + m_lineLength, data, copied);
+        m_lineLength += copied;
+        m_lineTruncated = m_lineTruncated || copied < length;
+
+        if (!newline) // A linha continua no próximo bloco.
+        {
+            break;
+        }
+        processLine(); // A linha está completa.
+        if (m_error)
+        {
+            return std::unexpected(*m_error);
+        }
+        data = newline + 1;
+        remaining -= length + 1;
+    }
+    return {};
+}
+
+/**
+******************************************************************************
+* @brief   : Interpreta a última linha do fluxo, caso ela não termine com '\n'.
+******************************************************************************.
+* @return: std::expected<void, ErrorCode> - Retorna vazio em caso de sucesso, ou o erro do fluxo.
+******************************************************************************
+*/
+std::expected<void, ErrorCode> StreamingIniParser::finish()
+{
+    if (!m_error && (m_lineLength > 0 || m_lineTruncated)) // Interpreta a linha pendente.
+    {
+        processLine();
+    }
+    if (m_error)
+    {
+        return std::unexpected(*m_error);
+    }
+    return {};
+}
+
+/**
+******************************************************************************
+* @brief   : Interpreta a linha guardada no buffer e esvazia o buffer.
+* @details : A linha é classificada pela função parseIniLine, com as mesmas regras do IniTokenizer. Cabeçalhos alteram a seção corrente; pares chave/valor só são guardados se a chave pertencer ao esquema da seção corrente (ou a algum esquema, na seção global). A última declaração de uma chave prevalece.
+******************************************************************************
+*/
+void StreamingIniParser::processLine()
+{
+    std::string_view line(m_storage.get(), m_lineLength); // Linha corrente (ou o seu início, se ela foi truncada).
+    bool truncated = m_lineTruncated;
+    m_lineLength = 0; // Esvazia o buffer para a próxima linha.
+    m_lineTruncated = false;
+
+    std::string_view first; // Nome da seção ou chave.
+    std::string_view second; // Valor.
+    IniLineType type = parseIniLine(line, first, second);
+
+    if (truncated) // Somente o início da linha está disponível.
+    {
+        std::string_view start = trimIni(line);
+        if (!start.empty() && start.front() == '[') // Não é possível saber se o cabeçalho é bem formado nem qual seção ele abre.
+        {
+            m_error = ErrorCode::INVALID_FORMAT;
+            return;
+        }
+        if (type != IniLineType::KEY_VALUE) // Comentários e linhas cujo '=' foi descartado (chaves longas demais para os esquemas) são irrelevantes.
+        {
+            return;
+        }
+    }
+
+    if (type == IniLineType::SECTION) // Atualiza a seção corrente.
+    {
+        if (first.empty())
+        {
+            m_scope = Scope::GLOBAL;
+        }
+        else if (first == ConfigSchema<TcpConfig>::section)
+        {
+            m_scope = Scope::TCP;
+        }
+        else if (first == ConfigSchema<UartConfig>::section)
+        {
+            m_scope = Scope::UART;
+        }
+        else
+        {
+            m_scope = Scope::OTHER;
+        }
+        return;
+    }
+    if (type != IniLineType::KEY_VALUE || m_scope == Scope::OTHER) // Descarta linhas ignoradas e pares de seções fora dos esquemas.
+    {
+        return;
+    }
+
+    for (Slot& slot : m_slots) // Guarda o valor nos espaços da chave (na seção global, uma chave pode servir a mais de um esquema).
+    {
+        bool matches = slot.key == first && (m_scope == Scope::GLOBAL ? slot.global : (!slot.global && slot.schema == m_scope));
+        if (!matches)
+        {
+            continue;
+        }
+        if (truncated) // O valor de uma chave dos esquemas não coube no buffer.
+        {
+            m_error = ErrorCode::INVALID_FORMAT;
+            return;
+        }
+        std::memcpy(slot.data, second.data(), second.size()); // O valor é menor que a linha, portanto cabe no espaço.
+        slot.length = second.size();
+        slot.present = true;
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Procura o valor de uma chave do esquema.
+******************************************************************************.
+* @param: schema - O esquema (TCP ou UART).
+* @param: key - O nome da chave.
+* @return: std::optional<std::string_view> - O valor declarado na seção do esquema ou, na falta dele, na seção global; std::nullopt se a chave não foi recebida.
+******************************************************************************
+*/
+std::optional<std::string_view> StreamingIniParser::findValue(Scope schema, std::string_view key) const
+{
+    const Slot* fallback = nullptr; // Valor da seção global, usado se a seção do esquema não declarar a chave.
+    for (const Slot& slot : m_slots)
+    {
+        if (slot.schema != schema || slot.key != key || !slot.present)
+        {
+            continue;
+        }
+        if (!slot.global) // O valor da própria seção prevalece.
+        {
+            return std::string_view(slot.data, slot.length);
+        }
+        fallback = &slot;
+    }
+    if (fallback)
+    {
+        return std::string_view(fallback->data, fallback->length);
+    }
+    return std::nullopt;
+}
+
+/**
+******************************************************************************
+* @brief   : Preenche e valida a configuração TCP com os valores recebidos até o momento.
+******************************************************************************.
+* @return: std::expected<TcpConfig, ErrorCode> - A configuração TCP, o erro do fluxo, ou PARSE_ERROR se algum campo estiver faltando ou for inválido.
+******************************************************************************
+*/
+std::expected<TcpConfig, ErrorCode> StreamingIniParser::parseTcp()
+{
+    if (m_error) // Um fluxo com erro nunca produz configurações.
+    {
+        return std::unexpected(*m_error);
+    }
+    return bindConfig<TcpConfig>([this](std::string_view key) { return findValue(Scope::TCP, key); });
+}
+
+/**
+******************************************************************************
+* @brief   : Preenche e valida a configuração UART com os valores recebidos até o momento.
+******************************************************************************.
+* @return: std::expected<UartConfig, ErrorCode> - A configuração UART, o erro do fluxo, ou PARSE_ERROR se algum campo estiver faltando ou for inválido.
+******************************************************************************
+*/
+std::expected<UartConfig, ErrorCode> StreamingIniParser::parseUart()
+{
+    if (m_error) // Um fluxo com erro nunca produz configurações.
+    {
+        return std::unexpected(*m_error);
+    }
+    return bindConfig<UartConfig>([this](std::string_view key) { return findValue(Scope::UART, key); });
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna o valor recebido de uma chave, para os acessores genéricos.
+******************************************************************************.
+* @param: section - O nome da seção ([TCP], [UART] ou a seção global, de nome vazio).
+* @param: key - O nome da chave.
+* @return: std::optional<std::string_view> - O valor guardado, ou std::nullopt se a chave não pertencer aos esquemas, não tiver sido recebida, ou se o fluxo tiver um erro.
+******************************************************************************
+*/
+std::optional<std::string_view> StreamingIniParser::findValue(std::string_view section, std::string_view key) const
+{
+    if (m_error) // Um fluxo com erro não é consultado.
+    {
+        return std::nullopt;
+    }
+    if (section == ConfigSchema<TcpConfig>::section)
+    {
+        return findValue(Scope::TCP, key);
+    }
+    if (section == ConfigSchema<UartConfig>::section)
+    {
+        return findValue(Scope::UART, key);
+    }
+    if (section.empty()) // Na seção global, a chave pode ter sido guardada por qualquer esquema.
+    {
+        for (const Slot& slot : m_slots)
+        {
+            if (slot.global && slot.present && slot.key == key)
+            {
+                return std::string_view(slot.data, slot.length);
+            }
+        }
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,128 @@
+/*
+ * ThreadPool.cpp
+ *
+ * Implementação da classe ThreadPool, um conjunto fixo de threads de trabalho usado para interpretar e validar em paralelo as seções numeradas de um arquivo de configuração.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include "ThreadPool.hpp"
+/*----------------------------------------------------------------------------*/
+
+/**
+******************************************************************************
+* @brief   : Construtor da classe ThreadPool, que cria as threads de trabalho.
+* @details : A thread que chama parallelFor também executa iterações, por isso são criadas apenas threadCount - 1 threads de trabalho.
+******************************************************************************.
+* @param: threadCount - A quantidade total de threads que executam cada laço. Zero é tratado como um.
+******************************************************************************
+*/
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    unsigned workerCount = threadCount > 1 ? threadCount - 1 : 0; // A thread chamadora conta como uma das threads do pool.
+    m_workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) // Cria as threads de trabalho, que ficam bloqueadas até o primeiro laço.
+    {
+        m_workers.emplace_back([this] { work(); });
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Destrutor da classe ThreadPool, que encerra as threads de trabalho.
+* @details : As threads são acordadas com m_stopping ligado e aguardadas pelo destrutor de cada std::jthread.
+******************************************************************************
+*/
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true; // Sinaliza às threads de trabalho que o pool está sendo destruído.
+    }
+    m_wake.notify_all(); // Acorda todas as threads para que elas terminem.
+    m_workers.clear(); // Aguarda o término de cada thread antes de destruir os demais membros.
+}
+
+/**
+******************************************************************************
+* @brief   : Executa body(i) para cada i em [0, count), distribuindo os índices entre as threads do pool.
+* @details : Os índices são reservados dinamicamente com um contador atômico, o que equilibra a carga quando as iterações têm custos diferentes. O método só retorna depois que todas as iterações terminaram, e as escritas feitas pelo corpo ficam visíveis para a thread chamadora. Se o pool não tiver threads de trabalho ou houver uma única iteração, o laço é executado diretamente na thread chamadora.
+******************************************************************************.
+* @param: count - A quantidade de iterações.
+* @param: body - O corpo do laço, chamado com o índice de cada iteração.
+******************************************************************************
+*/
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body)
+{
+    if (m_workers.empty() || count < 2) // Sem threads de trabalho (ou com uma única iteração), executa o laço sequencialmente.
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            body(i);
+        }
+        return;
+    }
+
+    std::lock_guard callLock(m_callMutex); // Apenas um laço por vez usa as threads de trabalho.
+    {
+        std::lock_guard lock(m_mutex);
+        m_body = &body; // Publica o novo laço para as threads de trabalho.
+        m_count = count;
+        m_next.store(0);
+        m_busyWorkers = m_workers.size();
+        ++m_generation;
+    }
+    m_wake.notify_all(); // Acorda as threads de trabalho.
+
+    runIterations(); // A thread chamadora também executa iterações.
+
+    std::unique_lock lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busyWorkers == 0; }); // Aguarda que todas as threads de trabalho terminem as suas iterações.
+    m_body = nullptr;
+}
+
+/**
+******************************************************************************
+* @brief   : Executa iterações do laço corrente até que não reste nenhum índice.
+******************************************************************************
+*/
+void ThreadPool::runIterations()
+{
+    for (std::size_t i = m_next.fetch_add(1); i < m_count; i = m_next.fetch_add(1)) // Reserva um índice por vez até esgotar o intervalo.
+    {
+        (*m_body)(i);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Laço das threads de trabalho.
+* @details : Cada thread espera por um laço de geração ainda não vista, executa iterações até esgotar o intervalo e avisa a thread chamadora quando é a última a sair.
+******************************************************************************
+*/
+void ThreadPool::work()
+{
+    std::size_t seenGeneration = 0; // Último laço de que esta thread participou.
+    for (;;)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_wake.wait(lock, [this, seenGeneration] { return m_stopping || m_generation != seenGeneration; }); // Bloqueia até haver um novo laço ou o pool ser destruído.
+            if (m_stopping)
+            {
+                return;
+            }
+            seenGeneration = m_generation;
+        }
+
+        runIterations(); // Executa iterações do laço corrente.
+
+        std::lock_guard lock(m_mutex);
+        if (--m_busyWorkers == 0) // A última thread a sair acorda a thread chamadora.
+        {
+            m_done.notify_one();
+        }
+    }
+}
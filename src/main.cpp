@@ -12,42 +12,10 @@
 /* Includes ------------------------------------------------------------------*/
 #include <iostream>
 #include <memory>
-#include <filesystem>
 #include "ConfigurationManager.hpp"
-#include "IniParser.hpp"
+#include "ParserFactory.hpp"
 /*----------------------------------------------------------------------------*/
 
-/**
-******************************************************************************
-* @brief   : Função para criar o parser de configuração. Ela verifica se o arquivo existe e se tem a extensão correta antes de criar o parser.
-* @details : Esta função é responsável por validar o caminho do arquivo de configuração e criar uma instância do parser apropriado (neste caso, um IniParser). Ela retorna um std::expected contendo o parser ou um código de erro, permitindo que o chamador lide com falhas de forma elegante.
-******************************************************************************.
-* @param: filePath - O caminho para o arquivo de configuração.
-* @return: std::expected<std::unique_ptr<IConfigParser>, ErrorCode> - Retorna um std::expected contendo um ponteiro único para o parser ou um código de erro.
-******************************************************************************
-*/
-
-std::expected<std::unique_ptr<IConfigParser>, ErrorCode> createParser(const std::string& filePath) {
-
-    std::ifstream file(filePath); // Tenta abrir o arquivo para verificar se ele existe
-
-    if (!file.is_open()) // Verifica se o arquivo foi aberto com sucesso
-    {
-        return std::unexpected(ErrorCode::FILE_OPEN_FAILED); // Retorna um erro se o arquivo não puder ser aberto (não existe ou falta permissão)
-    }
-    else if (filePath.substr(filePath.find_last_of(".") + 1) != "ini") // Verifica se a extensão do arquivo é .ini. Se não for, retorna um erro de formato inválido. Pode ser facilmente estendido para suportar outros formatos, como JSON, XML, etc., adicionando mais condições e parsers correspondentes.
-    {
-        return std::unexpected(ErrorCode::INVALID_FORMAT); // Retorna um erro se o formato do arquivo for inválido (extensão diferente de .ini)
-    }
-    file.close(); // Fecha o arquivo após a verificação
-
-    return std::make_unique<IniParser>(filePath); // Retorna um parser válido para arquivos INI. Se quisermos adicionar suporte para outros formatos, podemos criar mais condições aqui e retornar o parser correspondente. Por exemplo, para JSON, poderíamos verificar a extensão .json e retornar um JsonParser.
-    
-    // Exemplo de como adicionar suporte para outros formatos:
-    // return std::make_unique<JsonParser>(filePath);
-    // return std::make_unique<XmlParser>(filePath);
-}
-
 int main() { // 1. Inicialização do sistema de configuração
     
     // 2. Criamos o parser usando a função createParser, que lida com a validação do arquivo e retorna um std::expected contendo o parser ou um código de erro. Isso permite que o código de inicialização seja limpo e fácil de entender, enquanto a complexidade da validação do arquivo fica oculta dentro da função createParser.
@@ -0,0 +1,117 @@
+/*
+ * arena_allocation_test.cpp
+ *
+ * Teste da carga sobre uma arena estática: o IniParser e o ConfigurationManager recebem um std::pmr::monotonic_buffer_resource sobre um array estático, sem recurso de reserva, e o operador new global é substituído pela versão de bench/AllocationCounter.hpp, que conta as alocações, a mesma do benchmark. A carga e as consultas devem ser feitas sem nenhuma alocação global, e uma arena pequena demais para o arquivo deve resultar em OUT_OF_MEMORY.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include "AllocationCounter.hpp"
+#include "ConfigurationManager.hpp"
+#include "IniParser.hpp"
+/*----------------------------------------------------------------------------*/
+
+static int g_failures = 0; // Falhas encontradas.
+
+/**
+******************************************************************************
+* @brief   : Verifica uma condição do teste e registra a falha, se houver.
+******************************************************************************.
+* @param: condition - A condição esperada.
+* @param: message - A descrição da verificação.
+* @param: value - Um valor que ajuda a diagnosticar a falha (quantidade de alocações, código de erro, ...).
+******************************************************************************
+*/
+static void check(bool condition, const char* message, long long value)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "FALHA: %s (%lld)\n", message, value);
+        ++g_failures;
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Grava o arquivo do teste: [TCP], [UART], instâncias numeradas e muitos comentários, com cerca de 64 KB.
+******************************************************************************.
+* @param: path - O caminho do arquivo.
+******************************************************************************
+*/
+static void writeConfig(const std::filesystem::path& path)
+{
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << "; Arquivo gerado pelo arena_allocation_test\n[TCP]\nip=192.168.0.10\nport=502\nprotocol=TCP\n\n[UART]\nbaudrate=9600\ndata_bits=8\nparity=none\nstop_bits=1\n";
+    for (int i = 0; i < 200; ++i)
+    {
+        output << "\n; Instância " << i << ": comentário longo, que não deve ocupar espaço no índice da arena\n";
+        output << "[TCP" << i << "]\nip=10.0.0." << (i % 250) << "\nport=" << (1000 + i) << "\nprotocol=UDP\n";
+        output << "[UART" << i << "]\nbaudrate=115200\ndata_bits=8\nparity=even\nstop_bits=1\n";
+    }
+}
+
+int main()
+{
+    static std::byte arena[1 << 20]; // Arena estática de 1 MB, como em um firmware sem heap após a inicialização.
+    static std::byte smallArena[4 << 10]; // Arena de 4 KB, pequena demais para o arquivo.
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / ("arena_allocation_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".ini");
+    writeConfig(path);
+    std::string filePath = path.string(); // Alocado antes das medidas.
+
+    { // Carga e consultas do IniParser.
+        std::pmr::monotonic_buffer_resource resource(arena, sizeof(arena), std::pmr::null_memory_resource());
+        std::uint64_t before = g_allocationCount.load();
+        IniParser parser(filePath, &resource); // O parser fica na pilha; o índice, na arena.
+        bool valid = parser.parseTcp().has_value() && parser.parseUart().has_value() && parser.parseTcpSection("TCP199").has_value()
+                  && parser.parseUartSection("UART0").has_value() && parser.findValue("TCP7", "port") == "1007" && parser.sectionNames().size() == 402;
+        std::uint64_t allocations = g_allocationCount.load() - before;
+        check(valid, "configuracoes do IniParser sobre a arena", 0);
+        check(allocations == 0, "alocacoes globais na carga e nas consultas do IniParser", static_cast<long long>(allocations));
+    }
+
+    { // Carga e consultas do ConfigurationManager, com o parser na mesma arena.
+        std::pmr::monotonic_buffer_resource resource(arena, sizeof(arena), std::pmr::null_memory_resource());
+        auto parser = std::make_unique<IniParser>(filePath, &resource); // Única alocação global, fora da medida: o objeto cuja posse é transferida ao gerenciador por std::unique_ptr.
+        std::uint64_t before = g_allocationCount.load();
+        {
+            ConfigurationManager manager(std::move(parser), 1, &resource);
+            bool valid = manager.get_tcp_config().has_value() && manager.get_uart_config().has_value() && manager.get_all_tcp_configs()->size() == 200
+                      && manager.get_all_uart_configs()->back().config.has_value() && manager.get<int>("TCP", "port") == 502 && manager.get<int>("UART199", "baudrate") == 115200;
+            check(valid, "configuracoes do ConfigurationManager sobre a arena", 0);
+        }
+        std::uint64_t allocations = g_allocationCount.load() - before;
+        check(allocations == 0, "alocacoes globais na carga, nas consultas e na destruicao do ConfigurationManager", static_cast<long long>(allocations));
+    }
+
+    { // Arena pequena demais: o parser e o gerenciador retornam OUT_OF_MEMORY, sem recorrer ao heap.
+        std::pmr::monotonic_buffer_resource resource(smallArena, sizeof(smallArena), std::pmr::null_memory_resource());
+        std::uint64_t before = g_allocationCount.load();
+        IniParser parser(filePath, &resource);
+        std::expected<TcpConfig, ErrorCode> tcp = parser.parseTcp();
+        std::uint64_t allocations = g_allocationCount.load() - before;
+        check(!tcp && tcp.error() == ErrorCode::OUT_OF_MEMORY, "parseTcp sobre a arena pequena", tcp ? -1 : static_cast<long long>(tcp.error()));
+        check(allocations == 0, "alocacoes globais com a arena pequena", static_cast<long long>(allocations));
+    }
+    {
+        std::pmr::monotonic_buffer_resource parserResource(arena, sizeof(arena), std::pmr::null_memory_resource());
+        std::pmr::monotonic_buffer_resource managerResource(smallArena, 64, std::pmr::null_memory_resource()); // Espaço insuficiente até para o snapshot.
+        ConfigurationManager manager(std::make_unique<IniParser>(filePath, &parserResource), 1, &managerResource);
+        std::expected<TcpConfig, ErrorCode> tcp = manager.get_tcp_config();
+        check(!tcp && tcp.error() == ErrorCode::OUT_OF_MEMORY, "get_tcp_config com o gerenciador sobre a arena pequena", tcp ? -1 : static_cast<long long>(tcp.error()));
+    }
+
+    std::filesystem::remove(path);
+    std::printf("%d falhas\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
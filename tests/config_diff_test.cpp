@@ -0,0 +1,259 @@
+/*
+ * config_diff_test.cpp
+ *
+ * Teste da comparação de snapshots e das assinaturas de mudanças: um arquivo INI com instâncias numeradas é recarregado depois de alterado, e são verificadas as mudanças informadas por diffSnapshots (seções modificadas com a máscara dos campos que mudaram, instâncias acrescentadas e removidas, a ordem numérica das instâncias e as seções iguais que não são comparadas campo a campo) e quais callbacks são chamados no reload.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ConfigDiff.hpp"
+#include "ConfigurationManager.hpp"
+#include "ParserFactory.hpp"
+/*----------------------------------------------------------------------------*/
+
+static int g_failures = 0; // Falhas encontradas.
+
+// Arquivo original: [TCP], [UART], as instâncias TCP0 a TCP4 e UART0 a UART2.
+static constexpr std::string_view BEFORE_TEXT =
+    "[TCP]\nip=10.0.0.1\nport=502\nprotocol=TCP\n\n"
+    "[UART]\nbaudrate=9600\ndata_bits=8\nparity=none\nstop_bits=1\n\n"
+    "[TCP0]\nip=10.1.0.0\nport=1000\nprotocol=TCP\n"
+    "[TCP1]\nip=10.1.0.1\nport=1001\nprotocol=TCP\n"
+    "[TCP2]\nip=10.1.0.2\nport=1002\nprotocol=TCP\n"
+    "[TCP3]\nip=10.1.0.3\nport=1003\nprotocol=TCP\n"
+    "[TCP4]\nip=10.1.0.4\nport=1004\nprotocol=TCP\n"
+    "[UART0]\nbaudrate=115200\ndata_bits=8\nparity=none\nstop_bits=1\n"
+    "[UART1]\nbaudrate=115200\ndata_bits=8\nparity=none\nstop_bits=1\n"
+    "[UART2]\nbaudrate=115200\ndata_bits=8\nparity=none\nstop_bits=1\n";
+
+// Arquivo alterado: porta e protocolo de [TCP], TCP1 removida, porta de TCP2, IP de TCP3, TCP5 acrescentada, paridade de UART1 e UART10 acrescentada. [UART], TCP0, TCP4, UART0 e UART2 têm o mesmo conteúdo, com outra formatação e em outra ordem.
+static constexpr std::string_view AFTER_TEXT =
+    "; arquivo alterado\n"
+    "[UART10]\nbaudrate=57600\ndata_bits=7\nparity=even\nstop_bits=2\n"
+    "[TCP]\nip=10.0.0.1\nport=503\nprotocol=UDP\n\n"
+    "[UART]\n  baudrate = 9600\nstop_bits=1\ndata_bits=8\nparity=none\n\n"
+    "[TCP4]\nip=10.1.0.4\nport=1004\nprotocol=TCP\n"
+    "[TCP0]\nprotocol=TCP\nport=1000\nip=10.1.0.0\n"
+    "[TCP2]\nip=10.1.0.2\nport=2002\nprotocol=TCP\n"
+    "[TCP3]\nip=10.9.9.9\nport=1003\nprotocol=TCP\n"
+    "[TCP5]\nip=10.1.0.5\nport=1005\nprotocol=UDP\n"
+    "[UART0]\nbaudrate=115200\ndata_bits=8\nparity=none\nstop_bits=1\n"
+    "[UART1]\nbaudrate=115200\ndata_bits=8\nparity=odd\nstop_bits=1\n"
+    "[UART2]\n; mesma configuracao\nbaudrate=115200\ndata_bits=8\nparity=none\nstop_bits=1\n";
+
+/**
+******************************************************************************
+* @brief   : Verifica uma condição do teste e registra a falha, se houver.
+******************************************************************************.
+* @param: condition - A condição esperada.
+* @param: message - A descrição da verificação.
+* @param: value - Um valor que ajuda a diagnosticar a falha (quantidade de mudanças, máscara, ...).
+******************************************************************************
+*/
+static void check(bool condition, const char* message, long long value)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "FALHA: %s (%lld)\n", message, value);
+        ++g_failures;
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Grava um arquivo por completo.
+******************************************************************************.
+* @param: path - O caminho do arquivo.
+* @param: text - O conteúdo.
+******************************************************************************
+*/
+static void writeFile(const std::filesystem::path& path, std::string_view text)
+{
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << text;
+}
+
+/**
+******************************************************************************
+* @brief   : Cria o parser de um arquivo.
+******************************************************************************.
+* @param: path - O caminho do arquivo.
+* @return: std::unique_ptr<IConfigParser> - O parser, ou nullptr se o arquivo não puder ser lido.
+******************************************************************************
+*/
+static std::unique_ptr<IConfigParser> parserFor(const std::filesystem::path& path)
+{
+    std::expected<std::unique_ptr<IConfigParser>, ErrorCode> parser = createParser(path.string());
+    return parser ? std::move(*parser) : nullptr;
+}
+
+/**
+******************************************************************************
+* @brief   : Descreve uma lista de mudanças como texto ("TCP:M:6 TCP1:R ..."), para comparar a ordem, os tipos e as máscaras de uma só vez.
+******************************************************************************.
+* @param: changes - As mudanças de um tipo de configuração.
+* @return: std::string - Nome, tipo (A, R ou M) e, para M, a máscara dos campos de cada mudança.
+******************************************************************************
+*/
+template <typename T>
+static std::string describe(const std::vector<ConfigChange<T>>& changes)
+{
+    std::string text;
+    for (const ConfigChange<T>& change : changes)
+    {
+        if (!text.empty())
+        {
+            text += ' ';
+        }
+        text += change.section;
+        switch (change.kind)
+        {
+        case ChangeKind::ADDED: text += ":A"; break;
+        case ChangeKind::REMOVED: text += ":R"; break;
+        case ChangeKind::MODIFIED: text += ":M:" + std::to_string(change.fields); break;
+        }
+    }
+    return text;
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica as mudanças informadas por diffSnapshots entre o arquivo original e o alterado.
+******************************************************************************.
+* @param: path - O caminho do arquivo de configuração.
+******************************************************************************
+*/
+static void testDiff(const std::filesystem::path& path)
+{
+    writeFile(path, BEFORE_TEXT);
+    ConfigurationManager manager(parserFor(path));
+    std::shared_ptr<const ConfigSnapshot> before = manager.get_snapshot();
+    writeFile(path, AFTER_TEXT);
+    check(manager.reload(parserFor(path)).has_value(), "reload do arquivo alterado", 0);
+    ConfigDiff diff = diffSnapshots(before, manager.get_snapshot());
+
+    std::string tcp = describe(diff.tcp);
+    std::string uart = describe(diff.uart);
+    check(tcp == "TCP:M:6 TCP1:R TCP2:M:2 TCP3:M:1 TCP5:A", "mudancas TCP, em ordem numerica", static_cast<long long>(diff.tcp.size()));
+    check(uart == "UART1:M:4 UART10:A", "mudancas UART, com UART10 depois de UART2", static_cast<long long>(diff.uart.size()));
+    if (tcp != "TCP:M:6 TCP1:R TCP2:M:2 TCP3:M:1 TCP5:A" || uart != "UART1:M:4 UART10:A")
+    {
+        std::fprintf(stderr, "%s | %s\n", tcp.c_str(), uart.c_str());
+    }
+    check(diff.unchanged == 5, "secoes iguais ([UART], TCP0, TCP4, UART0 e UART2), sem comparar campos", static_cast<long long>(diff.unchanged));
+
+    if (const ConfigChange<TcpConfig>* change = diff.findTcp("TCP"))
+    {
+        check(change->changedKeys() == std::vector<std::string_view>{"port", "protocol"}, "chaves alteradas em [TCP]", static_cast<long long>(change->fields));
+        check(change->before && change->after && (*change->before)->port == 502 && (*change->after)->port == 503, "valores anterior e novo de [TCP]", 0);
+    }
+    if (const ConfigChange<TcpConfig>* change = diff.findTcp("TCP1"))
+    {
+        check(change->before != nullptr && change->after == nullptr, "instancia removida sem valor novo", 0);
+    }
+    if (const ConfigChange<UartConfig>* change = diff.findUart("UART10"))
+    {
+        check(change->before == nullptr && change->after != nullptr && (*change->after)->baudrate == 57600, "instancia acrescentada sem valor anterior", 0);
+    }
+    check(diff.findTcp("TCP4") == nullptr && diff.findUart("UART") == nullptr, "secoes iguais fora do resultado", 0);
+
+    std::string invalidText(AFTER_TEXT); // TCP2 com uma porta inválida: o reload é recusado, e o snapshot do construtor guarda o erro.
+    invalidText.replace(invalidText.find("port=2002"), 9, "port=abc");
+    writeFile(path, invalidText);
+    check(!manager.reload(parserFor(path)).has_value(), "reload com instancia invalida recusado", 0);
+    ConfigurationManager invalid(parserFor(path));
+    ConfigDiff toInvalid = diffSnapshots(manager.get_snapshot(), invalid.get_snapshot());
+    check(describe(toInvalid.tcp) == "TCP2:M:0" && toInvalid.uart.empty(), "passagem de valida a invalida sem mascara de campos", static_cast<long long>(toInvalid.tcp.size()));
+    if (const ConfigChange<TcpConfig>* change = toInvalid.findTcp("TCP2"))
+    {
+        check(change->before->has_value() && !change->after->has_value() && change->after->error() == ErrorCode::PARSE_ERROR, "valores anterior e novo de TCP2", 0);
+    }
+
+    ConfigDiff same = diffSnapshots(manager.get_snapshot(), manager.get_snapshot());
+    check(same.empty() && same.unchanged == 0, "snapshot comparado consigo mesmo", static_cast<long long>(same.unchanged));
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica quais callbacks são chamados nos reloads: somente os das seções que mudaram, uma vez por reload, com a mudança correspondente.
+******************************************************************************.
+* @param: path - O caminho do arquivo de configuração.
+******************************************************************************
+*/
+static void testCallbacks(const std::filesystem::path& path)
+{
+    writeFile(path, BEFORE_TEXT);
+    ConfigurationManager manager(parserFor(path));
+    std::map<std::string, std::string> calls; // Seção assinada -> mudanças recebidas, descritas como em describe.
+    auto onTcp = [&calls](const char* name) { return [&calls, name](const ConfigChange<TcpConfig>& change) { calls[name] += describe(std::vector<ConfigChange<TcpConfig>>{change}) + ";"; }; };
+    auto onUart = [&calls](const char* name) { return [&calls, name](const ConfigChange<UartConfig>& change) { calls[name] += describe(std::vector<ConfigChange<UartConfig>>{change}) + ";"; }; };
+
+    bool subscribed = manager.subscribeTcp(onTcp("TCP")).has_value() && manager.subscribeUart(onUart("UART")).has_value();
+    for (const char* section : {"TCP1", "TCP2", "TCP4", "TCP5"})
+    {
+        subscribed = subscribed && manager.subscribeTcpSection(section, onTcp(section)).has_value();
+    }
+    for (const char* section : {"UART0", "UART1", "UART10"})
+    {
+        subscribed = subscribed && manager.subscribeUartSection(section, onUart(section)).has_value();
+    }
+    std::expected<SubscriptionId, ErrorCode> cancelled = manager.subscribeTcpSection("TCP3", onTcp("TCP3"));
+    check(subscribed && cancelled.has_value(), "assinaturas", 0);
+    check(cancelled && manager.unsubscribe(*cancelled), "cancelamento da assinatura de TCP3", 0);
+    check(cancelled && !manager.unsubscribe(*cancelled), "segundo cancelamento recusado", 0);
+
+    writeFile(path, AFTER_TEXT);
+    check(manager.reload(parserFor(path)).has_value(), "reload com assinaturas", 0);
+    std::map<std::string, std::string> expected = {
+        {"TCP", "TCP:M:6;"}, {"TCP1", "TCP1:R;"}, {"TCP2", "TCP2:M:2;"}, {"TCP5", "TCP5:A;"},
+        {"UART1", "UART1:M:4;"}, {"UART10", "UART10:A;"},
+    };
+    check(calls == expected, "callbacks chamados somente para as secoes que mudaram", static_cast<long long>(calls.size()));
+    if (calls != expected)
+    {
+        for (const auto& [section, received] : calls)
+        {
+            std::fprintf(stderr, "  %s: %s\n", section.c_str(), received.c_str());
+        }
+    }
+
+    calls.clear();
+    check(manager.reload(parserFor(path)).has_value(), "reload do mesmo arquivo", 0);
+    check(calls.empty(), "nenhum callback sem mudancas", static_cast<long long>(calls.size()));
+
+    std::string invalidText(AFTER_TEXT);
+    invalidText.replace(invalidText.find("parity=odd"), 10, "parity=");
+    writeFile(path, invalidText);
+    check(!manager.reload(parserFor(path)).has_value(), "reload com instancia invalida recusado", 0);
+    check(calls.empty(), "nenhum callback em um reload recusado", static_cast<long long>(calls.size()));
+
+    writeFile(path, BEFORE_TEXT);
+    check(manager.reload(parserFor(path)).has_value(), "reload do arquivo original", 0);
+    check(calls["TCP1"] == "TCP1:A;" && calls["TCP5"] == "TCP5:R;" && calls["UART10"] == "UART10:R;", "instancias acrescentadas e removidas na volta ao original", 0);
+    check(calls["TCP4"].empty() && calls["UART0"].empty() && calls["UART"].empty(), "secoes iguais sem callback na volta ao original", 0);
+}
+
+int main()
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / ("config_diff_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+
+    testDiff(directory / "diff.ini");
+    testCallbacks(directory / "callbacks.ini");
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    std::printf("%d falhas\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
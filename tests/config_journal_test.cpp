@@ -0,0 +1,244 @@
+/*
+ * config_journal_test.cpp
+ *
+ * Teste do journal de alterações: descarte de um registro incompleto no final do journal na abertura, reaplicação dos registros depois de uma nova abertura, texto gerado pela compactação (valor substituído no lugar, chave e seção que faltam acrescentadas) e as alterações vistas por um reload depois de uma compactação, inclusive com um parser lido antes dela.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include "ConfigJournal.hpp"
+#include "ConfigurationManager.hpp"
+#include "ParserFactory.hpp"
+/*----------------------------------------------------------------------------*/
+
+static int g_failures = 0; // Falhas encontradas.
+
+/**
+******************************************************************************
+* @brief   : Verifica uma condição do teste e registra a falha, se houver.
+******************************************************************************.
+* @param: condition - A condição esperada.
+* @param: message - A descrição da verificação.
+* @param: value - Um valor que ajuda a diagnosticar a falha (porta, quantidade de registros, ...).
+******************************************************************************
+*/
+static void check(bool condition, const char* message, long long value)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "FALHA: %s (%lld)\n", message, value);
+        ++g_failures;
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Grava um arquivo por completo.
+******************************************************************************.
+* @param: path - O caminho do arquivo.
+* @param: text - O conteúdo.
+******************************************************************************
+*/
+static void writeFile(const std::filesystem::path& path, const std::string& text)
+{
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << text;
+}
+
+/**
+******************************************************************************
+* @brief   : Lê um arquivo por completo.
+******************************************************************************.
+* @param: path - O caminho do arquivo.
+* @return: std::string - O conteúdo.
+******************************************************************************
+*/
+static std::string readFile(const std::filesystem::path& path)
+{
+    std::ifstream input(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+/**
+******************************************************************************
+* @brief   : Monta um arquivo INI válido com a porta [TCP] indicada.
+******************************************************************************.
+* @param: port - A porta da seção [TCP].
+* @return: std::string - O conteúdo do arquivo.
+******************************************************************************
+*/
+static std::string configText(int port)
+{
+    return "[TCP]\nip=10.0.0.1\nport=" + std::to_string(port) + "\nprotocol=TCP\n\n[UART]\nbaudrate=9600\ndata_bits=8\nparity=none\nstop_bits=1\n";
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna a porta [TCP] publicada, ou -1 se a configuração for inválida.
+******************************************************************************.
+* @param: manager - O gerenciador.
+* @return: int - A porta.
+******************************************************************************
+*/
+static int tcpPort(const ConfigurationManager& manager)
+{
+    std::expected<TcpConfig, ErrorCode> tcp = manager.get_tcp_config();
+    return tcp ? tcp->port : -1;
+}
+
+/**
+******************************************************************************
+* @brief   : Cria o parser de um arquivo.
+******************************************************************************.
+* @param: path - O caminho do arquivo.
+* @return: std::unique_ptr<IConfigParser> - O parser, ou nullptr se o arquivo não puder ser lido.
+******************************************************************************
+*/
+static std::unique_ptr<IConfigParser> parserFor(const std::filesystem::path& path)
+{
+    std::expected<std::unique_ptr<IConfigParser>, ErrorCode> parser = createParser(path.string());
+    return parser ? std::move(*parser) : nullptr;
+}
+
+/**
+******************************************************************************
+* @brief   : Grava alterações, acrescenta um registro incompleto ao journal e verifica o seu descarte e a reaplicação na abertura seguinte.
+******************************************************************************.
+* @param: path - O caminho do arquivo de configuração.
+******************************************************************************
+*/
+static void testTornTailAndReplay(const std::filesystem::path& path)
+{
+    writeFile(path, configText(502));
+    std::uint64_t confirmedBytes = 0; // Tamanho do journal com os registros confirmados.
+    {
+        ConfigurationManager manager(parserFor(path));
+        check(manager.openJournal(path.string(), 0).has_value(), "abertura do journal", 0);
+        check(manager.set("TCP", "port", 1001).has_value() && manager.set("UART", "parity", "even").has_value() && manager.set("TCP", "port", 1002).has_value(), "alteracoes com set", 0);
+        confirmedBytes = manager.journalStats()->bytes;
+    }
+
+    { // Registro interrompido no meio da gravação: um cabeçalho inteiro seguido de parte dos textos.
+        ConfigJournalRecordHeader header{};
+        header.sectionSize = 3;
+        header.keySize = 4;
+        header.valueSize = 4;
+        std::ofstream output(journalPathFor(path.string()), std::ios::binary | std::ios::app);
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output << "TCPpo";
+    }
+    check(std::filesystem::file_size(journalPathFor(path.string())) > confirmedBytes, "registro incompleto acrescentado", 0);
+
+    {
+        std::expected<std::unique_ptr<ConfigJournal>, ErrorCode> journal = ConfigJournal::open(path.string(), 0);
+        check(journal.has_value(), "reabertura do journal com o final incompleto", journal ? 0 : static_cast<long long>(journal.error()));
+        if (journal)
+        {
+            JournalStats stats = (*journal)->stats();
+            check(stats.records == 3, "registros validos depois do descarte", static_cast<long long>(stats.records));
+            check(stats.bytes == confirmedBytes, "tamanho do journal depois do descarte", static_cast<long long>(stats.bytes));
+        }
+    }
+    check(std::filesystem::file_size(journalPathFor(path.string())) == confirmedBytes, "journal truncado no ultimo registro confirmado", static_cast<long long>(std::filesystem::file_size(journalPathFor(path.string()))));
+
+    ConfigurationManager manager(parserFor(path));
+    check(tcpPort(manager) == 502, "arquivo base sem as alteracoes", tcpPort(manager));
+    check(manager.openJournal(path.string(), 0).has_value(), "segunda abertura do journal", 0);
+    check(tcpPort(manager) == 1002, "reaplicacao do valor mais recente", tcpPort(manager));
+    check(manager.get_uart_config().has_value() && manager.get_uart_config()->parity == "even", "reaplicacao da alteracao UART", 0);
+    check(manager.set("TCP", "port", 1003).has_value(), "alteracao depois do descarte", 0);
+    check(manager.journalStats()->records == 4, "registro acrescentado depois do descarte", static_cast<long long>(manager.journalStats()->records));
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica o texto gerado pela compactação.
+* @details : O journal recebe registros diretamente, sem a validação de set, para cobrir uma chave e uma seção que não existem no arquivo base.
+******************************************************************************.
+* @param: path - O caminho do arquivo de configuração.
+******************************************************************************
+*/
+static void testMergeEdits(const std::filesystem::path& path)
+{
+    writeFile(path, "; cabecalho\n[TCP]\nip=10.0.0.1\n  port =   502   \nprotocol=TCP\n\n[UART]\nbaudrate=9600\n");
+    std::expected<std::unique_ptr<ConfigJournal>, ErrorCode> journal = ConfigJournal::open(path.string(), 0);
+    check(journal.has_value(), "abertura do journal da compactacao", 0);
+    if (!journal)
+    {
+        return;
+    }
+    bool appended = (*journal)->append(JournalRecord{"TCP", "port", "9000"}).has_value() && (*journal)->append(JournalRecord{"TCP", "timeout", "30"}).has_value()
+                 && (*journal)->append(JournalRecord{"APP", "name", "x"}).has_value() && (*journal)->append(JournalRecord{"UART", "baudrate", "1"}).has_value()
+                 && (*journal)->append(JournalRecord{"UART", "baudrate", "115200"}).has_value();
+    check(appended, "registros acrescentados", 0);
+    check((*journal)->compact().has_value(), "compactacao", 0);
+
+    std::string expected = "; cabecalho\n[TCP]\nip=10.0.0.1\n  port =   9000   \nprotocol=TCP\ntimeout=30\n\n[UART]\nbaudrate=115200\n\n[APP]\nname=x\n";
+    std::string merged = readFile(path);
+    check(merged == expected, "texto da compactacao (valor no lugar, chave e secao acrescentadas)", static_cast<long long>(merged.size()));
+    if (merged != expected)
+    {
+        std::fprintf(stderr, "%s", merged.c_str());
+    }
+    JournalStats stats = (*journal)->stats();
+    check(stats.records == 0 && stats.bytes == sizeof(ConfigJournalHeader), "journal vazio depois da compactacao", static_cast<long long>(stats.records));
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica as alterações vistas por um reload depois de uma compactação.
+* @details : Um parser lido depois da compactação recebe somente o arquivo, de modo que uma mudança posterior do arquivo prevalece. Um parser lido antes dela, entregue com a geração lida antes da sua criação, continua recebendo as alterações incorporadas.
+******************************************************************************.
+* @param: path - O caminho do arquivo de configuração.
+******************************************************************************
+*/
+static void testCompactThenReload(const std::filesystem::path& path)
+{
+    writeFile(path, configText(502));
+    ConfigurationManager manager(parserFor(path));
+    check(manager.openJournal(path.string(), 0).has_value(), "abertura do journal do reload", 0);
+    check(manager.set("TCP", "port", 9000).has_value(), "alteracao da porta", 0);
+
+    std::uint64_t generation = manager.journalGeneration(); // Lida antes do parser, como no ConfigWatcher.
+    std::unique_ptr<IConfigParser> stale = parserFor(path); // Lido antes da compactação: porta 502.
+    check(manager.compactJournal().has_value(), "compactacao do journal do reload", 0);
+    check(manager.journalGeneration() == generation + 1, "geracao incrementada pela compactacao", static_cast<long long>(manager.journalGeneration()));
+    check(manager.reload(std::move(stale), generation).has_value(), "reload do parser anterior a compactacao", 0);
+    check(tcpPort(manager) == 9000, "parser anterior a compactacao mantem a alteracao", tcpPort(manager));
+
+    check(manager.reload(parserFor(path)).has_value(), "reload do arquivo compactado", 0);
+    check(tcpPort(manager) == 9000, "arquivo compactado contem a alteracao", tcpPort(manager));
+
+    writeFile(path, configText(7000)); // Mudança do operador depois da compactação.
+    check(manager.reload(parserFor(path), manager.journalGeneration()).has_value(), "reload do arquivo alterado", 0);
+    check(tcpPort(manager) == 7000, "mudanca do arquivo depois da compactacao prevalece", tcpPort(manager));
+
+    check(manager.set("TCP", "port", 9100).has_value(), "alteracao depois da compactacao", 0);
+    writeFile(path, configText(7001));
+    check(manager.reload(parserFor(path)).has_value(), "reload com alteracao no journal", 0);
+    check(tcpPort(manager) == 9100, "alteracao ainda no journal sobreposta ao arquivo", tcpPort(manager));
+}
+
+int main()
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / ("config_journal_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+
+    testTornTailAndReplay(directory / "torn.ini");
+    testMergeEdits(directory / "merge.ini");
+    testCompactThenReload(directory / "reload.ini");
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    std::printf("%d falhas\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
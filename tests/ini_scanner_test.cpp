@@ -0,0 +1,257 @@
+/*
+ * ini_scanner_test.cpp
+ *
+ * Teste dos núcleos de varredura do IniTokenizer: as máscaras de cada núcleo (escalar, SSE2 e AVX2, os suportados pelo processador) são comparadas com uma varredura byte a byte, e os tokens produzidos pelo IniTokenizer em cada nível são comparados com os de uma divisão simples do texto em linhas. Os textos colocam '\n', '\r', '=' e ';' nas posições 63 e 64 dos blocos de 64 bytes, linhas que atravessam blocos, linhas CRLF e um último bloco incompleto.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "IniScanner.hpp"
+#include "IniTokenizer.hpp"
+/*----------------------------------------------------------------------------*/
+
+static int g_failures = 0; // Falhas encontradas.
+
+/**
+******************************************************************************
+* @brief   : Verifica uma condição do teste e registra a falha, se houver.
+******************************************************************************.
+* @param: condition - A condição esperada.
+* @param: message - A descrição da verificação.
+* @param: value - Um valor que ajuda a diagnosticar a falha (posição, quantidade de tokens, ...).
+******************************************************************************
+*/
+static void check(bool condition, const char* message, long long value)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "FALHA: %s (%lld)\n", message, value);
+        ++g_failures;
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna os níveis de varredura suportados pelo processador em execução.
+******************************************************************************.
+* @return: std::vector<IniScanLevel> - Os níveis, do escalar até o melhor suportado.
+******************************************************************************
+*/
+static std::vector<IniScanLevel> supportedLevels()
+{
+    std::vector<IniScanLevel> levels;
+    for (int level = 0; level <= static_cast<int>(bestIniScanLevel()); ++level)
+    {
+        levels.push_back(static_cast<IniScanLevel>(level));
+    }
+    return levels;
+}
+
+/**
+******************************************************************************
+* @brief   : Compara as máscaras de um núcleo com uma varredura byte a byte de um bloco.
+******************************************************************************.
+* @param: level - O nível do núcleo.
+* @param: block - O início do bloco de 64 bytes.
+* @param: message - A descrição do bloco.
+******************************************************************************
+*/
+static void checkBlock(IniScanLevel level, const char* block, const char* message)
+{
+    IniBlockMasks expected{0, 0};
+    for (std::size_t i = 0; i < INI_SCAN_BLOCK; ++i)
+    {
+        expected.newlines |= std::uint64_t{block[i] == '\n'} << i;
+        expected.delimiters |= std::uint64_t{block[i] == '='} << i;
+    }
+    IniBlockMasks actual = iniBlockScanner(level)(block);
+    check(actual.newlines == expected.newlines, message, static_cast<long long>(level));
+    check(actual.delimiters == expected.delimiters, message, static_cast<long long>(level));
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica as máscaras dos núcleos em blocos construídos e aleatórios.
+* @details : Os blocos aleatórios incluem bytes que diferem de '\n' e '=' somente no bit alto (0x8A e 0xBD) e bytes vizinhos, que exercitam a comparação sem vai-um do núcleo escalar.
+******************************************************************************.
+* @param: level - O nível do núcleo.
+******************************************************************************
+*/
+static void testBlockMasks(IniScanLevel level)
+{
+    char block[INI_SCAN_BLOCK];
+    for (char c : {'\n', '='}) // Um único caractere em cada posição, inclusive nas extremidades 0 e 63.
+    {
+        for (std::size_t position = 0; position < INI_SCAN_BLOCK; ++position)
+        {
+            std::string(INI_SCAN_BLOCK, 'a').copy(block, INI_SCAN_BLOCK);
+            block[position] = c;
+            checkBlock(level, block, "mascara de um caractere isolado");
+        }
+    }
+    std::string(INI_SCAN_BLOCK, '\n').copy(block, INI_SCAN_BLOCK);
+    checkBlock(level, block, "mascara de um bloco so de quebras de linha");
+    std::string(INI_SCAN_BLOCK, '=').copy(block, INI_SCAN_BLOCK);
+    checkBlock(level, block, "mascara de um bloco so de delimitadores");
+
+    static constexpr unsigned char ALPHABET[] = {'\n', '=', '\r', ';', '#', '[', ']', ' ', 'a', 0x00, 0x09, 0x0B, 0x3C, 0x3E, 0x7F, 0x80, 0x8A, 0xBD, 0xFF};
+    std::mt19937 random(12345);
+    std::uniform_int_distribution<std::size_t> pick(0, sizeof(ALPHABET) - 1);
+    for (int i = 0; i < 2000; ++i)
+    {
+        for (char& c : block)
+        {
+            c = static_cast<char>(ALPHABET[pick(random)]);
+        }
+        checkBlock(level, block, "mascara de um bloco aleatorio");
+    }
+}
+
+// Token com cópias dos textos, para comparar tokens de textos diferentes.
+struct OwnedToken
+{
+    std::string section; // Seção.
+    std::string key; // Chave.
+    std::string value; // Valor.
+
+    bool operator==(const OwnedToken&) const = default;
+};
+
+/**
+******************************************************************************
+* @brief   : Extrai os tokens de um texto dividindo-o em linhas com std::string_view::find, sem os núcleos de varredura.
+******************************************************************************.
+* @param: text - O texto INI.
+* @param: lines - Recebe a quantidade de linhas.
+* @return: std::vector<OwnedToken> - Os tokens, na ordem do texto.
+******************************************************************************
+*/
+static std::vector<OwnedToken> referenceTokens(std::string_view text, std::size_t& lines)
+{
+    std::vector<OwnedToken> tokens;
+    std::string_view section;
+    lines = 0;
+    for (std::size_t position = 0; position < text.size(); ++lines)
+    {
+        std::size_t end = text.find('\n', position);
+        end = end == std::string_view::npos ? text.size() : end;
+        std::string_view first;
+        std::string_view second;
+        switch (parseIniLine(text.substr(position, end - position), first, second))
+        {
+        case IniLineType::SECTION:
+            section = first;
+            break;
+        case IniLineType::KEY_VALUE:
+            tokens.push_back(OwnedToken{std::string(section), std::string(first), std::string(second)});
+            break;
+        case IniLineType::IGNORED:
+            break;
+        }
+        position = end + 1;
+    }
+    return tokens;
+}
+
+/**
+******************************************************************************
+* @brief   : Compara os tokens do IniTokenizer em cada nível com os da divisão simples do texto.
+******************************************************************************.
+* @param: text - O texto INI.
+* @param: message - A descrição do texto.
+******************************************************************************
+*/
+static void checkTokens(std::string_view text, const char* message)
+{
+    std::size_t expectedLines = 0;
+    std::vector<OwnedToken> expected = referenceTokens(text, expectedLines);
+    check(estimateIniEntries(text) >= expected.size(), "estimateIniEntries abaixo da quantidade de pares", static_cast<long long>(estimateIniEntries(text)));
+    for (IniScanLevel level : supportedLevels())
+    {
+        IniTokenizer tokenizer(text, level);
+        std::vector<OwnedToken> actual;
+        IniToken token;
+        while (tokenizer.next(token))
+        {
+            actual.push_back(OwnedToken{std::string(token.section), std::string(token.key), std::string(token.value)});
+        }
+        check(actual == expected, message, static_cast<long long>(level));
+        check(tokenizer.lineCount() == expectedLines, "quantidade de linhas do IniTokenizer", static_cast<long long>(tokenizer.lineCount()));
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Monta um texto em que o caractere indicado fica na posição indicada, precedido por uma linha de preenchimento.
+******************************************************************************.
+* @param: position - A posição do caractere no texto (por exemplo, 63 ou 64, nas extremidades dos blocos).
+* @param: line - A linha que contém o caractere.
+* @param: index - O índice do caractere dentro de line.
+* @return: std::string - O texto, com uma seção antes e outra linha depois.
+******************************************************************************
+*/
+static std::string placeAt(std::size_t position, std::string_view line, std::size_t index)
+{
+    std::string text = "[S]\n";
+    std::size_t padding = position - index - text.size() - 1; // Tamanho da chave de preenchimento, antes do '=' e do '\n'.
+    text += std::string(padding - 2, 'p') + "=v\n";
+    text += line;
+    text += "\nfinal=1";
+    return text;
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica o IniTokenizer com caracteres estruturais nas extremidades dos blocos, linhas que atravessam blocos e CRLF.
+******************************************************************************
+*/
+static void testTokenizerBoundaries()
+{
+    for (std::size_t position : {62, 63, 64, 65, 127, 128})
+    {
+        checkTokens(placeAt(position, "chave=valor", 5), "'=' na extremidade do bloco");
+        checkTokens(placeAt(position, "chave==valor=x", 6), "segundo '=' na extremidade do bloco");
+        checkTokens(placeAt(position, "; comentario=ignorado", 0), "';' na extremidade do bloco");
+        checkTokens(placeAt(position, "chave=valor;fim", 11), "';' no valor na extremidade do bloco");
+        checkTokens(placeAt(position, "chave=valor\r", 11), "'\\r' de CRLF na extremidade do bloco");
+        checkTokens(placeAt(position, "[SECAO]", 0), "cabecalho na extremidade do bloco");
+        checkTokens(placeAt(position, "[SECAO]\r", 6), "']' antes de CRLF na extremidade do bloco");
+    }
+
+    std::string crossing = "[TCP]\r\n"; // Linhas longas, com o '=' e o '\n' em blocos diferentes.
+    for (int i = 0; i < 10; ++i)
+    {
+        crossing += "chave" + std::to_string(i) + std::string(40 + i * 13, ' ') + "=" + std::string(30 + i * 7, 'v') + "\r\n";
+    }
+    checkTokens(crossing, "linhas CRLF que atravessam blocos");
+
+    for (std::size_t size : {63, 64, 65, 127, 128, 129}) // O último bloco, completo ou não, com e sem '\n' final.
+    {
+        std::string text = "[S]\nk=" + std::string(size - 7, 'v') + "\n";
+        checkTokens(text, "texto que termina na extremidade do bloco");
+        text.pop_back();
+        checkTokens(text, "texto sem '\\n' final na extremidade do bloco");
+    }
+    checkTokens(std::string(64, '\n') + "k=v" + std::string(61, '\n') + "=sem chave\n[X]\nk2=v2", "blocos so de quebras de linha");
+}
+
+int main()
+{
+    for (IniScanLevel level : supportedLevels())
+    {
+        std::printf("nivel %s\n", iniScanLevelName(level));
+        testBlockMasks(level);
+    }
+    testTokenizerBoundaries();
+
+    std::printf("%d falhas\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+/*
+ * json_parser_test.cpp
+ *
+ * Teste do JsonParser e da detecção de formato: limite de 64 níveis de aninhamento, sequências de escape com pares substitutos, números mal formados, null como chave ausente, caracteres de controle sem escape nas strings e os formatos escolhidos por detectConfigFormat.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "IniParser.hpp"
+#include "JsonParser.hpp"
+#include "ParserFactory.hpp"
+/*----------------------------------------------------------------------------*/
+
+static int g_failures = 0; // Falhas encontradas.
+static std::filesystem::path g_directory; // Diretório temporário dos arquivos do teste.
+
+static constexpr std::string_view TCP_SECTION = R"("TCP": {"ip": "10.0.0.1", "port": 502, "protocol": "TCP"})"; // Seção TCP válida, acrescentada aos documentos para distinguir um documento aceito de um rejeitado.
+
+/**
+******************************************************************************
+* @brief   : Verifica uma condição do teste e registra a falha, se houver.
+******************************************************************************.
+* @param: condition - A condição esperada.
+* @param: message - A descrição da verificação.
+* @param: value - Um valor que ajuda a diagnosticar a falha (código de erro, tamanho, ...).
+******************************************************************************
+*/
+static void check(bool condition, const char* message, long long value)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "FALHA: %s (%lld)\n", message, value);
+        ++g_failures;
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Grava um arquivo no diretório temporário.
+******************************************************************************.
+* @param: name - O nome do arquivo.
+* @param: text - O conteúdo.
+* @return: std::string - O caminho do arquivo.
+******************************************************************************
+*/
+static std::string writeFile(const char* name, std::string_view text)
+{
+    std::filesystem::path path = g_directory / name;
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << text;
+    return path.string();
+}
+
+/**
+******************************************************************************
+* @brief   : Carrega um documento JSON e retorna o código de erro da configuração TCP.
+******************************************************************************.
+* @param: text - O documento.
+* @return: long long - -1 se a configuração TCP foi lida, ou o código de erro retornado por parseTcp.
+******************************************************************************
+*/
+static long long tcpError(std::string_view text)
+{
+    JsonParser parser(writeFile("documento.json", text));
+    std::expected<TcpConfig, ErrorCode> tcp = parser.parseTcp();
+    return tcp ? -1 : static_cast<long long>(tcp.error());
+}
+
+/**
+******************************************************************************
+* @brief   : Retorna o valor de um membro escalar da seção "S" de um documento.
+******************************************************************************.
+* @param: value - O texto JSON do valor, como aparece no documento.
+* @return: std::optional<std::string> - O valor indexado, ou std::nullopt se o documento for rejeitado ou o membro estiver ausente.
+******************************************************************************
+*/
+static std::optional<std::string> memberValue(std::string_view value)
+{
+    JsonParser parser(writeFile("membro.json", "{\"S\": {\"k\": " + std::string(value) + "}}"));
+    std::optional<std::string_view> found = parser.findValue("S", "k");
+    return found ? std::optional<std::string>(*found) : std::nullopt;
+}
+
+/**
+******************************************************************************
+* @brief   : Monta um documento em que a seção "S" tem listas aninhadas até o total de objetos e listas indicado, com um número no nível mais interno.
+******************************************************************************.
+* @param: containers - A quantidade total de objetos e listas em volta do número, contando o objeto principal e o da seção.
+* @return: std::string - O documento.
+******************************************************************************
+*/
+static std::string nested(std::size_t containers)
+{
+    std::size_t lists = containers - 2;
+    return "{" + std::string(TCP_SECTION) + ", \"S\": {\"k\": " + std::string(lists, '[') + "1" + std::string(lists, ']') + "}}";
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica o limite de aninhamento: 64 níveis são aceitos, 65 são rejeitados, e um documento muito profundo é rejeitado sem esgotar a pilha.
+******************************************************************************
+*/
+static void testDepthLimit()
+{
+    check(tcpError(nested(64)) == -1, "64 niveis de aninhamento aceitos", tcpError(nested(64)));
+    check(tcpError(nested(65)) == static_cast<long long>(ErrorCode::INVALID_FORMAT), "65 niveis de aninhamento rejeitados", tcpError(nested(65)));
+    check(tcpError(nested(200000)) == static_cast<long long>(ErrorCode::INVALID_FORMAT), "documento muito profundo rejeitado", 0);
+    std::string objects = "{" + std::string(TCP_SECTION) + ", \"S\": {\"k\": "; // Objetos aninhados, em vez de listas.
+    for (int i = 0; i < 70; ++i)
+    {
+        objects += "{\"a\": ";
+    }
+    objects += "1" + std::string(70, '}') + "}}";
+    check(tcpError(objects) == static_cast<long long>(ErrorCode::INVALID_FORMAT), "objetos aninhados alem do limite rejeitados", 0);
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica a decodificação das sequências de escape, inclusive pares substitutos, e a rejeição de substitutos isolados.
+******************************************************************************
+*/
+static void testEscapes()
+{
+    check(memberValue(R"("\ud83d\ude00")") == "\xF0\x9F\x98\x80", "par substituto decodificado em UTF-8 de 4 bytes", 0);
+    check(memberValue(R"("a\u00e9\u20acb")") == "a\xC3\xA9\xE2\x82\xAC" "b", "escapes de 2 e 3 bytes em UTF-8", 0);
+    check(memberValue(R"("\"\\\/\b\f\n\r\t")") == "\"\\/\b\f\n\r\t", "escapes simples", 0);
+    check(memberValue(R"("sem escape")") == "sem escape", "string sem escape", 0);
+    check(memberValue(R"("\u0009")") == "\t", "caractere de controle escapado aceito", 0);
+    for (std::string_view invalid : {R"("\ud83d")", R"("\ude00")", R"("\ud83dA")", R"("\ud83dx")", R"("\u12")", R"("\x")", R"("\u12G4")"})
+    {
+        check(!memberValue(invalid).has_value(), "sequencia de escape invalida rejeitada", static_cast<long long>(invalid.size()));
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica a rejeição de caracteres de controle sem escape nas strings, nos valores e nos nomes dos membros.
+******************************************************************************
+*/
+static void testControlCharacters()
+{
+    for (std::string_view invalid : {std::string_view("\"a\tb\""), std::string_view("\"a\nb\""), std::string_view("\"\x01\""), std::string_view("\"\x1F\\n\"")})
+    {
+        check(!memberValue(invalid).has_value(), "caractere de controle sem escape no valor rejeitado", static_cast<long long>(invalid.size()));
+    }
+    std::string document = "{" + std::string(TCP_SECTION) + ", \"S\": {\"k\\u0009\": 1, \"a\tb\": 2}}";
+    check(tcpError(document) == static_cast<long long>(ErrorCode::INVALID_FORMAT), "caractere de controle sem escape no nome rejeitado", tcpError(document));
+
+    JsonParser parser(writeFile("controle.json", "{\n  \"S\": {\n    \"k\": \"ab\tc\"\n  }\n}"));
+    SourceLocation location = parser.locate("S", "k");
+    check(location.line == 3 && location.column == 13, "locate aponta o caractere de controle", static_cast<long long>(location.line * 100 + location.column));
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica a gramática dos números: os mal formados rejeitam o documento, e os válidos são indexados como estão no arquivo.
+******************************************************************************
+*/
+static void testNumbers()
+{
+    for (std::string_view valid : {"0", "-0", "502", "-12", "1.5", "1.5e-3", "2E+10", "0.0e0"})
+    {
+        check(memberValue(valid) == std::string(valid), "numero valido indexado como texto", static_cast<long long>(valid.size()));
+    }
+    for (std::string_view invalid : {"01", "-01", "1.", ".5", "-", "1e", "1e+", "+1", "--1", "0x10", "1.e3", "1..2", "NaN", "Infinity"})
+    {
+        check(!memberValue(invalid).has_value(), "numero mal formado rejeitado", static_cast<long long>(invalid.size()));
+        check(tcpError("{" + std::string(TCP_SECTION) + ", \"S\": {\"k\": " + std::string(invalid) + "}}") == static_cast<long long>(ErrorCode::INVALID_FORMAT), "numero mal formado rejeita o documento", static_cast<long long>(invalid.size()));
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica que null equivale a uma chave ausente: a seção global é consultada, e a falta da chave resulta no mesmo erro do IniParser.
+******************************************************************************
+*/
+static void testNullAsAbsent()
+{
+    JsonParser withGlobal(writeFile("nulo_global.json", R"({"port": 700, "TCP": {"ip": "10.0.0.1", "port": null, "protocol": "TCP"}})"));
+    check(withGlobal.findValue("TCP", "port") == "700", "null recorre a secao global", 0);
+    check(withGlobal.parseTcp().has_value() && withGlobal.parseTcp()->port == 700, "configuracao com null e valor global", 0);
+
+    JsonParser withoutGlobal(writeFile("nulo.json", R"({"TCP": {"ip": "10.0.0.1", "port": null, "protocol": "TCP"}})"));
+    IniParser missing(writeFile("ausente.ini", "[TCP]\nip=10.0.0.1\nprotocol=TCP\n"));
+    std::expected<TcpConfig, ErrorCode> json = withoutGlobal.parseTcp();
+    std::expected<TcpConfig, ErrorCode> ini = missing.parseTcp();
+    check(!withoutGlobal.findValue("TCP", "port").has_value(), "null nao e indexado", 0);
+    check(!json && !ini && json.error() == ini.error(), "null resulta no erro de chave ausente do IniParser", json ? -1 : static_cast<long long>(json.error()));
+
+    JsonParser nullString(writeFile("texto_nulo.json", R"({"TCP": {"ip": "10.0.0.1", "port": 502, "protocol": "null"}})"));
+    check(nullString.findValue("TCP", "protocol") == "null", "a string \"null\" e um valor", 0);
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica os formatos escolhidos por detectConfigFormat e o parser criado por createParser para cada um.
+******************************************************************************
+*/
+static void testDetectConfigFormat()
+{
+    check(detectConfigFormat("{\"TCP\": {}}") == ConfigFormat::JSON, "objeto JSON", 0);
+    check(detectConfigFormat(" \r\n\t {") == ConfigFormat::JSON, "objeto JSON depois de espacos", 0);
+    check(detectConfigFormat("\xEF\xBB\xBF{}") == ConfigFormat::JSON, "objeto JSON depois da marca de ordem de bytes", 0);
+    check(detectConfigFormat("[TCP]\nport=502\n") == ConfigFormat::INI, "texto INI", 0);
+    check(detectConfigFormat("; {comentario}\n[TCP]\n") == ConfigFormat::INI, "INI com '{' em um comentario", 0);
+    check(detectConfigFormat("") == ConfigFormat::INI, "arquivo vazio", 0);
+    check(detectConfigFormat("[1, 2]") == ConfigFormat::INI, "lista JSON no nivel principal nao e JSON", 0);
+    check(detectConfigFormat(std::string_view("[TCP]\n\0\x01", 8)) == ConfigFormat::UNKNOWN, "conteudo binario", 0);
+    check(detectConfigFormat("{\x7F}") == ConfigFormat::UNKNOWN, "caractere DEL", 0);
+
+    std::expected<std::unique_ptr<IConfigParser>, ErrorCode> json = createParser(writeFile("json_com_extensao.ini", "{" + std::string(TCP_SECTION) + "}"));
+    check(json.has_value() && dynamic_cast<JsonParser*>(json->get()) != nullptr, "createParser escolhe o JsonParser pelo conteudo", 0);
+    std::expected<std::unique_ptr<IConfigParser>, ErrorCode> binary = createParser(writeFile("binario.json", std::string_view("\x00\x01\x02", 3)));
+    check(!binary && binary.error() == ErrorCode::INVALID_FORMAT, "createParser rejeita conteudo binario", binary ? -1 : static_cast<long long>(binary.error()));
+}
+
+int main()
+{
+    g_directory = std::filesystem::temp_directory_path() / ("json_parser_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(g_directory);
+
+    testDepthLimit();
+    testEscapes();
+    testControlCharacters();
+    testNumbers();
+    testNullAsAbsent();
+    testDetectConfigFormat();
+
+    std::error_code error;
+    std::filesystem::remove_all(g_directory, error);
+    std::printf("%d falhas\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
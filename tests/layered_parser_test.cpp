@@ -0,0 +1,180 @@
+/*
+ * layered_parser_test.cpp
+ *
+ * Teste do LayeredParser sobre um diretório no estilo conf.d: precedência das camadas (o arquivo base seguido dos fragmentos *.ini em ordem alfabética do nome, a última camada prevalece), arquivos e diretórios ignorados, a origem de cada valor (originOf) e a sua posição (locate), com uma e com várias threads de carga.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "ConfigurationManager.hpp"
+#include "LayeredParser.hpp"
+#include "ParserFactory.hpp"
+/*----------------------------------------------------------------------------*/
+
+static int g_failures = 0; // Falhas encontradas.
+
+/**
+******************************************************************************
+* @brief   : Verifica uma condição do teste e registra a falha, se houver.
+******************************************************************************.
+* @param: condition - A condição esperada.
+* @param: message - A descrição da verificação.
+* @param: value - Um valor que ajuda a diagnosticar a falha (linha, quantidade de camadas, ...).
+******************************************************************************
+*/
+static void check(bool condition, const char* message, long long value)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "FALHA: %s (%lld)\n", message, value);
+        ++g_failures;
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Grava um arquivo por completo.
+******************************************************************************.
+* @param: path - O caminho do arquivo.
+* @param: text - O conteúdo.
+******************************************************************************
+*/
+static void writeFile(const std::filesystem::path& path, std::string_view text)
+{
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << text;
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica a origem de um valor.
+******************************************************************************.
+* @param: parser - O parser.
+* @param: section - A seção.
+* @param: key - A chave.
+* @param: expected - O caminho esperado.
+* @param: message - A descrição da verificação.
+******************************************************************************
+*/
+static void checkOrigin(const LayeredParser& parser, std::string_view section, std::string_view key, const std::filesystem::path& expected, const char* message)
+{
+    std::optional<std::string_view> origin = parser.originOf(section, key);
+    check(origin.has_value() && std::filesystem::path(*origin) == expected, message, 0);
+    if (origin && std::filesystem::path(*origin) != expected)
+    {
+        std::fprintf(stderr, "  %.*s\n", static_cast<int>(origin->size()), origin->data());
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica a precedência, as origens e as posições dos valores de um diretório conf.d.
+* @details : Os fragmentos são criados fora da ordem do nome, e "9-late.ini" vem depois de "20-device.ini", pois a ordem é alfabética e não numérica. Um arquivo .bak, um .txt e um diretório com a extensão .ini não são camadas.
+******************************************************************************.
+* @param: directory - O diretório temporário do teste.
+* @param: threads - A quantidade de threads de carga.
+******************************************************************************
+*/
+static void testPrecedence(const std::filesystem::path& directory, unsigned threads)
+{
+    std::filesystem::path base = directory / "base.ini";
+    std::filesystem::path confd = directory / "conf.d";
+    std::filesystem::create_directories(confd / "40-dir.ini");
+    writeFile(base, "timeout=5\n[TCP]\nip=10.0.0.1\nport=502\nprotocol=TCP\n\n[UART]\nbaudrate=9600\ndata_bits=8\nparity=none\nstop_bits=1\n");
+    writeFile(confd / "9-late.ini", "[TCP]\nport=9000\n");
+    writeFile(confd / "20-device.ini", "[UART]\nparity=even\n[TCP]\nport=2000\nprotocol=UDP\n");
+    writeFile(confd / "10-site.ini", "; site\n[TCP]\nip=10.1.1.1\nport=1000\n\n[TCP3]\nip=10.3.3.3\nport=3000\nprotocol=TCP\n");
+    writeFile(confd / "30-ignored.ini.bak", "[TCP]\nport=1\n");
+    writeFile(confd / "notes.txt", "[TCP]\nport=2\n");
+    writeFile(confd / "40-dir.ini" / "inner.ini", "[TCP]\nport=3\n");
+
+    LayeredParser parser(base.string(), confd.string(), threads);
+    check(!parser.loadError().has_value(), "carga das camadas", 0);
+    check(parser.layerCount() == 4, "base e tres fragmentos .ini", static_cast<long long>(parser.layerCount()));
+
+    std::expected<TcpConfig, ErrorCode> tcp = parser.parseTcp();
+    check(tcp.has_value() && tcp->port == 9000, "9-late.ini, o ultimo em ordem alfabetica, prevalece", tcp ? tcp->port : -1);
+    check(tcp.has_value() && tcp->ip == "10.1.1.1", "chave sobrescrita somente por 10-site.ini", 0);
+    check(tcp.has_value() && tcp->protocol == "UDP", "chave sobrescrita somente por 20-device.ini", 0);
+    std::expected<UartConfig, ErrorCode> uart = parser.parseUart();
+    check(uart.has_value() && uart->parity == "even" && uart->baudrate == 9600, "UART combinada entre a base e 20-device.ini", 0);
+    std::expected<TcpConfig, ErrorCode> instance = parser.parseTcpSection("TCP3");
+    check(instance.has_value() && instance->port == 3000, "secao declarada somente em um fragmento", instance ? instance->port : -1);
+
+    checkOrigin(parser, "TCP", "port", confd / "9-late.ini", "origem da porta");
+    checkOrigin(parser, "TCP", "ip", confd / "10-site.ini", "origem do ip");
+    checkOrigin(parser, "TCP", "protocol", confd / "20-device.ini", "origem do protocolo");
+    checkOrigin(parser, "UART", "baudrate", base, "origem de uma chave so do arquivo base");
+    checkOrigin(parser, "TCP", "timeout", base, "origem de uma chave da secao global");
+    check(!parser.originOf("TCP", "inexistente").has_value(), "origem de uma chave ausente", 0);
+
+    SourceLocation port = parser.locate("TCP", "port");
+    check(std::filesystem::path(port.file) == confd / "9-late.ini" && port.line == 2 && port.column == 6, "posicao da porta em 9-late.ini", static_cast<long long>(port.line * 100 + port.column));
+    SourceLocation ip = parser.locate("TCP", "ip");
+    check(std::filesystem::path(ip.file) == confd / "10-site.ini" && ip.line == 3 && ip.column == 4, "posicao do ip em 10-site.ini", static_cast<long long>(ip.line * 100 + ip.column));
+    SourceLocation baudrate = parser.locate("UART", "baudrate");
+    check(std::filesystem::path(baudrate.file) == base && baudrate.line == 8 && baudrate.column == 10, "posicao de uma chave do arquivo base", static_cast<long long>(baudrate.line * 100 + baudrate.column));
+    SourceLocation header = parser.locate("TCP3", "");
+    check(std::filesystem::path(header.file) == confd / "10-site.ini" && header.line == 6, "posicao do cabecalho de uma secao do fragmento", static_cast<long long>(header.line));
+
+    std::error_code error;
+    std::filesystem::remove_all(confd, error);
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica a carga sem diretório, sem arquivo base e pelo ConfigurationManager.
+******************************************************************************.
+* @param: directory - O diretório temporário do teste.
+******************************************************************************
+*/
+static void testFactory(const std::filesystem::path& directory)
+{
+    std::filesystem::path base = directory / "base.ini";
+    std::filesystem::path confd = directory / "conf.d";
+    writeFile(base, "[TCP]\nip=10.0.0.1\nport=502\nprotocol=TCP\n\n[UART]\nbaudrate=9600\ndata_bits=8\nparity=none\nstop_bits=1\n");
+
+    std::expected<std::unique_ptr<IConfigParser>, ErrorCode> baseOnly = createLayeredParser(base.string(), (directory / "inexistente").string());
+    check(baseOnly.has_value() && dynamic_cast<LayeredParser&>(**baseOnly).layerCount() == 1, "diretorio inexistente equivale a um diretorio vazio", 0);
+    std::expected<std::unique_ptr<IConfigParser>, ErrorCode> missing = createLayeredParser((directory / "sem_base.ini").string(), confd.string());
+    check(!missing && missing.error() == ErrorCode::FILE_OPEN_FAILED, "arquivo base ausente", missing ? -1 : static_cast<long long>(missing.error()));
+
+    std::filesystem::create_directories(confd);
+    writeFile(confd / "50-port.ini", "[TCP]\nport=5000\n");
+    std::expected<std::unique_ptr<IConfigParser>, ErrorCode> layered = createLayeredParser(base.string(), confd.string(), 2);
+    check(layered.has_value(), "createLayeredParser", 0);
+    if (layered)
+    {
+        ConfigurationManager manager(std::move(*layered));
+        check(manager.get_tcp_config().has_value() && manager.get_tcp_config()->port == 5000, "gerenciador com a configuracao combinada", 0);
+        writeFile(confd / "60-port.ini", "[TCP]\nport=6000\n"); // Um fragmento novo, visto no reload.
+        std::expected<std::unique_ptr<IConfigParser>, ErrorCode> reloaded = createLayeredParser(base.string(), confd.string(), 2);
+        check(reloaded.has_value() && manager.reload(std::move(*reloaded)).has_value(), "reload com um fragmento novo", 0);
+        check(manager.get_tcp_config().has_value() && manager.get_tcp_config()->port == 6000, "fragmento novo prevalece depois do reload", 0);
+    }
+}
+
+int main()
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / ("layered_parser_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+
+    testPrecedence(directory, 1);
+    testPrecedence(directory, 4);
+    testFactory(directory);
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    std::printf("%d falhas\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+/*
+ * lazy_ini_parser_test.cpp
+ *
+ * Teste do LazyIniParser: as consultas sob demanda devem dar os mesmos resultados do IniParser sobre o mesmo arquivo, inclusive para seções repetidas e chaves declaradas somente em uma repetição posterior da seção, e a primeira consulta a uma seção, feita por várias threads ao mesmo tempo, deve indexá-la uma única vez e publicar o mesmo índice para todas.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <latch>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "IniParser.hpp"
+#include "LazyIniParser.hpp"
+/*----------------------------------------------------------------------------*/
+
+static int g_failures = 0; // Falhas encontradas.
+
+static constexpr std::string_view KEYS[] = {"ip", "port", "protocol", "baudrate", "data_bits", "parity", "stop_bits", "name", "timeout"}; // Chaves consultadas em cada seção.
+
+/**
+******************************************************************************
+* @brief   : Verifica uma condição do teste e registra a falha, se houver.
+******************************************************************************.
+* @param: condition - A condição esperada.
+* @param: message - A descrição da verificação.
+* @param: value - Um valor que ajuda a diagnosticar a falha (quantidade de seções, código de erro, ...).
+******************************************************************************
+*/
+static void check(bool condition, const char* message, long long value)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "FALHA: %s (%lld)\n", message, value);
+        ++g_failures;
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Compara duas configurações TCP campo a campo.
+******************************************************************************.
+* @param: a - A primeira configuração.
+* @param: b - A segunda configuração.
+* @return: bool - Retorna true se todos os campos forem iguais.
+******************************************************************************
+*/
+static bool sameConfig(const TcpConfig& a, const TcpConfig& b)
+{
+    return a.ip == b.ip && a.port == b.port && a.protocol == b.protocol;
+}
+
+/**
+******************************************************************************
+* @brief   : Compara duas configurações UART campo a campo.
+******************************************************************************.
+* @param: a - A primeira configuração.
+* @param: b - A segunda configuração.
+* @return: bool - Retorna true se todos os campos forem iguais.
+******************************************************************************
+*/
+static bool sameConfig(const UartConfig& a, const UartConfig& b)
+{
+    return a.baudrate == b.baudrate && a.data_bits == b.data_bits && a.parity == b.parity && a.stop_bits == b.stop_bits;
+}
+
+/**
+******************************************************************************
+* @brief   : Compara dois resultados de configuração: o mesmo erro ou a mesma configuração.
+******************************************************************************.
+* @param: expected - O resultado do IniParser.
+* @param: actual - O resultado do LazyIniParser.
+* @return: bool - Retorna true se os resultados forem iguais.
+******************************************************************************
+*/
+template <typename T>
+static bool sameResult(const std::expected<T, ErrorCode>& expected, const std::expected<T, ErrorCode>& actual)
+{
+    if (expected.has_value() != actual.has_value())
+    {
+        return false;
+    }
+    return expected ? sameConfig(*expected, *actual) : expected.error() == actual.error();
+}
+
+/**
+******************************************************************************
+* @brief   : Monta o arquivo de teste: seções repetidas (inclusive numeradas), chaves que só aparecem em uma repetição posterior, chaves redeclaradas, uma seção sem chaves, comentários e chaves na seção global.
+******************************************************************************.
+* @param: instances - A quantidade de instâncias numeradas [TCPn] e [UARTn], cada uma dividida em dois trechos.
+* @return: std::string - O conteúdo do arquivo.
+******************************************************************************
+*/
+static std::string fixtureText(int instances)
+{
+    std::string text = "; arquivo de teste\ntimeout=5\nparity=none\n\n"
+                       "[TCP]\nip=10.0.0.1\nprotocol=TCP\n\n"
+                       "[UART]\nbaudrate=9600\ndata_bits=8\n\n"
+                       "[VAZIA]\n; sem chaves\n\n"
+                       "[APP]\nname=primeiro\n\n"
+                       "[TCP]\nport=502\nip=10.0.0.2\n\n" // Chave só na repetição e chave redeclarada.
+                       "[UART]\nstop_bits=1\n\n"
+                       "[APP]\ntimeout=30\nname=segundo\n\n"
+                       "[SO_NO_FINAL]\n";
+    for (int i = 0; i < instances; ++i) // Primeiro trecho de cada instância.
+    {
+        text += "[TCP" + std::to_string(i) + "]\nip=10.1.0." + std::to_string(i % 250) + "\nprotocol=UDP\n";
+        text += "[UART" + std::to_string(i) + "]\nbaudrate=115200\nparity=even\n";
+    }
+    for (int i = 0; i < instances; ++i) // Segundo trecho, com as chaves que faltavam.
+    {
+        text += "[TCP" + std::to_string(i) + "]\nport=" + std::to_string(1000 + i) + "\n";
+        text += "[UART" + std::to_string(i) + "]\ndata_bits=" + std::to_string(i % 2 == 0 ? 8 : 7) + "\nstop_bits=2\nparity=odd\n";
+    }
+    return text + "[SO_NO_FINAL]\nname=ultimo";
+}
+
+/**
+******************************************************************************
+* @brief   : Compara as consultas de uma seção no LazyIniParser com as do IniParser.
+******************************************************************************.
+* @param: reference - O IniParser.
+* @param: lazy - O LazyIniParser.
+* @param: section - O nome da seção.
+* @return: bool - Retorna true se todas as consultas forem iguais.
+******************************************************************************
+*/
+static bool sameSection(const IniParser& reference, const LazyIniParser& lazy, std::string_view section)
+{
+    for (std::string_view key : KEYS)
+    {
+        if (reference.findValue(section, key) != lazy.findValue(section, key))
+        {
+            return false;
+        }
+    }
+    return sameResult(reference.parseTcpSection(section), lazy.parseTcpSection(section)) && sameResult(reference.parseUartSection(section), lazy.parseUartSection(section));
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica que as consultas do LazyIniParser, feitas por uma única thread, são iguais às do IniParser.
+******************************************************************************.
+* @param: path - O caminho do arquivo de teste.
+******************************************************************************
+*/
+static void testMatchesIniParser(const std::string& path)
+{
+    IniParser reference(path);
+    LazyIniParser lazy(path);
+
+    std::span<const std::string_view> expectedNames = reference.sectionNames();
+    std::span<const std::string_view> names = lazy.sectionNames();
+    check(std::equal(expectedNames.begin(), expectedNames.end(), names.begin(), names.end()), "nomes das secoes, na ordem do arquivo", static_cast<long long>(names.size()));
+    check(lazy.parsedSectionCount() == 0, "nenhuma secao indexada antes da primeira consulta", static_cast<long long>(lazy.parsedSectionCount()));
+
+    check(lazy.findValue("TCP", "port") == "502", "chave declarada somente na repeticao da secao", 0);
+    check(lazy.findValue("TCP", "ip") == "10.0.0.2", "redeclaracao na repeticao prevalece", 0);
+    check(lazy.findValue("APP", "timeout") == "30", "repeticao prevalece sobre a secao global", 0);
+    check(lazy.findValue("UART", "parity") == "none", "secao global como alternativa", 0);
+    check(lazy.findValue("SO_NO_FINAL", "name") == "ultimo", "secao com chaves somente na ultima repeticao", 0);
+
+    check(sameResult(reference.parseTcp(), lazy.parseTcp()), "parseTcp igual ao do IniParser", 0);
+    check(sameResult(reference.parseUart(), lazy.parseUart()), "parseUart igual ao do IniParser", 0);
+    for (std::string_view section : expectedNames)
+    {
+        check(sameSection(reference, lazy, section), "consultas da secao iguais as do IniParser", static_cast<long long>(section.size()));
+    }
+    for (std::string_view section : {"VAZIA", "INEXISTENTE", "TCP999", ""})
+    {
+        check(sameSection(reference, lazy, section), "consultas de uma secao sem chaves iguais as do IniParser", static_cast<long long>(section.size()));
+    }
+    SourceLocation expected = reference.locate("TCP", "port");
+    SourceLocation actual = lazy.locate("TCP", "port");
+    check(expected.line == actual.line && expected.column == actual.column, "locate de uma chave da repeticao", static_cast<long long>(actual.line));
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica a primeira consulta concorrente: várias threads, liberadas ao mesmo tempo, consultam as mesmas seções em ordens diferentes em um parser recém-criado.
+* @details : Todas as threads devem ver os valores do IniParser, e cada seção deve ser indexada uma única vez (parsedSectionCount conta a seção global e cada seção consultada).
+******************************************************************************.
+* @param: path - O caminho do arquivo de teste.
+* @param: instances - A quantidade de instâncias numeradas do arquivo.
+******************************************************************************
+*/
+static void testConcurrentFirstAccess(const std::string& path, int instances)
+{
+    constexpr int THREADS = 8; // Threads que consultam o parser ao mesmo tempo.
+    constexpr int ROUNDS = 40; // Parsers criados, um por rodada.
+    IniParser reference(path);
+    std::span<const std::string_view> names = reference.sectionNames();
+    std::atomic<int> mismatches{0}; // Consultas diferentes do IniParser, em todas as threads.
+
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        LazyIniParser lazy(path);
+        std::latch start(THREADS);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                start.arrive_and_wait(); // Libera todas as threads juntas, para que disputem a primeira consulta de cada seção.
+                for (std::size_t i = 0; i < names.size(); ++i)
+                {
+                    std::size_t position = (t % 2 == 0) ? i : names.size() - 1 - i; // Metade das threads percorre as seções na ordem inversa.
+                    if (!sameSection(reference, lazy, names[(position + static_cast<std::size_t>(t) * 3) % names.size()]))
+                    {
+                        mismatches.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        check(lazy.parsedSectionCount() == names.size(), "cada secao indexada uma unica vez", static_cast<long long>(lazy.parsedSectionCount()));
+    }
+    check(mismatches.load() == 0, "consultas concorrentes iguais as do IniParser", mismatches.load());
+    check(names.size() == static_cast<std::size_t>(2 * instances + 5), "quantidade de secoes do arquivo", static_cast<long long>(names.size()));
+}
+
+int main()
+{
+    constexpr int INSTANCES = 64; // Instâncias numeradas [TCPn] e [UARTn] do arquivo de teste.
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / ("lazy_ini_parser_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+    std::string path = (directory / "repetidas.ini").string();
+    {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output << fixtureText(INSTANCES);
+    }
+
+    testMatchesIniParser(path);
+    testConcurrentFirstAccess(path, INSTANCES);
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    std::printf("%d falhas\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,306 @@
+/*
+ * snapshot_stress_test.cpp
+ *
+ * Teste de estresse da recarga: várias threads leitoras consultam os getters do ConfigurationManager sem parar, enquanto uma thread escritora publica novas configurações com reload e, em seguida, substitui o arquivo observado por um ConfigWatcher. Cada geração do arquivo grava o mesmo número em todas as seções; um snapshot com seções de gerações diferentes (publicação parcial), uma configuração inválida ou uma geração que volta atrás fazem o teste falhar.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConfigWatcher.hpp"
+#include "ConfigurationManager.hpp"
+#include "ParserFactory.hpp"
+/*----------------------------------------------------------------------------*/
+
+static constexpr int READER_COUNT = 4; // Threads leitoras.
+static constexpr int RELOAD_GENERATIONS = 400; // Gerações publicadas diretamente com reload.
+static constexpr int WATCHED_GENERATIONS = 100; // Gerações publicadas pela substituição do arquivo observado.
+static constexpr int TCP_INSTANCES = 2; // Instâncias [TCP0], [TCP1], ... de cada geração.
+static constexpr int UART_INSTANCES = 4; // Instâncias [UART0], [UART1], ... de cada geração.
+static constexpr int PORT_BASE = 1000; // A porta de uma geração g é PORT_BASE + g.
+static constexpr int BAUDRATE_BASE = 100000; // A taxa de transmissão de uma geração g é BAUDRATE_BASE + g.
+
+static std::atomic<int> g_failures{0}; // Falhas encontradas por qualquer thread.
+
+/**
+******************************************************************************
+* @brief   : Registra uma falha do teste.
+******************************************************************************.
+* @param: message - A descrição da falha.
+* @param: value - Um valor que ajuda a diagnosticar a falha (geração, código de erro, ...).
+******************************************************************************
+*/
+static void fail(const char* message, long long value)
+{
+    if (g_failures.fetch_add(1) < 10) // Limita a saída quando muitas leituras falham pelo mesmo motivo.
+    {
+        std::fprintf(stderr, "FALHA: %s (%lld)\n", message, value);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Monta o conteúdo do arquivo de uma geração.
+* @details : Uma geração inválida tem a porta da instância [TCP1] fora do intervalo permitido; todas as outras seções são válidas, de modo que somente a validação completa do arquivo a rejeita.
+******************************************************************************.
+* @param: generation - O número da geração.
+* @param: valid - Se false, o arquivo é inválido.
+* @return: std::string - O conteúdo do arquivo INI.
+******************************************************************************
+*/
+static std::string configText(int generation, bool valid)
+{
+    std::string port = std::to_string(PORT_BASE + generation);
+    std::string baudrate = std::to_string(BAUDRATE_BASE + generation);
+    std::string text = "[TCP]\nip=10.0.0.1\nport=" + port + "\nprotocol=TCP\n\n[UART]\nbaudrate=" + baudrate + "\ndata_bits=8\nparity=none\nstop_bits=1\n";
+    for (int i = 0; i < TCP_INSTANCES; ++i)
+    {
+        bool broken = !valid && i == 1; // Instância que invalida o arquivo.
+        text += "\n[TCP" + std::to_string(i) + "]\nip=10.0.1." + std::to_string(i) + "\nport=" + (broken ? std::string("99999") : port) + "\nprotocol=UDP\n";
+    }
+    for (int i = 0; i < UART_INSTANCES; ++i)
+    {
+        text += "\n[UART" + std::to_string(i) + "]\nbaudrate=" + baudrate + "\ndata_bits=8\nparity=even\nstop_bits=1\n";
+    }
+    return text;
+}
+
+/**
+******************************************************************************
+* @brief   : Substitui o arquivo por completo, gravando um arquivo temporário e renomeando-o sobre o original (como um editor ou uma gravação atômica).
+******************************************************************************.
+* @param: path - O caminho do arquivo.
+* @param: text - O novo conteúdo.
+******************************************************************************
+*/
+static void replaceFile(const std::filesystem::path& path, const std::string& text)
+{
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+        output << text;
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+/**
+******************************************************************************
+* @brief   : Verifica se todas as seções de um snapshot são válidas e pertencem à mesma geração.
+******************************************************************************.
+* @param: snapshot - O snapshot a ser verificado.
+* @return: int - A geração do snapshot, ou -1 se ele for inválido ou misturar gerações.
+******************************************************************************
+*/
+static int snapshotGeneration(const ConfigSnapshot& snapshot)
+{
+    if (!snapshot.tcp || !snapshot.uart)
+    {
+        return -1;
+    }
+    int generation = snapshot.tcp->port - PORT_BASE;
+    if (snapshot.uart->baudrate != BAUDRATE_BASE + generation || snapshot.tcpInstances.size() != TCP_INSTANCES || snapshot.uartInstances.size() != UART_INSTANCES)
+    {
+        return -1;
+    }
+    for (const auto& instance : snapshot.tcpInstances)
+    {
+        if (!instance.config || instance.config->port != PORT_BASE + generation)
+        {
+            return -1;
+        }
+    }
+    for (const auto& instance : snapshot.uartInstances)
+    {
+        if (!instance.config || instance.config->baudrate != BAUDRATE_BASE + generation)
+        {
+            return -1;
+        }
+    }
+    return generation;
+}
+
+/**
+******************************************************************************
+* @brief   : Laço de uma thread leitora.
+* @details : Cada volta lê o snapshot completo e os getters individuais. Como as publicações são ordenadas, a geração observada por uma mesma thread nunca pode diminuir, nem entre getters diferentes.
+******************************************************************************.
+* @param: manager - O gerenciador consultado.
+* @param: handle - O identificador da chave [UART] baudrate, registrada com intern.
+* @param: stop - Sinal de parada.
+* @param: reads - Contador de leituras, somado ao final.
+******************************************************************************
+*/
+static void readerLoop(const ConfigurationManager& manager, KeyHandle<int> handle, const std::atomic<bool>& stop, std::atomic<std::uint64_t>& reads)
+{
+    int seen = 0; // Maior geração observada por esta thread.
+    std::uint64_t count = 0;
+    auto observe = [&seen](int generation, const char* source)
+    {
+        if (generation < seen)
+        {
+            fail(source, generation);
+        }
+        seen = generation;
+    };
+
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        std::shared_ptr<const ConfigSnapshot> snapshot = manager.get_snapshot();
+        int generation = snapshotGeneration(*snapshot);
+        if (generation < 0)
+        {
+            fail("snapshot parcial ou invalido", snapshot->tcp ? snapshot->tcp->port : -1);
+            continue;
+        }
+        observe(generation, "snapshot voltou a uma geracao anterior");
+
+        std::expected<TcpConfig, ErrorCode> tcp = manager.get_tcp_config();
+        if (!tcp)
+        {
+            fail("get_tcp_config falhou", static_cast<long long>(tcp.error()));
+            continue;
+        }
+        observe(tcp->port - PORT_BASE, "get_tcp_config voltou a uma geracao anterior");
+
+        std::expected<int, ErrorCode> baudrate = manager.get(handle);
+        if (!baudrate)
+        {
+            fail("get(handle) falhou", static_cast<long long>(baudrate.error()));
+            continue;
+        }
+        observe(*baudrate - BAUDRATE_BASE, "get(handle) voltou a uma geracao anterior");
+
+        auto uartInstances = manager.get_all_uart_configs();
+        if (uartInstances->size() != UART_INSTANCES || !uartInstances->back().config)
+        {
+            fail("get_all_uart_configs invalido", static_cast<long long>(uartInstances->size()));
+            continue;
+        }
+        observe(uartInstances->back().config->baudrate - BAUDRATE_BASE, "get_all_uart_configs voltou a uma geracao anterior");
+        ++count;
+    }
+    reads.fetch_add(count);
+}
+
+/**
+******************************************************************************
+* @brief   : Publica gerações diretamente com reload, intercalando arquivos inválidos, que devem ser rejeitados.
+******************************************************************************.
+* @param: manager - O gerenciador.
+* @param: path - O arquivo reescrito a cada geração.
+******************************************************************************
+*/
+static void reloadPhase(ConfigurationManager& manager, const std::filesystem::path& path)
+{
+    for (int generation = 1; generation <= RELOAD_GENERATIONS; ++generation)
+    {
+        bool valid = generation % 5 != 0; // Uma a cada cinco gerações é inválida.
+        replaceFile(path, configText(generation, valid));
+        auto parser = createParser(path.string());
+        if (!parser)
+        {
+            fail("createParser falhou", generation);
+            continue;
+        }
+        std::expected<void, ErrorCode> reloaded = manager.reload(std::move(*parser));
+        if (reloaded.has_value() != valid)
+        {
+            fail(valid ? "reload rejeitou um arquivo valido" : "reload aceitou um arquivo invalido", generation);
+        }
+        int published = snapshotGeneration(*manager.get_snapshot()); // Geração em vigor: a atual, ou a anterior se esta foi rejeitada.
+        if (published != (valid ? generation : generation - 1))
+        {
+            fail("geracao publicada incorreta", published);
+        }
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Publica gerações substituindo o arquivo observado por um ConfigWatcher e espera a publicação da última.
+******************************************************************************.
+* @param: manager - O gerenciador.
+* @param: path - O arquivo observado.
+******************************************************************************
+*/
+static void watcherPhase(ConfigurationManager& manager, const std::filesystem::path& path)
+{
+    auto watcher = ConfigWatcher::start(manager, path.string(), [](const std::string& file) { return createParser(file); });
+    if (!watcher)
+    {
+        fail("ConfigWatcher::start falhou", static_cast<long long>(watcher.error()));
+        return;
+    }
+
+    int last = RELOAD_GENERATIONS + WATCHED_GENERATIONS; // Última geração, sempre válida.
+    for (int generation = RELOAD_GENERATIONS + 1; generation <= last; ++generation)
+    {
+        replaceFile(path, configText(generation, generation == last || generation % 5 != 0));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10); // A última substituição deve ser publicada logo depois.
+    while (snapshotGeneration(*manager.get_snapshot()) != last && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (snapshotGeneration(*manager.get_snapshot()) != last)
+    {
+        fail("o ConfigWatcher nao publicou a ultima geracao", snapshotGeneration(*manager.get_snapshot()));
+    }
+    if ((*watcher)->reloadCount() == 0)
+    {
+        fail("o ConfigWatcher nao aceitou nenhuma recarga", 0);
+    }
+    std::printf("watcher: %llu recargas aceitas, %llu rejeitadas\n", static_cast<unsigned long long>((*watcher)->reloadCount()), static_cast<unsigned long long>((*watcher)->rejectedCount()));
+}
+
+int main()
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / ("snapshot_stress_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+    std::filesystem::path path = directory / "config.ini"; // Arquivo próprio, em um diretório próprio, para que o ConfigWatcher só veja os eventos do teste.
+    replaceFile(path, configText(0, true));
+
+    auto parser = createParser(path.string());
+    if (!parser)
+    {
+        std::fprintf(stderr, "FALHA: createParser (%d)\n", static_cast<int>(parser.error()));
+        return 1;
+    }
+    ConfigurationManager manager(std::move(*parser), 2);
+    std::expected<KeyHandle<int>, ErrorCode> handle = manager.intern<int>("UART", "baudrate");
+    if (!handle || snapshotGeneration(*manager.get_snapshot()) != 0)
+    {
+        std::fprintf(stderr, "FALHA: carga inicial\n");
+        return 1;
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> reads{0};
+    std::vector<std::jthread> readers;
+    for (int i = 0; i < READER_COUNT; ++i)
+    {
+        readers.emplace_back([&] { readerLoop(manager, *handle, stop, reads); });
+    }
+
+    reloadPhase(manager, path);
+    watcherPhase(manager, path);
+
+    stop.store(true);
+    readers.clear(); // Espera as threads leitoras.
+    std::filesystem::remove_all(directory);
+
+    std::printf("%d leitoras, %llu leituras, %d falhas\n", READER_COUNT, static_cast<unsigned long long>(reads.load()), g_failures.load());
+    return g_failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+/*
+ * streaming_parser_test.cpp
+ *
+ * Teste de equivalência do StreamingIniParser com o IniParser: cada arquivo de teste é entregue ao StreamingIniParser em blocos de 1, 3, 7 e 64 bytes, inteiro e dividido em dois blocos em cada posição (de modo que cabeçalhos de seção e linhas chave=valor são cortados em todos os pontos), e as configurações TCP e UART (valores ou códigos de erro) e os valores das chaves dos esquemas devem ser iguais aos do IniParser sobre o mesmo arquivo.
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+ /* Includes ------------------------------------------------------------------*/
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "IniParser.hpp"
+#include "StreamingIniParser.hpp"
+/*----------------------------------------------------------------------------*/
+
+static int g_failures = 0; // Falhas encontradas.
+
+// Arquivo de teste, com um nome para as mensagens de falha.
+struct Fixture
+{
+    const char* name; // Nome do arquivo de teste.
+    std::string_view text; // Conteúdo.
+};
+
+// Arquivos de teste. Cobrem comentários, espaços, CRLF, chaves na seção global, seções repetidas, seções de outros tipos, valores inválidos e a falta do '\n' final.
+static constexpr Fixture FIXTURES[] = {
+    {"valido", "[TCP]\nip=192.168.0.10\nport=502\nprotocol=TCP\n\n[UART]\nbaudrate=9600\ndata_bits=8\nparity=none\nstop_bits=1\n"},
+    {"sem quebra de linha final", "[UART]\nbaudrate=115200\ndata_bits=7\nparity=even\nstop_bits=2\n[TCP]\nip=10.0.0.1\nprotocol=UDP\nport=8080"},
+    {"crlf, comentarios e espacos", "; comentario\r\n# outro comentario\r\n[TCP]\r\n  ip = 10.1.1.1  \r\nport=  1234\r\nprotocol =TCP\r\n\r\n[UART]\r\nbaudrate=19200\r\ndata_bits=8\r\nparity=odd\r\nstop_bits=1"},
+    {"secao global como alternativa", "port=700\nbaudrate=4800\n[TCP]\nip=1.2.3.4\nprotocol=TCP\n[UART]\ndata_bits=8\nparity=none\nstop_bits=1\n"},
+    {"secoes repetidas e outras secoes", "[TCP]\nip=1.1.1.1\nport=1\n[APP]\nport=9\nname=x\n[TCP0]\nport=5\n[TCP]\nport=2\nprotocol=UDP\n[UART]\nbaudrate=300\n[UART]\ndata_bits=8\nparity=none\nstop_bits=1\n"},
+    {"valores invalidos", "[TCP]\nip=999.1.1.1\nport=70000\nprotocol=SCTP\n[UART]\nbaudrate=abc\ndata_bits=8\nparity=none\nstop_bits=1\n"},
+    {"secao faltando", "[TCP]\nip=1.1.1.1\nport=22\nprotocol=TCP\n"},
+    {"linhas malformadas", "[TCP\nip=1.1.1.1\n[TCP]\n=sem chave\nsem igual\nip=2.2.2.2\nport=23\nprotocol=TCP\n[UART]\nbaudrate=1200\ndata_bits=8\nparity=none\nstop_bits=1\n"},
+};
+
+/**
+******************************************************************************
+* @brief   : Registra uma falha do teste.
+******************************************************************************.
+* @param: fixture - O arquivo de teste.
+* @param: split - A descrição da divisão em blocos.
+* @param: message - A descrição da diferença.
+******************************************************************************
+*/
+static void fail(const Fixture& fixture, const std::string& split, const char* message)
+{
+    if (++g_failures <= 20) // Limita a saída quando muitas divisões falham pelo mesmo motivo.
+    {
+        std::fprintf(stderr, "FALHA: %s, %s: %s\n", fixture.name, split.c_str(), message);
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Compara duas configurações TCP campo a campo.
+******************************************************************************.
+* @param: a - A primeira configuração.
+* @param: b - A segunda configuração.
+* @return: bool - Retorna true se todos os campos forem iguais.
+******************************************************************************
+*/
+static bool sameConfig(const TcpConfig& a, const TcpConfig& b)
+{
+    return a.ip == b.ip && a.port == b.port && a.protocol == b.protocol;
+}
+
+/**
+******************************************************************************
+* @brief   : Compara duas configurações UART campo a campo.
+******************************************************************************.
+* @param: a - A primeira configuração.
+* @param: b - A segunda configuração.
+* @return: bool - Retorna true se todos os campos forem iguais.
+******************************************************************************
+*/
+static bool sameConfig(const UartConfig& a, const UartConfig& b)
+{
+    return a.baudrate == b.baudrate && a.data_bits == b.data_bits && a.parity == b.parity && a.stop_bits == b.stop_bits;
+}
+
+/**
+******************************************************************************
+* @brief   : Compara dois resultados de configuração: o mesmo erro ou a mesma configuração.
+******************************************************************************.
+* @param: expected - O resultado do IniParser.
+* @param: actual - O resultado do StreamingIniParser.
+* @return: bool - Retorna true se os resultados forem iguais.
+******************************************************************************
+*/
+template <typename T>
+static bool sameResult(const std::expected<T, ErrorCode>& expected, const std::expected<T, ErrorCode>& actual)
+{
+    if (expected.has_value() != actual.has_value())
+    {
+        return false;
+    }
+    return expected ? sameConfig(*expected, *actual) : expected.error() == actual.error();
+}
+
+/**
+******************************************************************************
+* @brief   : Compara o StreamingIniParser, já alimentado, com o IniParser.
+******************************************************************************.
+* @param: fixture - O arquivo de teste.
+* @param: split - A descrição da divisão em blocos.
+* @param: reference - O IniParser sobre o mesmo arquivo.
+* @param: streaming - O StreamingIniParser.
+******************************************************************************
+*/
+static void compare(const Fixture& fixture, const std::string& split, IniParser& reference, StreamingIniParser& streaming)
+{
+    if (!sameResult(reference.parseTcp(), streaming.parseTcp()))
+    {
+        fail(fixture, split, "parseTcp diferente do IniParser");
+    }
+    if (!sameResult(reference.parseUart(), streaming.parseUart()))
+    {
+        fail(fixture, split, "parseUart diferente do IniParser");
+    }
+    for (std::string_view section : {std::string_view("TCP"), std::string_view("UART")})
+    {
+        for (std::string_view key : {"ip", "port", "protocol", "baudrate", "data_bits", "parity", "stop_bits"})
+        {
+            std::optional<std::string_view> expected = reference.findValue(section, key);
+            std::optional<std::string_view> actual = streaming.findValue(section, key);
+            bool schemaKey = (section == "TCP") == (key == "ip" || key == "port" || key == "protocol"); // O StreamingIniParser só guarda as chaves do esquema da seção.
+            if (schemaKey && expected != actual)
+            {
+                fail(fixture, split, "findValue diferente do IniParser");
+            }
+        }
+    }
+}
+
+/**
+******************************************************************************
+* @brief   : Alimenta um StreamingIniParser com os blocos indicados e o compara com o IniParser.
+******************************************************************************.
+* @param: fixture - O arquivo de teste.
+* @param: split - A descrição da divisão em blocos.
+* @param: reference - O IniParser sobre o mesmo arquivo.
+* @param: boundaries - As posições onde cada bloco termina, em ordem; o último bloco termina no final do arquivo.
+******************************************************************************
+*/
+static void feedAndCompare(const Fixture& fixture, const std::string& split, IniParser& reference, std::span<const std::size_t> boundaries)
+{
+    StreamingIniParser streaming;
+    std::span<const std::byte> bytes = std::as_bytes(std::span<const char>(fixture.text.data(), fixture.text.size()));
+    std::size_t begin = 0;
+    for (std::size_t end : boundaries)
+    {
+        if (!streaming.feed(bytes.subspan(begin, end - begin)))
+        {
+            fail(fixture, split, "feed recusou um bloco");
+            return;
+        }
+        begin = end;
+    }
+    if (!streaming.feed(bytes.subspan(begin)) || !streaming.finish())
+    {
+        fail(fixture, split, "feed ou finish recusou o final");
+        return;
+    }
+    compare(fixture, split, reference, streaming);
+}
+
+int main()
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / ("streaming_parser_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+
+    for (const Fixture& fixture : FIXTURES)
+    {
+        std::filesystem::path path = directory / "fixture.ini";
+        {
+            std::ofstream output(path, std::ios::binary | std::ios::trunc);
+            output << fixture.text;
+        }
+        IniParser reference(path.string());
+
+        feedAndCompare(fixture, "inteiro", reference, {});
+        for (std::size_t chunk : {1, 3, 7, 64}) // Blocos de tamanho fixo.
+        {
+            std::vector<std::size_t> boundaries;
+            for (std::size_t end = chunk; end < fixture.text.size(); end += chunk)
+            {
+                boundaries.push_back(end);
+            }
+            feedAndCompare(fixture, "blocos de " + std::to_string(chunk), reference, boundaries);
+        }
+        for (std::size_t cut = 1; cut < fixture.text.size(); ++cut) // Dois blocos, divididos em cada posição.
+        {
+            std::size_t boundary[] = {cut};
+            feedAndCompare(fixture, "divisao em " + std::to_string(cut), reference, boundary);
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    std::printf("%d falhas\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
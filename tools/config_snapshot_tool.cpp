@@ -0,0 +1,39 @@
+/*
+ * config_snapshot_tool.cpp
+ *
+ * Ferramenta de linha de comando que gera o snapshot binário de um arquivo de configuração INI. O snapshot é gravado ao lado do arquivo (por exemplo, "config.ini.snap") e é usado automaticamente pela função createParser enquanto corresponder ao INI de origem.
+ *
+ * Uso: config_snapshot_tool <arquivo.ini> [arquivo.snap]
+ *
+ * Autor: José Pedro Rodrigues de Freitas
+ * Data: 16-10-2026
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <iostream>
+#include <string>
+#include "BinarySnapshot.hpp"
+#include "ParserFactory.hpp"
+/*----------------------------------------------------------------------------*/
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3) // Exige o arquivo de origem e, opcionalmente, o caminho do snapshot.
+    {
+        std::cerr << "Uso: " << argv[0] << " <arquivo.ini> [arquivo.snap]" << std::endl;
+        return 2;
+    }
+
+    std::string sourcePath = argv[1]; // Arquivo INI de origem.
+    std::string snapshotPath = argc == 3 ? argv[2] : snapshotPathFor(sourcePath); // Por padrão, o snapshot é gravado ao lado da origem.
+
+    auto result = writeBinarySnapshot(sourcePath, snapshotPath); // Interpreta, valida e grava o snapshot.
+    if (!result) // Informa o código de erro em caso de falha.
+    {
+        std::cerr << "Erro ao gerar o snapshot: " << errorCodeToString(result.error()) << std::endl;
+        return 1;
+    }
+
+    std::cout << "Snapshot gravado em " << snapshotPath << std::endl; // Informa o caminho do snapshot gerado.
+    return 0;
+}